@@ -0,0 +1,165 @@
+/*
+*	File:			LogDecoder.cpp
+*	Purpose:		Turns binary log files (.blog) back into the text layout of class Logger
+*
+*	Usage:			LogDecoder <file.blog> [output.log]
+*
+*/
+#include "../VulkanTUT/BinaryLog.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+*	Function:		bool decode(std::istream &in, std::ostream &out)
+*	Purpose:		Decodes every session of a .blog file, returns false on a corrupt file
+*
+*/
+bool decode(std::istream &in, std::ostream &out) {
+
+	BinaryLogFileHeader session;
+	bool hasSession = false;
+	std::vector< std::string > formats;
+	std::vector< uint8_t > payload;
+
+	for (;;) {
+
+		int next = in.peek();
+		if (next == EOF) {
+
+			return true;
+
+		}
+
+		// Appended sessions start with a new file header
+		if (static_cast< uint8_t >(next) == (BLOG_MAGIC & 0xFF)) {
+
+			if (!in.read(reinterpret_cast< char* >(&session), sizeof(session)) || session.magic != BLOG_MAGIC) {
+
+				std::cerr << "Invalid session header" << std::endl;
+				return false;
+
+			}
+			if (session.version != BLOG_VERSION) {
+
+				std::cerr << "Unsupported version " << session.version << std::endl;
+				return false;
+
+			}
+			hasSession = true;
+			formats.clear();
+			continue;
+
+		}
+
+		BinaryLogRecordHeader header;
+		if (!hasSession || !in.read(reinterpret_cast< char* >(&header), sizeof(header))) {
+
+			std::cerr << "Truncated or missing session header" << std::endl;
+			return false;
+
+		}
+
+		payload.resize(header.payloadSize);
+		if (header.payloadSize > 0 && !in.read(reinterpret_cast< char* >(payload.data()), header.payloadSize)) {
+
+			std::cerr << "Truncated record" << std::endl;
+			return false;
+
+		}
+
+		if (header.kind == BLOG_RECORD_FORMAT) {
+
+			if (header.formatId >= BLOG_MAX_FORMATS) {
+
+				std::cerr << "Format id " << header.formatId << " out of range" << std::endl;
+				return false;
+
+			}
+			if (header.formatId >= formats.size()) {
+
+				formats.resize(header.formatId + 1);
+
+			}
+			formats[header.formatId].assign(payload.begin(), payload.end());
+			continue;
+
+		}
+
+		if (header.kind != BLOG_RECORD_ENTRY) {
+
+			std::cerr << "Unknown record kind " << static_cast< int >(header.kind) << std::endl;
+			return false;
+
+		}
+
+		const char* format = header.formatId < formats.size() ? formats[header.formatId].c_str() : "{}";
+
+		// Monotonic timestamps are relative to the session start
+		int64_t elapsed = static_cast< int64_t >(header.timestamp - session.monotonicBase) / 1000000000LL;
+		time_t wallClock = static_cast< time_t >(session.wallClockSeconds + elapsed);
+
+		char prefix[64];
+		uint32_t prefixLength = binlog::formatPrefix(prefix, sizeof(prefix), wallClock);
+
+		std::vector< char > text(header.payloadSize * 4 + strlen(format) + 64);
+		uint32_t textLength = binlog::expand(
+
+			text.data(),
+			static_cast< uint32_t >(text.size()),
+			format,
+			payload.data(),
+			header.payloadSize,
+			header.argCount
+
+		);
+
+		out.write(prefix, prefixLength);
+		out.write(text.data(), textLength);
+		out << '\n';
+
+	}
+
+}
+
+/*
+*	Function:		int main(int argc, char** argv)
+*	Purpose:		Entry point for the decoder
+*
+*/
+int main(int argc, char** argv) {
+
+	if (argc < 2) {
+
+		std::cerr << "Usage: LogDecoder <file.blog> [output.log]" << std::endl;
+		return 1;
+
+	}
+
+	std::ifstream in(argv[1], std::ios::binary);
+	if (!in) {
+
+		std::cerr << "Failed to open " << argv[1] << std::endl;
+		return 1;
+
+	}
+
+	if (argc < 3) {
+
+		return decode(in, std::cout) ? 0 : 1;
+
+	}
+
+	std::ofstream out(argv[2], std::ios::trunc);
+	if (!out) {
+
+		std::cerr << "Failed to open " << argv[2] << std::endl;
+		return 1;
+
+	}
+
+	return decode(in, out) ? 0 : 1;
+
+}
@@ -0,0 +1,230 @@
+/*
+*	File:			BinaryLog.cpp
+*	Purpose:		Contains the shared formatting functions of binary log files
+*
+*/
+#include "BinaryLog.hpp"
+#include <chrono>
+#include <cstdio>
+
+namespace binlog {
+
+	/*
+	*	Function:		uint32_t binlog::formatPrefix(char* out, uint32_t capacity, time_t time)
+	*	Purpose:		Writes the "D:M:Y   H:M:S		===		" prefix of a log line
+	*
+	*/
+	uint32_t formatPrefix(char* out, uint32_t capacity, time_t time) {
+
+		struct tm local_time;
+#ifdef _WIN32
+		localtime_s(&local_time, &time);
+#else
+		localtime_r(&time, &local_time);
+#endif
+
+		int written = snprintf(
+
+			out,
+			capacity,
+			"%d:%d:%d   %d:%d:%d\t\t===\t\t",
+			local_time.tm_mday,
+			local_time.tm_mon + 1,
+			local_time.tm_year + 1900,
+			local_time.tm_hour,
+			local_time.tm_min,
+			local_time.tm_sec
+
+		);
+
+		if (written < 0) {
+
+			return 0;
+
+		}
+
+		return static_cast< uint32_t >(written) < capacity ? static_cast< uint32_t >(written) : capacity - 1;
+
+	}
+
+	/*
+	*	Function:		uint32_t binlog::expand(char* out, uint32_t capacity, const char* format, ...)
+	*	Purpose:		Replaces every "{}" in format with the next encoded argument,
+	*					returns the length written to out without terminator
+	*
+	*/
+	uint32_t expand(char* out, uint32_t capacity, const char* format, const uint8_t* payload, uint32_t payloadSize, uint8_t argCount) {
+
+		uint32_t used		= 0;
+		uint32_t offset		= 0;
+		uint8_t consumed	= 0;
+
+		auto append = [&](const char* text, size_t length) {
+
+			if (length > capacity - 1 - used) {
+
+				length = capacity - 1 - used;
+
+			}
+			memcpy(out + used, text, length);
+			used += static_cast< uint32_t >(length);
+
+		};
+
+		for (const char* c = format; *c != '\0'; c++) {
+
+			if (c[0] != '{' || c[1] != '}') {
+
+				append(c, 1);
+				continue;
+
+			}
+			c++;
+
+			if (consumed == argCount || offset >= payloadSize) {
+
+				append("{}", 2);
+				continue;
+
+			}
+
+			char number[32];
+			uint8_t tag = payload[offset++];
+
+			// A value cut off by the end of the payload ends the expansion, a corrupt record must not read past it
+			auto fits = [&](size_t size) {
+
+				if (size <= payloadSize - offset) {
+
+					return true;
+
+				}
+				offset = payloadSize;
+				append("{?}", 3);
+				return false;
+
+			};
+
+			switch (tag) {
+			case BLOG_ARG_INT: {
+
+				int64_t value;
+				if (!fits(sizeof(value))) {
+
+					break;
+
+				}
+				memcpy(&value, payload + offset, sizeof(value));
+				offset += sizeof(value);
+				append(number, snprintf(number, sizeof(number), "%lld", static_cast< long long >(value)));
+				break;
+
+			}
+			case BLOG_ARG_INT32: {
+
+				int32_t value;
+				if (!fits(sizeof(value))) {
+
+					break;
+
+				}
+				memcpy(&value, payload + offset, sizeof(value));
+				offset += sizeof(value);
+				append(number, snprintf(number, sizeof(number), "%d", value));
+				break;
+
+			}
+			case BLOG_ARG_UINT32: {
+
+				uint32_t value;
+				if (!fits(sizeof(value))) {
+
+					break;
+
+				}
+				memcpy(&value, payload + offset, sizeof(value));
+				offset += sizeof(value);
+				append(number, snprintf(number, sizeof(number), "%u", value));
+				break;
+
+			}
+			case BLOG_ARG_UINT: {
+
+				uint64_t value;
+				if (!fits(sizeof(value))) {
+
+					break;
+
+				}
+				memcpy(&value, payload + offset, sizeof(value));
+				offset += sizeof(value);
+				append(number, snprintf(number, sizeof(number), "%llu", static_cast< unsigned long long >(value)));
+				break;
+
+			}
+			case BLOG_ARG_DOUBLE: {
+
+				double value;
+				if (!fits(sizeof(value))) {
+
+					break;
+
+				}
+				memcpy(&value, payload + offset, sizeof(value));
+				offset += sizeof(value);
+				append(number, snprintf(number, sizeof(number), "%g", value));
+				break;
+
+			}
+			case BLOG_ARG_STRING: {
+
+				uint16_t length;
+				if (!fits(sizeof(length))) {
+
+					break;
+
+				}
+				memcpy(&length, payload + offset, sizeof(length));
+				offset += sizeof(length);
+				if (!fits(length)) {
+
+					break;
+
+				}
+				append(reinterpret_cast< const char* >(payload + offset), length);
+				offset += length;
+				break;
+
+			}
+			default:
+				// Unknown tag, the rest of the payload cannot be interpreted
+				offset = payloadSize;
+				append("{?}", 3);
+				break;
+
+			}
+			consumed++;
+
+		}
+
+		out[used] = '\0';
+		return used;
+
+	}
+
+	/*
+	*	Function:		uint64_t binlog::monotonicNanoseconds()
+	*	Purpose:		Timestamp source of binary log records
+	*
+	*/
+	uint64_t monotonicNanoseconds() {
+
+		return static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+
+			std::chrono::steady_clock::now().time_since_epoch()
+
+		).count());
+
+	}
+
+}
@@ -0,0 +1,198 @@
+/*
+*	File:			BinaryLog.hpp
+*	Purpose:		Contains the record layout of binary log files (.blog),
+*					shared by class Logger and the LogDecoder tool
+*
+*/
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <time.h>
+#include <type_traits>
+
+#define BLOG_MAGIC					0x474F4C42		// "BLOG" in little endian
+#define BLOG_VERSION				1
+#define BLOG_MAX_FORMATS			4096			// Format ids are below this, readers reject larger ones as corrupt
+
+#define BLOG_RECORD_FORMAT			1				// Defines the format string belonging to a format id
+#define BLOG_RECORD_ENTRY			2				// One log line, references a format id
+
+#define BLOG_ARG_INT				1				// Followed by int64_t
+#define BLOG_ARG_UINT				2				// Followed by uint64_t
+#define BLOG_ARG_DOUBLE				3				// Followed by double
+#define BLOG_ARG_STRING				4				// Followed by uint16_t length and the characters
+#define BLOG_ARG_INT32				5				// Followed by int32_t
+#define BLOG_ARG_UINT32				6				// Followed by uint32_t
+
+#pragma pack(push, 1)
+
+/*
+*	Struct:			BinaryLogFileHeader
+*	Purpose:		Starts every logging session in a .blog file, maps monotonic timestamps to wall-clock time
+*
+*/
+struct BinaryLogFileHeader {
+
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	reserved;
+	int64_t		wallClockSeconds;		// time() when the session started
+	uint64_t	monotonicBase;			// Monotonic nanoseconds when the session started
+
+};
+
+/*
+*	Struct:			BinaryLogRecordHeader
+*	Purpose:		Precedes every format definition and every log line
+*
+*/
+struct BinaryLogRecordHeader {
+
+	uint8_t		kind;
+	uint8_t		argCount;
+	uint16_t	formatId;
+	uint16_t	payloadSize;
+	uint64_t	timestamp;				// Monotonic nanoseconds
+
+};
+
+#pragma pack(pop)
+
+/*
+*	Namespace:		binlog
+*	Purpose:		Encoding of log arguments and expansion of "{}" format strings
+*
+*/
+namespace binlog {
+
+	/*
+	*	Struct:			binlog::Writer
+	*	Purpose:		Appends tagged raw arguments to a fixed buffer, drops arguments that do not fit
+	*
+	*/
+	struct Writer {
+
+		uint8_t*	out;
+		uint32_t	capacity;
+		uint32_t	used;
+		uint8_t		count;
+
+		Writer(uint8_t* out_, uint32_t capacity_) : out(out_), capacity(capacity_), used(0), count(0) {}
+
+		void put(uint8_t tag, const void* data, uint32_t size) {
+
+			if (used + 1 + size > capacity || count == UINT8_MAX) {
+
+				return;
+
+			}
+			out[used] = tag;
+			memcpy(out + used + 1, data, size);
+			used += 1 + size;
+			count++;
+
+		}
+
+	};
+
+	inline void encode(Writer &writer, const char* value) {
+
+		size_t length = strlen(value);
+		uint32_t room = writer.capacity - writer.used;
+		if (room < 1 + sizeof(uint16_t)) {
+
+			return;
+
+		}
+		if (length > room - 1 - sizeof(uint16_t)) {
+
+			length = room - 1 - sizeof(uint16_t);
+
+		}
+		if (length > UINT16_MAX) {
+
+			length = UINT16_MAX;
+
+		}
+
+		uint8_t* out = writer.out + writer.used;
+		uint16_t stored = static_cast< uint16_t >(length);
+		out[0] = BLOG_ARG_STRING;
+		memcpy(out + 1, &stored, sizeof(stored));
+		memcpy(out + 1 + sizeof(stored), value, length);
+		writer.used += static_cast< uint32_t >(1 + sizeof(stored) + stored);
+		writer.count++;
+
+	}
+
+	inline void encode(Writer &writer, const std::string &value) {
+
+		encode(writer, value.c_str());
+
+	}
+
+	template< typename T >
+	typename std::enable_if< std::is_integral< T >::value && std::is_signed< T >::value >::type encode(Writer &writer, T value) {
+
+		if (sizeof(T) <= sizeof(int32_t)) {
+
+			int32_t stored = static_cast< int32_t >(value);
+			writer.put(BLOG_ARG_INT32, &stored, sizeof(stored));
+			return;
+
+		}
+
+		int64_t stored = value;
+		writer.put(BLOG_ARG_INT, &stored, sizeof(stored));
+
+	}
+
+	template< typename T >
+	typename std::enable_if< std::is_integral< T >::value && !std::is_signed< T >::value >::type encode(Writer &writer, T value) {
+
+		if (sizeof(T) <= sizeof(uint32_t)) {
+
+			uint32_t stored = static_cast< uint32_t >(value);
+			writer.put(BLOG_ARG_UINT32, &stored, sizeof(stored));
+			return;
+
+		}
+
+		uint64_t stored = value;
+		writer.put(BLOG_ARG_UINT, &stored, sizeof(stored));
+
+	}
+
+	template< typename T >
+	typename std::enable_if< std::is_enum< T >::value >::type encode(Writer &writer, T value) {
+
+		int32_t stored = static_cast< int32_t >(value);
+		writer.put(BLOG_ARG_INT32, &stored, sizeof(stored));
+
+	}
+
+	template< typename T >
+	typename std::enable_if< std::is_floating_point< T >::value >::type encode(Writer &writer, T value) {
+
+		double stored = value;
+		writer.put(BLOG_ARG_DOUBLE, &stored, sizeof(stored));
+
+	}
+
+	inline void encodeAll(Writer &) {}
+
+	template< typename T, typename... Rest >
+	void encodeAll(Writer &writer, const T &value, const Rest&... rest) {
+
+		encode(writer, value);
+		encodeAll(writer, rest...);
+
+	}
+
+	uint32_t formatPrefix(char* out, uint32_t capacity, time_t time);
+	uint32_t expand(char* out, uint32_t capacity, const char* format, const uint8_t* payload, uint32_t payloadSize, uint8_t argCount);
+	uint64_t monotonicNanoseconds(void);
+
+}
+
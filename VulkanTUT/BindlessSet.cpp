@@ -0,0 +1,302 @@
+/*
+*	File:			BindlessSet.cpp
+*	Purpose:		Contains functions for class BindlessSet
+*
+*/
+#include "BindlessSet.hpp"
+
+/*
+*	Default constructor
+*
+*
+*/
+BindlessSet::BindlessSet() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	descriptorSetLayout(VK_NULL_HANDLE),
+	descriptorPool(VK_NULL_HANDLE),
+	descriptorSet(VK_NULL_HANDLE),
+	buffers({ 0, 0, {} }),
+	images({ 0, 0, {} }) {
+
+
+
+}
+
+/*
+*	Function:		VkResult BindlessSet::create(VkDevice device, DescriptorLayoutCache &layoutCache, uint32_t maxBuffers, uint32_t maxImages, VkShaderStageFlags stages, const VkAllocationCallbacks* allocator)
+*	Purpose:		Creates the set with room for maxBuffers storage buffers and maxImages combined image samplers,
+*					both have to stay within the maxDescriptorSetUpdateAfterBind limits of the device
+*					Every element starts unwritten, partially bound arrays allow that as long as shaders skip them
+*
+*/
+VkResult BindlessSet::create(VkDevice device_, DescriptorLayoutCache &layoutCache, uint32_t maxBuffers, uint32_t maxImages, VkShaderStageFlags stages, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	buffers				= { maxBuffers, 0, {} };
+	images				= { maxImages, 0, {} };
+
+	std::vector< VkDescriptorSetLayoutBinding > bindings(2);
+	bindings[0].binding					= BINDLESS_BUFFER_BINDING;
+	bindings[0].descriptorType			= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[0].descriptorCount			= maxBuffers;
+	bindings[0].stageFlags				= stages;
+	bindings[0].pImmutableSamplers		= nullptr;
+	bindings[1].binding					= BINDLESS_IMAGE_BINDING;
+	bindings[1].descriptorType			= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[1].descriptorCount			= maxImages;
+	bindings[1].stageFlags				= stages;
+	bindings[1].pImmutableSamplers		= nullptr;
+
+	// Elements are written while frames that do not read them are in flight
+	const VkDescriptorBindingFlagsEXT bindingFlags =
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+		VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+		VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+	VkResult result = layoutCache.get(
+
+		bindings,
+		descriptorSetLayout,
+		VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+		{ bindingFlags, bindingFlags }
+
+	);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	std::vector< VkDescriptorPoolSize > poolSizes;
+	for (const VkDescriptorSetLayoutBinding &binding : bindings) {
+
+		if (binding.descriptorCount > 0) {
+
+			VkDescriptorPoolSize poolSize;
+			poolSize.type				= binding.descriptorType;
+			poolSize.descriptorCount	= binding.descriptorCount;
+			poolSizes.push_back(poolSize);
+
+		}
+
+	}
+
+	// Sets of update after bind layouts need a pool of their own
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo;
+	descriptorPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.pNext				= nullptr;
+	descriptorPoolCreateInfo.flags				= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+	descriptorPoolCreateInfo.maxSets			= 1;
+	descriptorPoolCreateInfo.poolSizeCount		= static_cast< uint32_t >(poolSizes.size());
+	descriptorPoolCreateInfo.pPoolSizes			= poolSizes.data();
+
+	result = vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, allocationCallbacks, &descriptorPool);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.pNext					= nullptr;
+	descriptorSetAllocateInfo.descriptorPool		= descriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount	= 1;
+	descriptorSetAllocateInfo.pSetLayouts			= &descriptorSetLayout;
+
+	return vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &descriptorSet);
+
+}
+
+/*
+*	Function:		uint32_t BindlessSet::addBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+*	Purpose:		Writes a storage buffer range to a free element and returns its index, BINDLESS_INVALID if full
+*
+*/
+uint32_t BindlessSet::addBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+
+	uint32_t index;
+	{
+
+		std::lock_guard< std::mutex > lock(mutex);
+		index = buffers.take();
+
+	}
+	if (index != BINDLESS_INVALID) {
+
+		updateBuffer(index, buffer, offset, range);
+
+	}
+
+	return index;
+
+}
+
+/*
+*	Function:		void BindlessSet::updateBuffer(uint32_t index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+*	Purpose:		Points an element at another range, no frame in flight may read the element
+*
+*/
+void BindlessSet::updateBuffer(uint32_t index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+
+	VkDescriptorBufferInfo bufferInfo;
+	bufferInfo.buffer	= buffer;
+	bufferInfo.offset	= offset;
+	bufferInfo.range	= range;
+
+	VkWriteDescriptorSet write;
+	write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.pNext					= nullptr;
+	write.dstSet				= descriptorSet;
+	write.dstBinding			= BINDLESS_BUFFER_BINDING;
+	write.dstArrayElement		= index;
+	write.descriptorCount		= 1;
+	write.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	write.pImageInfo			= nullptr;
+	write.pBufferInfo			= &bufferInfo;
+	write.pTexelBufferView		= nullptr;
+
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+}
+
+/*
+*	Function:		void BindlessSet::removeBuffer(uint32_t index)
+*	Purpose:		Frees an element for the next addBuffer, the frames reading it have to be finished
+*
+*/
+void BindlessSet::removeBuffer(uint32_t index) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	buffers.free.push_back(index);
+
+}
+
+/*
+*	Function:		uint32_t BindlessSet::addImage(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout)
+*	Purpose:		Writes a combined image sampler to a free element and returns its index, BINDLESS_INVALID if full
+*
+*/
+uint32_t BindlessSet::addImage(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout) {
+
+	uint32_t index;
+	{
+
+		std::lock_guard< std::mutex > lock(mutex);
+		index = images.take();
+
+	}
+	if (index == BINDLESS_INVALID) {
+
+		return index;
+
+	}
+
+	VkDescriptorImageInfo imageInfo;
+	imageInfo.sampler		= sampler;
+	imageInfo.imageView		= imageView;
+	imageInfo.imageLayout	= imageLayout;
+
+	VkWriteDescriptorSet write;
+	write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.pNext					= nullptr;
+	write.dstSet				= descriptorSet;
+	write.dstBinding			= BINDLESS_IMAGE_BINDING;
+	write.dstArrayElement		= index;
+	write.descriptorCount		= 1;
+	write.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	write.pImageInfo			= &imageInfo;
+	write.pBufferInfo			= nullptr;
+	write.pTexelBufferView		= nullptr;
+
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+	return index;
+
+}
+
+/*
+*	Function:		void BindlessSet::removeImage(uint32_t index)
+*	Purpose:		Frees an element for the next addImage, the frames sampling it have to be finished
+*
+*/
+void BindlessSet::removeImage(uint32_t index) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	images.free.push_back(index);
+
+}
+
+VkDescriptorSetLayout BindlessSet::layout() const {
+
+	return descriptorSetLayout;
+
+}
+
+VkDescriptorSet BindlessSet::set() const {
+
+	return descriptorSet;
+
+}
+
+uint32_t BindlessSet::amountOfBuffers() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return buffers.next - static_cast< uint32_t >(buffers.free.size());
+
+}
+
+uint32_t BindlessSet::amountOfImages() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return images.next - static_cast< uint32_t >(images.free.size());
+
+}
+
+/*
+*	Function:		void BindlessSet::destroy()
+*	Purpose:		Destroys the pool and with it the set, the layout stays with the layout cache
+*
+*/
+void BindlessSet::destroy() {
+
+	vkDestroyDescriptorPool(device, descriptorPool, allocationCallbacks);
+
+	descriptorPool			= VK_NULL_HANDLE;
+	descriptorSet			= VK_NULL_HANDLE;
+	descriptorSetLayout		= VK_NULL_HANDLE;
+
+}
+
+/*
+*	Function:		uint32_t BindlessSet::Slots::take()
+*	Purpose:		Returns the most recently freed element or the next unused one, called with the mutex held
+*
+*/
+uint32_t BindlessSet::Slots::take() {
+
+	if (!free.empty()) {
+
+		uint32_t index = free.back();
+		free.pop_back();
+		return index;
+
+	}
+
+	return next < capacity ? next++ : BINDLESS_INVALID;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+BindlessSet::~BindlessSet() {
+
+
+
+}
+
@@ -0,0 +1,66 @@
+/*
+*	File:			BindlessSet.hpp
+*	Purpose:		Contains class BindlessSet
+*
+*/
+#pragma once
+#include "DescriptorAllocator.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+#define BINDLESS_BUFFER_BINDING			0						// std430 buffer buffers[] of the shaders
+#define BINDLESS_IMAGE_BINDING			1						// sampler2D textures[] of the shaders
+#define BINDLESS_INVALID				UINT32_MAX				// Returned when the set is full
+
+/*
+*	Class:			BindlessSet
+*	Purpose:		One descriptor set holding every storage buffer and texture, shaders index it with the
+*					numbers add*() hand out, so a draw binds nothing but push constants
+*					Needs VK_EXT_descriptor_indexing with runtimeDescriptorArray, descriptorBindingPartiallyBound,
+*					descriptorBindingUpdateUnusedWhilePending and the UpdateAfterBind features of both types
+*
+*/
+class BindlessSet
+{
+public:
+	BindlessSet();
+	VkResult create(VkDevice device, DescriptorLayoutCache &layoutCache, uint32_t maxBuffers, uint32_t maxImages, VkShaderStageFlags stages, const VkAllocationCallbacks* allocator = nullptr);
+	uint32_t addBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+	void updateBuffer(uint32_t index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+	void removeBuffer(uint32_t index);
+	uint32_t addImage(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout);
+	void removeImage(uint32_t index);
+	VkDescriptorSetLayout layout(void) const;
+	VkDescriptorSet set(void) const;
+	uint32_t amountOfBuffers(void) const;
+	uint32_t amountOfImages(void) const;
+	void destroy(void);
+	~BindlessSet();
+private:
+	/*
+	*	Struct:			Slots
+	*	Purpose:		Array elements of one binding, removed ones are reused before the array grows
+	*
+	*/
+	struct Slots {
+
+		uint32_t							capacity;
+		uint32_t							next;				// Elements below were handed out at least once
+		std::vector< uint32_t >				free;
+
+		uint32_t take(void);
+
+	};
+
+	VkDevice								device;
+	const VkAllocationCallbacks*			allocationCallbacks;
+	VkDescriptorSetLayout					descriptorSetLayout;	// Owned by the layout cache
+	VkDescriptorPool						descriptorPool;			// Update after bind, holds the one set
+	VkDescriptorSet							descriptorSet;
+	Slots									buffers;
+	Slots									images;
+	mutable std::mutex						mutex;
+};
+
@@ -0,0 +1,239 @@
+/*
+*	File:			CommandRecorder.cpp
+*	Purpose:		Contains functions for class CommandRecorder
+*
+*/
+#include "CommandRecorder.hpp"
+#include <algorithm>
+
+/*
+*	Default constructor
+*
+*
+*/
+CommandRecorder::CommandRecorder() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	frames(0),
+	threads(0),
+	workers(nullptr) {
+
+
+
+}
+
+/*
+*	Function:		VkResult CommandRecorder::create(VkDevice device, uint32_t queueFamilyIndex, uint32_t amountOfFrames, uint32_t amountOfThreads, const VkAllocationCallbacks* allocator)
+*	Purpose:		Creates one transient command pool per recording thread and frame in flight
+*
+*/
+VkResult CommandRecorder::create(VkDevice device_, uint32_t queueFamilyIndex, uint32_t amountOfFrames, uint32_t amountOfThreads, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	frames				= amountOfFrames;
+	threads				= std::max(amountOfThreads, 1u);
+
+	// Command buffers are never reset one by one, so the pools do not need VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+	VkCommandPoolCreateInfo commandPoolCreateInfo;
+	commandPoolCreateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.pNext					= nullptr;
+	commandPoolCreateInfo.flags					= VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	commandPoolCreateInfo.queueFamilyIndex		= queueFamilyIndex;
+
+	// Value initialization leaves every handle VK_NULL_HANDLE, destroy() copes with a partial create
+	pools.resize(frames * threads);
+	for (RecordingPool &pool : pools) {
+
+		VkResult result = vkCreateCommandPool(
+
+			device,
+			&commandPoolCreateInfo,
+			allocationCallbacks,
+			&pool.commandPool
+
+		);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+
+	}
+
+	if (threads > 1) {
+
+		workers = new ThreadPool(threads - 1);
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult CommandRecorder::reset(uint32_t frame)
+*	Purpose:		Resets every pool of the frame, its fence has to be signaled
+*
+*/
+VkResult CommandRecorder::reset(uint32_t frame) {
+
+	for (uint32_t i = 0; i < threads; i++) {
+
+		RecordingPool &pool = pools[frame * threads + i];
+		if (pool.used == 0) {
+
+			continue;
+
+		}
+
+		VkResult result = vkResetCommandPool(device, pool.commandPool, 0);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		pool.used = 0;
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult CommandRecorder::record(uint32_t frame, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t amountOfDraws, const RecordFunction &recordFunction, std::vector< VkCommandBuffer > &secondaryCommandBuffers)
+*	Purpose:		Splits the draws into contiguous ranges, records one secondary command buffer per range on
+*					its own thread and returns them in draw order, ready for vkCmdExecuteCommands
+*
+*/
+VkResult CommandRecorder::record(uint32_t frame, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t amountOfDraws, const RecordFunction &recordFunction, std::vector< VkCommandBuffer > &secondaryCommandBuffers) {
+
+	uint32_t ranges = std::min(threads, std::max((amountOfDraws + COMMAND_RECORDER_MIN_DRAWS - 1) / COMMAND_RECORDER_MIN_DRAWS, 1u));
+	secondaryCommandBuffers.resize(ranges);
+
+	// Range i only ever touches pool i of this frame, so no two threads share a pool
+	std::vector< std::future< VkResult > > futures;
+	futures.reserve(ranges - 1);
+	for (uint32_t i = 1; i < ranges; i++) {
+
+		futures.push_back(workers->submit([this, frame, i, ranges, amountOfDraws, &inheritanceInfo, &recordFunction, &secondaryCommandBuffers]() {
+
+			uint32_t firstDraw	= static_cast< uint32_t >(static_cast< uint64_t >(amountOfDraws) * i / ranges);
+			uint32_t lastDraw	= static_cast< uint32_t >(static_cast< uint64_t >(amountOfDraws) * (i + 1) / ranges);
+			return recordRange(pools[frame * threads + i], inheritanceInfo, firstDraw, lastDraw - firstDraw, recordFunction, secondaryCommandBuffers[i]);
+
+		}));
+
+	}
+
+	VkResult result = recordRange(
+
+		pools[frame * threads],
+		inheritanceInfo,
+		0,
+		static_cast< uint32_t >(static_cast< uint64_t >(amountOfDraws) / ranges),
+		recordFunction,
+		secondaryCommandBuffers[0]
+
+	);
+
+	// Every range has to finish before returning, the tasks reference the arguments
+	for (std::future< VkResult > &future : futures) {
+
+		VkResult rangeResult = future.get();
+		if (result == VK_SUCCESS) {
+
+			result = rangeResult;
+
+		}
+
+	}
+
+	return result;
+
+}
+
+/*
+*	Function:		VkResult CommandRecorder::recordRange(RecordingPool &pool, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t firstDraw, uint32_t amountOfDraws, const RecordFunction &recordFunction, VkCommandBuffer &commandBuffer)
+*	Purpose:		Takes the next command buffer of the pool, allocating one if all are in use, and records a range into it
+*
+*/
+VkResult CommandRecorder::recordRange(RecordingPool &pool, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t firstDraw, uint32_t amountOfDraws, const RecordFunction &recordFunction, VkCommandBuffer &commandBuffer) {
+
+	VkResult result;
+	if (pool.used == pool.commandBuffers.size()) {
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo;
+		commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext					= nullptr;
+		commandBufferAllocateInfo.commandPool			= pool.commandPool;
+		commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		commandBufferAllocateInfo.commandBufferCount	= 1;
+
+		result = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		pool.commandBuffers.push_back(commandBuffer);
+
+	}
+	commandBuffer = pool.commandBuffers[pool.used++];
+
+	VkCommandBufferBeginInfo commandBufferBeginInfo;
+	commandBufferBeginInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.pNext				= nullptr;
+	commandBufferBeginInfo.flags				= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	commandBufferBeginInfo.pInheritanceInfo		= &inheritanceInfo;
+
+	result = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	recordFunction(commandBuffer, firstDraw, amountOfDraws);
+
+	return vkEndCommandBuffer(commandBuffer);
+
+}
+
+uint32_t CommandRecorder::amountOfThreads() const {
+
+	return threads;
+
+}
+
+/*
+*	Function:		void CommandRecorder::destroy()
+*	Purpose:		Stops the workers and destroys every pool together with its command buffers
+*
+*/
+void CommandRecorder::destroy() {
+
+	delete workers;
+	workers = nullptr;
+
+	for (RecordingPool &pool : pools) {
+
+		vkDestroyCommandPool(device, pool.commandPool, allocationCallbacks);
+
+	}
+	pools.clear();
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+CommandRecorder::~CommandRecorder() {
+
+
+
+}
+
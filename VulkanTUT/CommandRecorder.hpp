@@ -0,0 +1,56 @@
+/*
+*	File:			CommandRecorder.hpp
+*	Purpose:		Contains class CommandRecorder
+*
+*/
+#pragma once
+#include "ThreadPool.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+#define COMMAND_RECORDER_MIN_DRAWS			256			// Fewer draws per secondary command buffer are not worth a thread handoff
+
+/*
+*	Class:			CommandRecorder
+*	Purpose:		Records secondary command buffers of one render pass in parallel, every recording
+*					thread owns a transient command pool per frame in flight that is reset as a whole
+*
+*/
+class CommandRecorder
+{
+public:
+	typedef std::function< void(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t amountOfDraws) > RecordFunction;
+
+	CommandRecorder();
+	VkResult create(VkDevice device, uint32_t queueFamilyIndex, uint32_t amountOfFrames, uint32_t amountOfThreads, const VkAllocationCallbacks* allocator = nullptr);
+	VkResult reset(uint32_t frame);
+	VkResult record(uint32_t frame, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t amountOfDraws, const RecordFunction &recordFunction, std::vector< VkCommandBuffer > &secondaryCommandBuffers);
+	uint32_t amountOfThreads(void) const;
+	void destroy(void);
+	~CommandRecorder();
+private:
+	/*
+	*	Struct:			RecordingPool
+	*	Purpose:		Pool of one thread and frame, its command buffers are reused after every reset
+	*
+	*/
+	struct RecordingPool {
+
+		VkCommandPool						commandPool;
+		std::vector< VkCommandBuffer >		commandBuffers;
+		uint32_t							used;					// Command buffers handed out since the last reset
+
+	};
+
+	VkResult recordRange(RecordingPool &pool, const VkCommandBufferInheritanceInfo &inheritanceInfo, uint32_t firstDraw, uint32_t amountOfDraws, const RecordFunction &recordFunction, VkCommandBuffer &commandBuffer);
+
+	VkDevice							device;
+	const VkAllocationCallbacks*		allocationCallbacks;		// Passed to every pool create and destroy
+	uint32_t							frames;
+	uint32_t							threads;
+	std::vector< RecordingPool >		pools;						// frames * threads, indexed frame * threads + thread
+	ThreadPool*							workers;					// threads - 1 workers, the calling thread records too
+};
+
@@ -0,0 +1,442 @@
+/*
+*	File:			DescriptorAllocator.cpp
+*	Purpose:		Contains functions for classes DescriptorLayoutCache and DescriptorAllocator
+*
+*/
+#include "DescriptorAllocator.hpp"
+#include <algorithm>
+
+/*
+*	Function:		static void hashValue(uint64_t &hash, uint64_t value)
+*	Purpose:		Mixes one field of a layout key into its hash, xor then multiply by a 64 bit prime
+*
+*/
+static void hashValue(uint64_t &hash, uint64_t value) {
+
+	hash ^= value;
+	hash *= 0x100000001B3ULL;
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+DescriptorLayoutCache::DescriptorLayoutCache() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	hits(0) {
+
+
+
+}
+
+/*
+*	Function:		void DescriptorLayoutCache::init(VkDevice device, const VkAllocationCallbacks* allocator)
+*	Purpose:		Sets the device layouts are created on and the callbacks they are created with
+*
+*/
+void DescriptorLayoutCache::init(VkDevice device_, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+
+}
+
+/*
+*	Function:		VkResult DescriptorLayoutCache::get(const std::vector< VkDescriptorSetLayoutBinding > &bindings, VkDescriptorSetLayout &layout, VkDescriptorSetLayoutCreateFlags flags, const std::vector< VkDescriptorBindingFlagsEXT > &bindingFlags)
+*	Purpose:		Returns the layout of the bindings, creating it only on the first request, bindingFlags is
+*					empty or holds the VK_EXT_descriptor_indexing flags of every binding, safe to call from any thread
+*					The layout is owned by the cache and destroyed by destroy()
+*
+*/
+VkResult DescriptorLayoutCache::get(const std::vector< VkDescriptorSetLayoutBinding > &bindings, VkDescriptorSetLayout &layout, VkDescriptorSetLayoutCreateFlags flags, const std::vector< VkDescriptorBindingFlagsEXT > &bindingFlags) {
+
+	if (!bindingFlags.empty() && bindingFlags.size() != bindings.size()) {
+
+		return VK_ERROR_INITIALIZATION_FAILED;
+
+	}
+
+	Key key;
+	key.flags = flags;
+	key.bindings.resize(bindings.size());
+	for (size_t i = 0; i < bindings.size(); i++) {
+
+		Binding &binding	= key.bindings[i];
+		binding.binding		= bindings[i].binding;
+		binding.type		= bindings[i].descriptorType;
+		binding.count		= bindings[i].descriptorCount;
+		binding.stages		= bindings[i].stageFlags;
+		binding.flags		= bindingFlags.empty() ? 0 : bindingFlags[i];
+		if (bindings[i].pImmutableSamplers != nullptr) {
+
+			binding.immutableSamplers.assign(bindings[i].pImmutableSamplers, bindings[i].pImmutableSamplers + bindings[i].descriptorCount);
+
+		}
+
+	}
+	std::sort(key.bindings.begin(), key.bindings.end(), [](const Binding &a, const Binding &b) {
+
+		return a.binding < b.binding;
+
+	});
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	auto cached = layouts.find(key);
+	if (cached != layouts.end()) {
+
+		hits++;
+		layout = cached->second;
+		return VK_SUCCESS;
+
+	}
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo;
+	bindingFlagsCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+	bindingFlagsCreateInfo.pNext			= nullptr;
+	bindingFlagsCreateInfo.bindingCount		= static_cast< uint32_t >(bindingFlags.size());
+	bindingFlagsCreateInfo.pBindingFlags	= bindingFlags.data();
+
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo;
+	descriptorSetLayoutCreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutCreateInfo.pNext				= bindingFlags.empty() ? nullptr : &bindingFlagsCreateInfo;
+	descriptorSetLayoutCreateInfo.flags				= flags;
+	descriptorSetLayoutCreateInfo.bindingCount		= static_cast< uint32_t >(bindings.size());
+	descriptorSetLayoutCreateInfo.pBindings			= bindings.data();
+
+	VkResult result = vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, allocationCallbacks, &layout);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	layouts.emplace(std::move(key), layout);
+
+	return VK_SUCCESS;
+
+}
+
+uint32_t DescriptorLayoutCache::amountOfLayouts() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return static_cast< uint32_t >(layouts.size());
+
+}
+
+uint32_t DescriptorLayoutCache::amountOfHits() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return hits;
+
+}
+
+/*
+*	Function:		void DescriptorLayoutCache::destroy()
+*	Purpose:		Destroys every layout, has to be called after the pipeline layouts and sets using them are gone
+*
+*/
+void DescriptorLayoutCache::destroy() {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	for (auto &entry : layouts) {
+
+		vkDestroyDescriptorSetLayout(device, entry.second, allocationCallbacks);
+
+	}
+	layouts.clear();
+
+}
+
+bool DescriptorLayoutCache::Binding::operator==(const Binding &other) const {
+
+	return binding == other.binding && type == other.type && count == other.count && stages == other.stages &&
+		flags == other.flags && immutableSamplers == other.immutableSamplers;
+
+}
+
+bool DescriptorLayoutCache::Key::operator==(const Key &other) const {
+
+	return flags == other.flags && bindings == other.bindings;
+
+}
+
+size_t DescriptorLayoutCache::KeyHash::operator()(const Key &key) const {
+
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hashValue(hash, key.flags);
+	for (const Binding &binding : key.bindings) {
+
+		hashValue(hash, binding.binding);
+		hashValue(hash, static_cast< uint64_t >(binding.type));
+		hashValue(hash, binding.count);
+		hashValue(hash, binding.stages);
+		hashValue(hash, binding.flags);
+		for (VkSampler sampler : binding.immutableSamplers) {
+
+			hashValue(hash, reinterpret_cast< uint64_t >(sampler));
+
+		}
+
+	}
+
+	return static_cast< size_t >(hash);
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+DescriptorLayoutCache::~DescriptorLayoutCache() {
+
+
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+DescriptorAllocator::DescriptorAllocator() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	poolSets(DESCRIPTOR_POOL_SETS),
+	pools(0),
+	sets(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult DescriptorAllocator::create(VkDevice device, uint32_t amountOfFrames, const std::vector< DescriptorPoolRatio > &ratios, const VkAllocationCallbacks* allocator)
+*	Purpose:		Prepares the pools of every frame in flight, no pool is created before the first allocation
+*					ratios size every pool, a layout needing more of a type than a pool holds cannot be allocated
+*
+*/
+VkResult DescriptorAllocator::create(VkDevice device_, uint32_t amountOfFrames, const std::vector< DescriptorPoolRatio > &ratios, const VkAllocationCallbacks* allocator) {
+
+	if (ratios.empty()) {
+
+		return VK_ERROR_INITIALIZATION_FAILED;
+
+	}
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	poolRatios			= ratios;
+	poolSets			= DESCRIPTOR_POOL_SETS;
+	pools				= 0;
+	sets				= 0;
+	frames.resize(amountOfFrames + 1);
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult DescriptorAllocator::allocate(uint32_t frame, VkDescriptorSetLayout layout, VkDescriptorSet &set)
+*	Purpose:		Allocates a set valid until reset(frame), or until destroy() for DESCRIPTOR_PERSISTENT,
+*					a full or fragmented pool is retired to the frame and the allocation retried in another one
+*
+*/
+VkResult DescriptorAllocator::allocate(uint32_t frame, VkDescriptorSetLayout layout, VkDescriptorSet &set) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	FramePools &target = framePools(frame);
+	VkResult result;
+	if (target.used.empty()) {
+
+		VkDescriptorPool pool;
+		result = nextPool(pool);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		target.used.push_back(pool);
+
+	}
+
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.pNext					= nullptr;
+	descriptorSetAllocateInfo.descriptorPool		= target.used.back();
+	descriptorSetAllocateInfo.descriptorSetCount	= 1;
+	descriptorSetAllocateInfo.pSetLayouts			= &layout;
+
+	result = vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &set);
+	if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+
+		// The full pool stays with the frame, its sets are still in use until the next reset
+		VkDescriptorPool pool;
+		result = nextPool(pool);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		target.used.push_back(pool);
+
+		descriptorSetAllocateInfo.descriptorPool = pool;
+		result = vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &set);
+
+	}
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	sets++;
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult DescriptorAllocator::reset(uint32_t frame)
+*	Purpose:		Frees every set of the frame at once, call after its fence signaled, the pools become free for any frame
+*
+*/
+VkResult DescriptorAllocator::reset(uint32_t frame) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	FramePools &target = framePools(frame);
+	for (VkDescriptorPool pool : target.used) {
+
+		VkResult result = vkResetDescriptorPool(device, pool, 0);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		freePools.push_back(pool);
+
+	}
+	target.used.clear();
+
+	return VK_SUCCESS;
+
+}
+
+uint32_t DescriptorAllocator::amountOfPools() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return pools;
+
+}
+
+uint64_t DescriptorAllocator::amountOfSets() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return sets;
+
+}
+
+/*
+*	Function:		void DescriptorAllocator::destroy()
+*	Purpose:		Destroys every pool and with them every set, no frame may be in flight
+*
+*/
+void DescriptorAllocator::destroy() {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	for (FramePools &framePool : frames) {
+
+		for (VkDescriptorPool pool : framePool.used) {
+
+			vkDestroyDescriptorPool(device, pool, allocationCallbacks);
+
+		}
+
+	}
+	for (VkDescriptorPool pool : freePools) {
+
+		vkDestroyDescriptorPool(device, pool, allocationCallbacks);
+
+	}
+	frames.clear();
+	freePools.clear();
+
+}
+
+/*
+*	Function:		FramePools &DescriptorAllocator::framePools(uint32_t frame)
+*	Purpose:		Maps DESCRIPTOR_PERSISTENT to the last entry of frames
+*
+*/
+DescriptorAllocator::FramePools &DescriptorAllocator::framePools(uint32_t frame) {
+
+	return frame == DESCRIPTOR_PERSISTENT ? frames.back() : frames[frame];
+
+}
+
+/*
+*	Function:		VkResult DescriptorAllocator::nextPool(VkDescriptorPool &pool)
+*	Purpose:		Takes a reset pool or creates one twice the size of the previous, called with the mutex held
+*
+*/
+VkResult DescriptorAllocator::nextPool(VkDescriptorPool &pool) {
+
+	if (!freePools.empty()) {
+
+		pool = freePools.back();
+		freePools.pop_back();
+		return VK_SUCCESS;
+
+	}
+
+	std::vector< VkDescriptorPoolSize > poolSizes;
+	for (const DescriptorPoolRatio &ratio : poolRatios) {
+
+		VkDescriptorPoolSize poolSize;
+		poolSize.type				= ratio.type;
+		poolSize.descriptorCount	= std::max(static_cast< uint32_t >(ratio.perSet * poolSets), 1u);
+		poolSizes.push_back(poolSize);
+
+	}
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo;
+	descriptorPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.pNext				= nullptr;
+	descriptorPoolCreateInfo.flags				= 0;
+	descriptorPoolCreateInfo.maxSets			= poolSets;
+	descriptorPoolCreateInfo.poolSizeCount		= static_cast< uint32_t >(poolSizes.size());
+	descriptorPoolCreateInfo.pPoolSizes			= poolSizes.data();
+
+	VkResult result = vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, allocationCallbacks, &pool);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	pools++;
+	poolSets = std::min(poolSets * 2, static_cast< uint32_t >(DESCRIPTOR_POOL_MAX_SETS));
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+DescriptorAllocator::~DescriptorAllocator() {
+
+
+
+}
+
@@ -0,0 +1,139 @@
+/*
+*	File:			DescriptorAllocator.hpp
+*	Purpose:		Contains struct DescriptorPoolRatio and classes DescriptorLayoutCache and DescriptorAllocator
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+#define DESCRIPTOR_POOL_SETS			64						// Sets of the first pool, every further pool doubles it
+#define DESCRIPTOR_POOL_MAX_SETS		4096					// Pools stop growing at this size
+#define DESCRIPTOR_PERSISTENT			UINT32_MAX				// Frame of sets that live until DescriptorAllocator::destroy
+
+/*
+*	Class:			DescriptorLayoutCache
+*	Purpose:		Creates every distinct descriptor set layout once, identical binding lists share one layout
+*					regardless of their order, so layouts can be compared by handle
+*
+*/
+class DescriptorLayoutCache
+{
+public:
+	DescriptorLayoutCache();
+	void init(VkDevice device, const VkAllocationCallbacks* allocator = nullptr);
+	VkResult get(const std::vector< VkDescriptorSetLayoutBinding > &bindings, VkDescriptorSetLayout &layout, VkDescriptorSetLayoutCreateFlags flags = 0, const std::vector< VkDescriptorBindingFlagsEXT > &bindingFlags = {});
+	uint32_t amountOfLayouts(void) const;
+	uint32_t amountOfHits(void) const;
+	void destroy(void);
+	~DescriptorLayoutCache();
+private:
+	/*
+	*	Struct:			Binding
+	*	Purpose:		VkDescriptorSetLayoutBinding with its binding flags and a copy of its immutable samplers
+	*
+	*/
+	struct Binding {
+
+		uint32_t							binding;
+		VkDescriptorType					type;
+		uint32_t							count;
+		VkShaderStageFlags					stages;
+		VkDescriptorBindingFlagsEXT			flags;
+		std::vector< VkSampler >			immutableSamplers;
+
+		bool operator==(const Binding &other) const;
+
+	};
+
+	/*
+	*	Struct:			Key
+	*	Purpose:		Everything a layout is created from, bindings sorted by binding number
+	*
+	*/
+	struct Key {
+
+		VkDescriptorSetLayoutCreateFlags	flags;
+		std::vector< Binding >				bindings;
+
+		bool operator==(const Key &other) const;
+
+	};
+
+	/*
+	*	Struct:			KeyHash
+	*	Purpose:		Hashes the flags and every binding field of a Key, operator== settles equal hashes
+	*
+	*/
+	struct KeyHash {
+
+		size_t operator()(const Key &key) const;
+
+	};
+
+	VkDevice														device;
+	const VkAllocationCallbacks*									allocationCallbacks;
+	std::unordered_map< Key, VkDescriptorSetLayout, KeyHash >		layouts;
+	uint32_t														hits;				// Requests served without creating a layout
+	mutable std::mutex												mutex;
+};
+
+/*
+*	Struct:			DescriptorPoolRatio
+*	Purpose:		Descriptors of one type a pool reserves per set it can hold
+*
+*/
+struct DescriptorPoolRatio {
+
+	VkDescriptorType			type;
+	float						perSet;
+
+};
+
+/*
+*	Class:			DescriptorAllocator
+*	Purpose:		Allocates descriptor sets from pools that grow on demand, every frame in flight allocates
+*					from its own pools, which are reset as a whole once its fence signaled and go back to a
+*					shared free list, sets of DESCRIPTOR_PERSISTENT are never reset
+*
+*/
+class DescriptorAllocator
+{
+public:
+	DescriptorAllocator();
+	VkResult create(VkDevice device, uint32_t amountOfFrames, const std::vector< DescriptorPoolRatio > &ratios, const VkAllocationCallbacks* allocator = nullptr);
+	VkResult allocate(uint32_t frame, VkDescriptorSetLayout layout, VkDescriptorSet &set);
+	VkResult reset(uint32_t frame);
+	uint32_t amountOfPools(void) const;
+	uint64_t amountOfSets(void) const;
+	void destroy(void);
+	~DescriptorAllocator();
+private:
+	/*
+	*	Struct:			FramePools
+	*	Purpose:		Pools one frame allocated from since its last reset, the last one is still used
+	*
+	*/
+	struct FramePools {
+
+		std::vector< VkDescriptorPool >		used;
+
+	};
+
+	FramePools &framePools(uint32_t frame);
+	VkResult nextPool(VkDescriptorPool &pool);
+
+	VkDevice										device;
+	const VkAllocationCallbacks*					allocationCallbacks;
+	std::vector< DescriptorPoolRatio >				poolRatios;
+	std::vector< FramePools >						frames;				// One per frame in flight plus DESCRIPTOR_PERSISTENT last
+	std::vector< VkDescriptorPool >					freePools;			// Reset, ready for any frame
+	uint32_t										poolSets;			// Sets of the next pool created
+	uint32_t										pools;				// Created since create()
+	uint64_t										sets;				// Allocated since create()
+	mutable std::mutex								mutex;
+};
+
@@ -0,0 +1,453 @@
+/*
+*	File:			DeviceSelector.cpp
+*	Purpose:		Contains functions for class DeviceSelector
+*
+*/
+#include "DeviceSelector.hpp"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+/*
+*	Default constructor
+*
+*
+*/
+DeviceSelector::DeviceSelector(std::string fileName_) :
+	fileName(fileName_),
+	snapshot(),
+	cached(false) {
+
+
+
+}
+
+/*
+*	Function:		VkResult DeviceSelector::select(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index)
+*	Purpose:		Returns the index of the best device meeting the requirements, a valid snapshot
+*					on disk skips querying and scoring the devices
+*
+*/
+VkResult DeviceSelector::select(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index) {
+
+	scored.clear();
+	cached = false;
+
+	if (loadCache(amountOfDevices, devices, requirements, index)) {
+
+		cached		= true;
+		statusText	= "reused snapshot of " + std::string(snapshot.properties.deviceName) + " from " + fileName;
+		return VK_SUCCESS;
+
+	}
+	std::string cacheReason = statusText;
+
+	int64_t bestScore = DEVICE_SCORE_REJECTED;
+	for (uint32_t i = 0; i < amountOfDevices; i++) {
+
+		DeviceCapabilities candidate = {};
+		DeviceCandidate entry;
+		if (evaluate(devices[i], requirements, candidate, entry.reason)) {
+
+			candidate.score = score(candidate);
+
+		}
+		else {
+
+			candidate.score = DEVICE_SCORE_REJECTED;
+
+		}
+		entry.name	= candidate.properties.deviceName;
+		entry.score	= candidate.score;
+		scored.push_back(entry);
+
+		if (candidate.score > bestScore) {
+
+			bestScore	= candidate.score;
+			snapshot	= candidate;
+			index		= i;
+
+		}
+
+	}
+
+	if (bestScore == DEVICE_SCORE_REJECTED) {
+
+		statusText = "none of " + std::to_string(amountOfDevices) + " devices meets the requirements";
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+	}
+
+	statusText = "selected " + std::string(snapshot.properties.deviceName) + " out of " + std::to_string(amountOfDevices) + " devices (" + cacheReason + ")";
+	if (!saveCache(amountOfDevices, requirements)) {
+
+		statusText += ", failed to write " + fileName;
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+const DeviceCapabilities &DeviceSelector::capabilities() const {
+
+	return snapshot;
+
+}
+
+/*
+*	Function:		const std::vector< DeviceCandidate > &DeviceSelector::candidates()
+*	Purpose:		Returns the score of every device, empty if the snapshot was reused
+*
+*/
+const std::vector< DeviceCandidate > &DeviceSelector::candidates() const {
+
+	return scored;
+
+}
+
+bool DeviceSelector::loadedFromCache() const {
+
+	return cached;
+
+}
+
+/*
+*	Function:		const std::string &DeviceSelector::status()
+*	Purpose:		Describes how the device was selected, for the log
+*
+*/
+const std::string &DeviceSelector::status() const {
+
+	return statusText;
+
+}
+
+/*
+*	Function:		int64_t DeviceSelector::score(const DeviceCapabilities &capabilities)
+*	Purpose:		Rates a device that meets the requirements, the device type dominates, within
+*					one type more device local memory and larger limits win
+*
+*/
+int64_t DeviceSelector::score(const DeviceCapabilities &capabilities) {
+
+	int64_t value = 0;
+	switch (capabilities.properties.deviceType) {
+
+	case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+		value = 1000000;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+		value = 500000;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+		value = 250000;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_CPU:
+		value = 10000;
+		break;
+	default:
+		break;
+
+	}
+
+	const VkPhysicalDeviceLimits &limits = capabilities.properties.limits;
+	value += static_cast< int64_t >(capabilities.deviceLocalBytes >> 24);				// 512 per 8 GiB
+	value += limits.maxImageDimension2D / 256;											// 64 for 16384
+	value += limits.maxComputeSharedMemorySize / 1024;									// 32 for 32 KiB
+	value += limits.timestampComputeAndGraphics ? 16 : 0;
+
+	return value;
+
+}
+
+/*
+*	Function:		bool DeviceSelector::evaluate(VkPhysicalDevice device, const DeviceRequirements &requirements, DeviceCapabilities &snapshot, std::string &reason)
+*	Purpose:		Queries a device and checks it against the requirements, reason is set if it fails them
+*
+*/
+bool DeviceSelector::evaluate(VkPhysicalDevice device, const DeviceRequirements &requirements, DeviceCapabilities &snapshot, std::string &reason) const {
+
+	vkGetPhysicalDeviceProperties(device, &snapshot.properties);
+	vkGetPhysicalDeviceFeatures(device, &snapshot.features);
+	vkGetPhysicalDeviceMemoryProperties(device, &snapshot.memoryProperties);
+
+	snapshot.deviceLocalBytes = 0;
+	for (uint32_t i = 0; i < snapshot.memoryProperties.memoryHeapCount; i++) {
+
+		if (snapshot.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+
+			snapshot.deviceLocalBytes += snapshot.memoryProperties.memoryHeaps[i].size;
+
+		}
+
+	}
+
+	// VkPhysicalDeviceFeatures is nothing but VkBool32 members
+	const VkBool32* required	= reinterpret_cast< const VkBool32* >(&requirements.features);
+	const VkBool32* available	= reinterpret_cast< const VkBool32* >(&snapshot.features);
+	for (size_t i = 0; i < sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32); i++) {
+
+		if (required[i] && !available[i]) {
+
+			reason = "missing feature #" + std::to_string(i);
+			return false;
+
+		}
+
+	}
+
+	uint32_t amountOfExtensions = 0;
+	vkEnumerateDeviceExtensionProperties(device, nullptr, &amountOfExtensions, nullptr);
+	std::vector< VkExtensionProperties > extensions(amountOfExtensions);
+	vkEnumerateDeviceExtensionProperties(device, nullptr, &amountOfExtensions, extensions.data());
+
+	for (const char* name : requirements.extensions) {
+
+		bool found = false;
+		for (const VkExtensionProperties &extension : extensions) {
+
+			found = found || std::strcmp(extension.extensionName, name) == 0;
+
+		}
+		if (!found) {
+
+			reason = "missing extension " + std::string(name);
+			return false;
+
+		}
+
+	}
+
+	uint32_t amountOfQueueFamilies = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &amountOfQueueFamilies, nullptr);
+	std::vector< VkQueueFamilyProperties > families(amountOfQueueFamilies);
+	vkGetPhysicalDeviceQueueFamilyProperties(device, &amountOfQueueFamilies, families.data());
+
+	snapshot.graphicsQueueFamily = UINT32_MAX;
+	for (uint32_t i = 0; i < amountOfQueueFamilies && snapshot.graphicsQueueFamily == UINT32_MAX; i++) {
+
+		if ((families[i].queueFlags & requirements.queueFlags) != requirements.queueFlags || families[i].queueCount == 0) {
+
+			continue;
+
+		}
+
+		VkBool32 presents = VK_TRUE;
+		if (requirements.surface != VK_NULL_HANDLE && vkGetPhysicalDeviceSurfaceSupportKHR(device, i, requirements.surface, &presents) != VK_SUCCESS) {
+
+			presents = VK_FALSE;
+
+		}
+		if (presents) {
+
+			snapshot.graphicsQueueFamily = i;
+
+		}
+
+	}
+
+	if (snapshot.graphicsQueueFamily == UINT32_MAX) {
+
+		reason = requirements.surface != VK_NULL_HANDLE ? "no queue family that renders and presents" : "no queue family with the required flags";
+		return false;
+
+	}
+
+	// Families without graphics map to separate hardware queues, otherwise use further queues of a shared family
+	std::vector< uint32_t > taken(amountOfQueueFamilies, 0);
+	auto take = [&families, &taken](uint32_t family) {
+
+		uint32_t index = std::min(taken[family], families[family].queueCount - 1);
+		taken[family]++;
+		return index;
+
+	};
+	auto dedicated = [&families](VkQueueFlags wanted, VkQueueFlags unwanted) {
+
+		for (uint32_t i = 0; i < families.size(); i++) {
+
+			if ((families[i].queueFlags & wanted) == wanted && !(families[i].queueFlags & unwanted) && families[i].queueCount > 0) {
+
+				return i;
+
+			}
+
+		}
+		return UINT32_MAX;
+
+	};
+
+	take(snapshot.graphicsQueueFamily);
+
+	snapshot.computeQueueFamily = dedicated(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+	if (snapshot.computeQueueFamily == UINT32_MAX) {
+
+		snapshot.computeQueueFamily = snapshot.graphicsQueueFamily;
+
+	}
+	snapshot.computeQueueIndex = take(snapshot.computeQueueFamily);
+
+	// Graphics and compute families support transfers without reporting the bit
+	snapshot.transferQueueFamily = dedicated(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+	if (snapshot.transferQueueFamily == UINT32_MAX) {
+
+		snapshot.transferQueueFamily = snapshot.computeQueueFamily;
+
+	}
+	snapshot.transferQueueIndex = take(snapshot.transferQueueFamily);
+
+	return true;
+
+}
+
+/*
+*	Function:		bool DeviceSelector::loadCache(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index)
+*	Purpose:		Reads the snapshot and finds its device, only vkGetPhysicalDeviceProperties is queried
+*					per device, statusText is set to the reason if the snapshot cannot be used
+*
+*/
+bool DeviceSelector::loadCache(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index) {
+
+	CacheFile cache;
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file || !file.read(reinterpret_cast< char* >(&cache), sizeof(cache))) {
+
+		statusText = "no snapshot in " + fileName;
+		return false;
+
+	}
+
+	if (cache.magic != DEVICE_CACHE_MAGIC || cache.version != DEVICE_CACHE_VERSION || cache.size != sizeof(CacheFile)) {
+
+		statusText = "snapshot format changed";
+		return false;
+
+	}
+	if (cache.amountOfDevices != amountOfDevices) {
+
+		statusText = "device list changed";
+		return false;
+
+	}
+	if (cache.requirementsHash != hash(requirements)) {
+
+		statusText = "requirements changed";
+		return false;
+
+	}
+
+	const VkPhysicalDeviceProperties &cachedProperties = cache.capabilities.properties;
+	for (uint32_t i = 0; i < amountOfDevices; i++) {
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(devices[i], &properties);
+
+		if (properties.vendorID != cachedProperties.vendorID || properties.deviceID != cachedProperties.deviceID
+			|| std::memcmp(properties.pipelineCacheUUID, cachedProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+
+			continue;
+
+		}
+
+		if (properties.driverVersion != cachedProperties.driverVersion || properties.apiVersion != cachedProperties.apiVersion) {
+
+			statusText = "driver changed";
+			return false;
+
+		}
+
+		// The surface is new every run, the family presenting to the last one may not present to this one
+		VkBool32 presents = VK_TRUE;
+		if (requirements.surface != VK_NULL_HANDLE) {
+
+			vkGetPhysicalDeviceSurfaceSupportKHR(devices[i], cache.capabilities.graphicsQueueFamily, requirements.surface, &presents);
+
+		}
+		if (!presents) {
+
+			statusText = "cached queue family cannot present";
+			return false;
+
+		}
+
+		snapshot	= cache.capabilities;
+		index		= i;
+		return true;
+
+	}
+
+	statusText = "cached device not found";
+	return false;
+
+}
+
+/*
+*	Function:		bool DeviceSelector::saveCache(uint32_t amountOfDevices, const DeviceRequirements &requirements)
+*	Purpose:		Writes the snapshot of the selected device, a torn file fails the size check on load
+*
+*/
+bool DeviceSelector::saveCache(uint32_t amountOfDevices, const DeviceRequirements &requirements) const {
+
+	CacheFile cache;
+	std::memset(&cache, 0, sizeof(cache));
+	cache.magic				= DEVICE_CACHE_MAGIC;
+	cache.version			= DEVICE_CACHE_VERSION;
+	cache.size				= sizeof(CacheFile);
+	cache.amountOfDevices	= amountOfDevices;
+	cache.requirementsHash	= hash(requirements);
+	cache.capabilities		= snapshot;
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast< const char* >(&cache), sizeof(cache));
+
+	return static_cast< bool >(file);
+
+}
+
+/*
+*	Function:		uint64_t DeviceSelector::hash(const DeviceRequirements &requirements)
+*	Purpose:		64 bit FNV-1a over features, extension names, queue flags and whether to present
+*
+*/
+uint64_t DeviceSelector::hash(const DeviceRequirements &requirements) {
+
+	uint64_t value = 0xCBF29CE484222325ULL;
+	auto mix = [&value](const void* data, size_t size) {
+
+		const uint8_t* bytes = static_cast< const uint8_t* >(data);
+		for (size_t i = 0; i < size; i++) {
+
+			value ^= bytes[i];
+			value *= 0x100000001B3ULL;
+
+		}
+
+	};
+
+	mix(&requirements.features, sizeof(requirements.features));
+	for (const char* name : requirements.extensions) {
+
+		mix(name, std::strlen(name) + 1);
+
+	}
+	mix(&requirements.queueFlags, sizeof(requirements.queueFlags));
+
+	uint8_t presents = requirements.surface != VK_NULL_HANDLE ? 1 : 0;
+	mix(&presents, sizeof(presents));
+
+	return value;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+DeviceSelector::~DeviceSelector() {
+
+
+
+}
+
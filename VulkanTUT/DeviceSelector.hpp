@@ -0,0 +1,108 @@
+/*
+*	File:			DeviceSelector.hpp
+*	Purpose:		Contains structs DeviceRequirements, DeviceCapabilities and class DeviceSelector
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#define DEVICE_CACHE_MAGIC				0x43564544				// "DEVC", first word of the snapshot file
+#define DEVICE_CACHE_VERSION			2						// Bump when DeviceCapabilities changes
+#define DEVICE_SCORE_REJECTED			-1						// Score of devices that miss a requirement
+
+/*
+*	Struct:			DeviceRequirements
+*	Purpose:		What a physical device has to offer to be selected at all
+*
+*/
+struct DeviceRequirements {
+
+	VkPhysicalDeviceFeatures				features;				// VK_TRUE members are required
+	std::vector< const char* >				extensions;
+	VkQueueFlags							queueFlags;				// Needed on one queue family
+	VkSurfaceKHR							surface;				// That family also has to present, VK_NULL_HANDLE in headless mode
+
+};
+
+/*
+*	Struct:			DeviceCapabilities
+*	Purpose:		Snapshot of the selected device, plain data so it can be written to disk as is
+*
+*/
+struct DeviceCapabilities {
+
+	VkPhysicalDeviceProperties				properties;
+	VkPhysicalDeviceFeatures				features;
+	VkPhysicalDeviceMemoryProperties		memoryProperties;
+	VkDeviceSize							deviceLocalBytes;		// Sum of all device local heaps
+	uint32_t								graphicsQueueFamily;	// Family with the required flags, presenting if a surface was given, queue 0
+	uint32_t								computeQueueFamily;		// Compute without graphics where the hardware has such a family
+	uint32_t								computeQueueIndex;
+	uint32_t								transferQueueFamily;	// Transfer without graphics and compute where the hardware has such a family
+	uint32_t								transferQueueIndex;
+	int64_t									score;
+
+};
+
+/*
+*	Struct:			DeviceCandidate
+*	Purpose:		Outcome of scoring one device, for the log
+*
+*/
+struct DeviceCandidate {
+
+	std::string								name;
+	int64_t									score;
+	std::string								reason;					// Why the device was rejected, empty otherwise
+
+};
+
+/*
+*	Class:			DeviceSelector
+*	Purpose:		Picks the physical device with the highest score, the snapshot of the winner is
+*					cached on disk and reused as long as driver, device list and requirements match
+*
+*/
+class DeviceSelector
+{
+public:
+	DeviceSelector(std::string fileName = "device.cache");
+	VkResult select(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index);
+	const DeviceCapabilities &capabilities(void) const;
+	const std::vector< DeviceCandidate > &candidates(void) const;
+	bool loadedFromCache(void) const;
+	const std::string &status(void) const;
+	static int64_t score(const DeviceCapabilities &capabilities);
+	~DeviceSelector();
+private:
+	/*
+	*	Struct:			CacheFile
+	*	Purpose:		Layout of the snapshot file
+	*
+	*/
+	struct CacheFile {
+
+		uint32_t							magic;
+		uint32_t							version;
+		uint32_t							size;					// sizeof(CacheFile), catches other compilers and packing
+		uint32_t							amountOfDevices;		// A device added or removed invalidates the choice
+		uint64_t							requirementsHash;
+		DeviceCapabilities					capabilities;
+
+	};
+
+	bool evaluate(VkPhysicalDevice device, const DeviceRequirements &requirements, DeviceCapabilities &snapshot, std::string &reason) const;
+	bool loadCache(uint32_t amountOfDevices, const VkPhysicalDevice* devices, const DeviceRequirements &requirements, uint32_t &index);
+	bool saveCache(uint32_t amountOfDevices, const DeviceRequirements &requirements) const;
+	static uint64_t hash(const DeviceRequirements &requirements);
+
+	std::string						fileName;
+	DeviceCapabilities				snapshot;
+	std::vector< DeviceCandidate >	scored;
+	bool							cached;
+	std::string						statusText;
+};
+
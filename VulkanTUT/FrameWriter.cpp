@@ -0,0 +1,288 @@
+/*
+*	File:			FrameWriter.cpp
+*	Purpose:		Contains functions for class FrameWriter
+*
+*/
+#include "FrameWriter.hpp"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	/*
+	*	Function:		uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length)
+	*	Purpose:		Continues the CRC-32 of PNG chunks, start with crc = 0
+	*
+	*/
+	uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length) {
+
+		struct Table {
+
+			uint32_t entries[256];
+
+			Table() {
+
+				for (uint32_t i = 0; i < 256; i++) {
+
+					uint32_t c = i;
+					for (int k = 0; k < 8; k++) {
+
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+
+					}
+					entries[i] = c;
+
+				}
+
+			}
+
+		};
+		static const Table table;
+
+		crc = ~crc;
+		for (size_t i = 0; i < length; i++) {
+
+			crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+		}
+		return ~crc;
+
+	}
+
+	void putBigEndian(std::vector< uint8_t > &out, uint32_t value) {
+
+		out.push_back(static_cast< uint8_t >(value >> 24));
+		out.push_back(static_cast< uint8_t >(value >> 16));
+		out.push_back(static_cast< uint8_t >(value >> 8));
+		out.push_back(static_cast< uint8_t >(value));
+
+	}
+
+	/*
+	*	Function:		void putChunk(std::vector< uint8_t > &out, const char* type, const uint8_t* data, uint32_t length)
+	*	Purpose:		Appends length, type, data and CRC of one PNG chunk
+	*
+	*/
+	void putChunk(std::vector< uint8_t > &out, const char* type, const uint8_t* data, uint32_t length) {
+
+		putBigEndian(out, length);
+		size_t typeOffset = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data, data + length);
+		putBigEndian(out, crc32(0, out.data() + typeOffset, length + 4));
+
+	}
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+FrameWriter::FrameWriter(std::string directory_, int format_, uint32_t width_, uint32_t height_) :
+	directory(directory_),
+	format(format_),
+	width(width_),
+	height(height_) {
+
+	if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') {
+
+		directory += '/';
+
+	}
+
+}
+
+/*
+*	Function:		bool FrameWriter::write(uint64_t frameNumber, const uint8_t* bgra, uint32_t rowPitch)
+*	Purpose:		Encodes one frame and writes it to its own file, returns false if the file could not be written
+*					Only touches thread local scratch memory, so workers may call it concurrently
+*
+*/
+bool FrameWriter::write(uint64_t frameNumber, const uint8_t* bgra, uint32_t rowPitch) const {
+
+	std::ofstream file(fileName(frameNumber), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file) {
+
+		return false;
+
+	}
+
+	if (format == FRAME_FORMAT_RAW) {
+
+		for (uint32_t y = 0; y < height; y++) {
+
+			file.write(reinterpret_cast< const char* >(bgra + static_cast< size_t >(y) * rowPitch), static_cast< std::streamsize >(width) * 4);
+
+		}
+
+	}
+	else {
+
+		// Reused between frames, one encode allocates several megabytes
+		thread_local std::vector< uint8_t > encoded;
+		encodePng(encoded, bgra, width, height, rowPitch);
+		file.write(reinterpret_cast< const char* >(encoded.data()), static_cast< std::streamsize >(encoded.size()));
+
+	}
+
+	return static_cast< bool >(file);
+
+}
+
+/*
+*	Function:		std::string FrameWriter::fileName(uint64_t frameNumber)
+*	Purpose:		Returns the path of a frame, e.g. "frame_000042.png"
+*
+*/
+std::string FrameWriter::fileName(uint64_t frameNumber) const {
+
+	char name[64];
+	snprintf(name, sizeof(name), "frame_%06llu.%s", static_cast< unsigned long long >(frameNumber), format == FRAME_FORMAT_RAW ? "raw" : "png");
+
+	return directory + name;
+
+}
+
+/*
+*	Function:		void FrameWriter::encodePng(std::vector< uint8_t > &out, const uint8_t* bgra, ...)
+*	Purpose:		Encodes a BGRA8 image as RGBA PNG into out
+*					The zlib stream only uses stored blocks, which keeps encoding memory bound
+*					so the workers keep up with the GPU, at the cost of file size
+*
+*/
+void FrameWriter::encodePng(std::vector< uint8_t > &out, const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t rowPitch) {
+
+	const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	const size_t scanlineSize = 1 + static_cast< size_t >(width) * 4;
+	const size_t rawSize = scanlineSize * height;
+	const size_t maxBlock = 65535;
+	const size_t blockCount = rawSize == 0 ? 1 : (rawSize + maxBlock - 1) / maxBlock;
+
+	out.clear();
+	out.reserve(sizeof(signature) + 25 + 12 + 2 + rawSize + blockCount * 5 + 4 + 12);
+	out.insert(out.end(), signature, signature + sizeof(signature));
+
+	uint8_t header[13];
+	header[0]	= static_cast< uint8_t >(width >> 24);
+	header[1]	= static_cast< uint8_t >(width >> 16);
+	header[2]	= static_cast< uint8_t >(width >> 8);
+	header[3]	= static_cast< uint8_t >(width);
+	header[4]	= static_cast< uint8_t >(height >> 24);
+	header[5]	= static_cast< uint8_t >(height >> 16);
+	header[6]	= static_cast< uint8_t >(height >> 8);
+	header[7]	= static_cast< uint8_t >(height);
+	header[8]	= 8;		// Bit depth
+	header[9]	= 6;		// Color type RGBA
+	header[10]	= 0;		// Deflate
+	header[11]	= 0;		// Adaptive filtering, every scanline uses filter type None
+	header[12]	= 0;		// No interlacing
+	putChunk(out, "IHDR", header, sizeof(header));
+
+	// IDAT is assembled in place: length and type first, the length is patched once the data is known
+	size_t chunkStart = out.size();
+	putBigEndian(out, 0);
+	out.insert(out.end(), { 'I', 'D', 'A', 'T' });
+
+	out.push_back(0x78);		// zlib: deflate, 32K window
+	out.push_back(0x01);		// zlib: no dictionary, fastest level, header checksum
+
+	uint32_t adlerA = 1;
+	uint32_t adlerB = 0;
+	size_t blockLeft = 0;
+	size_t written = 0;
+
+	auto put = [&](const uint8_t* data, size_t length) {
+
+		while (length > 0) {
+
+			if (blockLeft == 0) {
+
+				blockLeft = rawSize - written < maxBlock ? rawSize - written : maxBlock;
+				uint16_t stored = static_cast< uint16_t >(blockLeft);
+				out.push_back(written + blockLeft == rawSize ? 1 : 0);
+				out.push_back(static_cast< uint8_t >(stored));
+				out.push_back(static_cast< uint8_t >(stored >> 8));
+				out.push_back(static_cast< uint8_t >(~stored));
+				out.push_back(static_cast< uint8_t >(~stored >> 8));
+
+			}
+
+			size_t take = length < blockLeft ? length : blockLeft;
+			out.insert(out.end(), data, data + take);
+
+			for (size_t i = 0; i < take; i++) {
+
+				adlerA += data[i];
+				adlerB += adlerA;
+				// Reduce lazily, both sums stay far below 2^32 between two reductions
+				if (adlerB >= 65521u * 256u) {
+
+					adlerA %= 65521u;
+					adlerB %= 65521u;
+
+				}
+
+			}
+
+			data		+= take;
+			length		-= take;
+			written		+= take;
+			blockLeft	-= take;
+
+		}
+
+	};
+
+	std::vector< uint8_t > scanline(scanlineSize);
+	scanline[0] = 0;
+	for (uint32_t y = 0; y < height; y++) {
+
+		const uint8_t* row = bgra + static_cast< size_t >(y) * rowPitch;
+		for (uint32_t x = 0; x < width; x++) {
+
+			scanline[1 + x * 4 + 0] = row[x * 4 + 2];
+			scanline[1 + x * 4 + 1] = row[x * 4 + 1];
+			scanline[1 + x * 4 + 2] = row[x * 4 + 0];
+			scanline[1 + x * 4 + 3] = row[x * 4 + 3];
+
+		}
+		put(scanline.data(), scanline.size());
+
+	}
+
+	if (rawSize == 0) {
+
+		// Empty image, a single final stored block without data
+		out.insert(out.end(), { 1, 0x00, 0x00, 0xFF, 0xFF });
+
+	}
+
+	adlerA %= 65521u;
+	adlerB %= 65521u;
+	putBigEndian(out, (adlerB << 16) | adlerA);
+
+	uint32_t dataLength = static_cast< uint32_t >(out.size() - chunkStart - 8);
+	out[chunkStart + 0] = static_cast< uint8_t >(dataLength >> 24);
+	out[chunkStart + 1] = static_cast< uint8_t >(dataLength >> 16);
+	out[chunkStart + 2] = static_cast< uint8_t >(dataLength >> 8);
+	out[chunkStart + 3] = static_cast< uint8_t >(dataLength);
+	putBigEndian(out, crc32(0, out.data() + chunkStart + 4, dataLength + 4));
+
+	putChunk(out, "IEND", nullptr, 0);
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+FrameWriter::~FrameWriter() {
+
+
+
+}
+
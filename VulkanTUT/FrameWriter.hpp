@@ -0,0 +1,33 @@
+/*
+*	File:			FrameWriter.hpp
+*	Purpose:		Contains class FrameWriter
+*
+*/
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#define FRAME_FORMAT_RAW			0			// Tightly packed BGRA8 rows as read back from the GPU
+#define FRAME_FORMAT_PNG			1			// 8 bit RGBA PNG with stored deflate blocks
+
+/*
+*	Class:			FrameWriter
+*	Purpose:		Writes read back BGRA8 frames to disk, write() is called concurrently by encoding workers
+*
+*/
+class FrameWriter
+{
+public:
+	FrameWriter(std::string directory = "", int format = FRAME_FORMAT_PNG, uint32_t width = 0, uint32_t height = 0);
+	bool write(uint64_t frameNumber, const uint8_t* bgra, uint32_t rowPitch) const;
+	std::string fileName(uint64_t frameNumber) const;
+	static void encodePng(std::vector< uint8_t > &out, const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t rowPitch);
+	~FrameWriter();
+private:
+	std::string		directory;
+	int				format;
+	uint32_t		width;
+	uint32_t		height;
+};
+
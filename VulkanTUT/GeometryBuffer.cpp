@@ -0,0 +1,142 @@
+/*
+*	File:			GeometryBuffer.cpp
+*	Purpose:		Contains functions for class GeometryBuffer
+*
+*/
+#include "GeometryBuffer.hpp"
+
+/*
+*	Default constructor
+*
+*
+*/
+GeometryBuffer::GeometryBuffer() :
+	indexType(VK_INDEX_TYPE_UINT32),
+	indexCount(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult GeometryBuffer::create(MemoryAllocator &allocator, StagingBuffer &stagingBuffer, const void* vertices, VkDeviceSize vertexBytes, const void* indices, uint32_t amountOfIndices, VkIndexType indexType)
+*	Purpose:		Creates both device local buffers and uploads the mesh, it can be drawn by submissions
+*					to the consumer queue of stagingBuffer once they acquired the upload
+*
+*/
+VkResult GeometryBuffer::create(MemoryAllocator &allocator, StagingBuffer &stagingBuffer, const void* vertices, VkDeviceSize vertexBytes, const void* indices, uint32_t amountOfIndices, VkIndexType indexType_) {
+
+	indexType	= indexType_;
+	indexCount	= amountOfIndices;
+	VkDeviceSize indexBytes = static_cast< VkDeviceSize >(amountOfIndices) * (indexType == VK_INDEX_TYPE_UINT16 ? 2 : 4);
+
+	VkResult result = vertexBuffer.create(
+
+		allocator,
+		vertexBytes,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+
+	);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	result = indexBuffer.create(
+
+		allocator,
+		indexBytes,
+		VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+
+	);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	result = stagingBuffer.upload(vertexBuffer.handle(), 0, vertices, vertexBytes);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	result = stagingBuffer.upload(indexBuffer.handle(), 0, indices, indexBytes);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	return stagingBuffer.flush();
+
+}
+
+/*
+*	Function:		void GeometryBuffer::bind(VkCommandBuffer commandBuffer, uint32_t binding)
+*	Purpose:		Binds the vertex buffer to binding and the index buffer
+*
+*/
+void GeometryBuffer::bind(VkCommandBuffer commandBuffer, uint32_t binding) const {
+
+	VkBuffer buffer		= vertexBuffer.handle();
+	VkDeviceSize offset	= 0;
+
+	vkCmdBindVertexBuffers(commandBuffer, binding, 1, &buffer, &offset);
+	vkCmdBindIndexBuffer(commandBuffer, indexBuffer.handle(), 0, indexType);
+
+}
+
+/*
+*	Function:		void GeometryBuffer::draw(VkCommandBuffer commandBuffer, uint32_t amountOfInstances, uint32_t firstInstance)
+*	Purpose:		Records an indexed draw of the whole mesh, bind() has to be recorded before
+*
+*/
+void GeometryBuffer::draw(VkCommandBuffer commandBuffer, uint32_t amountOfInstances, uint32_t firstInstance) const {
+
+	vkCmdDrawIndexed(
+
+		commandBuffer,
+		indexCount,
+		amountOfInstances,
+		0,
+		0,
+		firstInstance
+
+	);
+
+}
+
+uint32_t GeometryBuffer::amountOfIndices() const {
+
+	return indexCount;
+
+}
+
+/*
+*	Function:		void GeometryBuffer::destroy()
+*	Purpose:		Destroys both buffers
+*
+*/
+void GeometryBuffer::destroy() {
+
+	vertexBuffer.destroy();
+	indexBuffer.destroy();
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+GeometryBuffer::~GeometryBuffer() {
+
+
+
+}
+
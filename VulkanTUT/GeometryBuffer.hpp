@@ -0,0 +1,58 @@
+/*
+*	File:			GeometryBuffer.hpp
+*	Purpose:		Contains class GeometryBuffer
+*
+*/
+#pragma once
+#include "GpuBuffer.hpp"
+#include "StagingBuffer.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+/*
+*	Class:			GeometryBuffer
+*	Purpose:		Device local vertex and index buffer of one mesh, uploaded once through a staging buffer
+*
+*/
+class GeometryBuffer
+{
+public:
+	GeometryBuffer();
+	VkResult create(MemoryAllocator &allocator, StagingBuffer &stagingBuffer, const void* vertices, VkDeviceSize vertexBytes, const void* indices, uint32_t amountOfIndices, VkIndexType indexType);
+	void bind(VkCommandBuffer commandBuffer, uint32_t binding = 0) const;
+	void draw(VkCommandBuffer commandBuffer, uint32_t amountOfInstances = 1, uint32_t firstInstance = 0) const;
+	uint32_t amountOfIndices(void) const;
+	void destroy(void);
+	~GeometryBuffer();
+
+	/*
+	*	Function:		VkResult GeometryBuffer::create(MemoryAllocator &allocator, StagingBuffer &stagingBuffer, const std::vector< V > &vertices, const std::vector< I > &indices)
+	*	Purpose:		Uploads typed vertices and 16 or 32 bit indices, the index type follows I
+	*
+	*/
+	template< typename V, typename I >
+	VkResult create(MemoryAllocator &allocator, StagingBuffer &stagingBuffer, const std::vector< V > &vertices, const std::vector< I > &indices) {
+
+		static_assert(sizeof(I) == 2 || sizeof(I) == 4, "Indices have to be 16 or 32 bit");
+
+		return create(
+
+			allocator,
+			stagingBuffer,
+			vertices.data(),
+			vertices.size() * sizeof(V),
+			indices.data(),
+			static_cast< uint32_t >(indices.size()),
+			sizeof(I) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32
+
+		);
+
+	}
+private:
+	GpuBuffer				vertexBuffer;
+	GpuBuffer				indexBuffer;
+	VkIndexType				indexType;
+	uint32_t				indexCount;
+};
+
@@ -0,0 +1,116 @@
+/*
+*	File:			GpuBuffer.cpp
+*	Purpose:		Contains functions for class GpuBuffer
+*
+*/
+#include "GpuBuffer.hpp"
+
+/*
+*	Default constructor
+*
+*
+*/
+GpuBuffer::GpuBuffer() :
+	allocator(nullptr),
+	buffer(VK_NULL_HANDLE),
+	allocation(),
+	bufferSize(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult GpuBuffer::create(MemoryAllocator &allocator, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred)
+*	Purpose:		Creates the buffer in the best memory type with the required properties
+*					Host visible buffers are mapped by the allocator, flush() covers non-coherent memory
+*
+*/
+VkResult GpuBuffer::create(MemoryAllocator &allocator_, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) {
+
+	allocator	= &allocator_;
+	bufferSize	= size;
+
+	VkBufferCreateInfo bufferCreateInfo;
+	bufferCreateInfo.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.pNext					= nullptr;
+	bufferCreateInfo.flags					= 0;
+	bufferCreateInfo.size					= size;
+	bufferCreateInfo.usage					= usage;
+	bufferCreateInfo.sharingMode			= VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount	= 0;
+	bufferCreateInfo.pQueueFamilyIndices	= nullptr;
+
+	return allocator->createBuffer(bufferCreateInfo, required, preferred, buffer, allocation);
+
+}
+
+/*
+*	Function:		VkResult GpuBuffer::flush(VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Makes host writes to a mapped range visible to the device, nothing to do for coherent memory
+*
+*/
+VkResult GpuBuffer::flush(VkDeviceSize offset, VkDeviceSize size) {
+
+	return allocator->flush(allocation, offset, size);
+
+}
+
+/*
+*	Function:		VkResult GpuBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Makes device writes to a mapped range visible to the host, nothing to do for coherent memory
+*
+*/
+VkResult GpuBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size) {
+
+	return allocator->invalidate(allocation, offset, size);
+
+}
+
+/*
+*	Function:		void GpuBuffer::destroy()
+*	Purpose:		Destroys the buffer and returns its memory to the allocator
+*
+*/
+void GpuBuffer::destroy() {
+
+	allocator->destroyBuffer(buffer, allocation);
+	buffer = VK_NULL_HANDLE;
+
+}
+
+VkBuffer GpuBuffer::handle() const {
+
+	return buffer;
+
+}
+
+VkDeviceSize GpuBuffer::size() const {
+
+	return bufferSize;
+
+}
+
+void* GpuBuffer::mapped() const {
+
+	return allocation.mapped;
+
+}
+
+bool GpuBuffer::coherent() const {
+
+	return allocator->coherent(allocation);
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+GpuBuffer::~GpuBuffer() {
+
+
+
+}
+
@@ -0,0 +1,35 @@
+/*
+*	File:			GpuBuffer.hpp
+*	Purpose:		Contains class GpuBuffer
+*
+*/
+#pragma once
+#include "MemoryAllocator.hpp"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+/*
+*	Class:			GpuBuffer
+*	Purpose:		VkBuffer sub-allocated from the MemoryAllocator, host visible buffers stay mapped for their lifetime
+*
+*/
+class GpuBuffer
+{
+public:
+	GpuBuffer();
+	VkResult create(MemoryAllocator &allocator, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred = 0);
+	VkResult flush(VkDeviceSize offset, VkDeviceSize size);
+	VkResult invalidate(VkDeviceSize offset, VkDeviceSize size);
+	void destroy(void);
+	VkBuffer handle(void) const;
+	VkDeviceSize size(void) const;
+	void* mapped(void) const;
+	bool coherent(void) const;
+	~GpuBuffer();
+private:
+	MemoryAllocator*		allocator;
+	VkBuffer				buffer;
+	MemoryAllocation		allocation;
+	VkDeviceSize			bufferSize;
+};
+
@@ -0,0 +1,414 @@
+/*
+*	File:			GpuCuller.cpp
+*	Purpose:		Contains functions for class GpuCuller
+*
+*/
+#include "GpuCuller.hpp"
+#include <algorithm>
+
+/*
+*	Default constructor
+*
+*
+*/
+GpuCuller::GpuCuller() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	indirectMode(INDIRECT_MODE_MULTI_DRAW),
+	maxDrawCount(1),
+	descriptorSetLayout(VK_NULL_HANDLE),
+	pipelineLayout(VK_NULL_HANDLE),
+	pipeline(VK_NULL_HANDLE),
+	drawIndexedIndirectCount(nullptr) {
+
+
+
+}
+
+/*
+*	Function:		VkResult GpuCuller::create(VkDevice device, MemoryAllocator &allocator, DescriptorLayoutCache &layoutCache, DescriptorAllocator &descriptorAllocator, VkPipelineCache cache, VkShaderModule cullShader, uint32_t amountOfFrames, uint32_t maxObjects, IndirectMode mode, uint32_t maxDrawIndirectCount, const VkAllocationCallbacks* allocationCallbacks)
+*	Purpose:		Creates the compute pipeline and the indirect buffers of every frame in flight, INDIRECT_MODE_COUNT
+*					needs VK_KHR_draw_indirect_count enabled on the device, both modes need multiDrawIndirect
+*					and drawIndirectFirstInstance, the descriptor sets come from the persistent pools of descriptorAllocator
+*
+*/
+VkResult GpuCuller::create(VkDevice device_, MemoryAllocator &allocator, DescriptorLayoutCache &layoutCache, DescriptorAllocator &descriptorAllocator, VkPipelineCache cache, VkShaderModule cullShader, uint32_t amountOfFrames, uint32_t maxObjects, IndirectMode mode, uint32_t maxDrawIndirectCount, const VkAllocationCallbacks* allocationCallbacks_) {
+
+	device					= device_;
+	allocationCallbacks		= allocationCallbacks_;
+	indirectMode			= mode;
+	maxDrawCount			= std::max(maxDrawIndirectCount, 1u);
+
+	if (indirectMode == INDIRECT_MODE_COUNT) {
+
+		drawIndexedIndirectCount = reinterpret_cast< PFN_vkCmdDrawIndexedIndirectCountKHR >(vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR"));
+		if (drawIndexedIndirectCount == nullptr) {
+
+			return VK_ERROR_EXTENSION_NOT_PRESENT;
+
+		}
+
+	}
+
+	// Instances, commands, count
+	std::vector< VkDescriptorSetLayoutBinding > bindings(3);
+	for (uint32_t i = 0; i < 3; i++) {
+
+		bindings[i].binding					= i;
+		bindings[i].descriptorType			= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount			= 1;
+		bindings[i].stageFlags				= VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[i].pImmutableSamplers		= nullptr;
+
+	}
+
+	VkResult result = layoutCache.get(bindings, descriptorSetLayout);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkPushConstantRange pushConstantRange;
+	pushConstantRange.stageFlags	= VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset		= 0;
+	pushConstantRange.size			= sizeof(CullConstants);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+	pipelineLayoutCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.pNext						= nullptr;
+	pipelineLayoutCreateInfo.flags						= 0;
+	pipelineLayoutCreateInfo.setLayoutCount				= 1;
+	pipelineLayoutCreateInfo.pSetLayouts				= &descriptorSetLayout;
+	pipelineLayoutCreateInfo.pushConstantRangeCount		= 1;
+	pipelineLayoutCreateInfo.pPushConstantRanges		= &pushConstantRange;
+
+	result = vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, allocationCallbacks, &pipelineLayout);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkComputePipelineCreateInfo computePipelineCreateInfo;
+	computePipelineCreateInfo.sType							= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.pNext							= nullptr;
+	computePipelineCreateInfo.flags							= 0;
+	computePipelineCreateInfo.stage.sType					= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	computePipelineCreateInfo.stage.pNext					= nullptr;
+	computePipelineCreateInfo.stage.flags					= 0;
+	computePipelineCreateInfo.stage.stage					= VK_SHADER_STAGE_COMPUTE_BIT;
+	computePipelineCreateInfo.stage.module					= cullShader;
+	computePipelineCreateInfo.stage.pName					= "main";
+	computePipelineCreateInfo.stage.pSpecializationInfo		= nullptr;
+	computePipelineCreateInfo.layout						= pipelineLayout;
+	computePipelineCreateInfo.basePipelineHandle			= VK_NULL_HANDLE;
+	computePipelineCreateInfo.basePipelineIndex				= -1;
+
+	result = vkCreateComputePipelines(device, cache, 1, &computePipelineCreateInfo, allocationCallbacks, &pipeline);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkDeviceSize commandBytes = std::max(maxObjects, 1u) * sizeof(VkDrawIndexedIndirectCommand);
+
+	frames.resize(amountOfFrames);
+	for (Frame &frame : frames) {
+
+		frame.instanceBuffer	= VK_NULL_HANDLE;
+		frame.instanceOffset	= 0;
+		frame.instanceSize		= 0;
+		frame.objectCount		= 0;
+		frame.culled			= false;
+
+		result = frame.commands.create(
+
+			allocator,
+			commandBytes,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+
+		);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+
+		result = frame.count.create(
+
+			allocator,
+			sizeof(uint32_t),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+
+		);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+
+		result = descriptorAllocator.allocate(DESCRIPTOR_PERSISTENT, descriptorSetLayout, frame.descriptorSet);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+
+		VkDescriptorBufferInfo bufferInfos[2];
+		bufferInfos[0].buffer	= frame.commands.handle();
+		bufferInfos[0].offset	= 0;
+		bufferInfos[0].range	= VK_WHOLE_SIZE;
+		bufferInfos[1].buffer	= frame.count.handle();
+		bufferInfos[1].offset	= 0;
+		bufferInfos[1].range	= VK_WHOLE_SIZE;
+
+		VkWriteDescriptorSet write;
+		write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.pNext					= nullptr;
+		write.dstSet				= frame.descriptorSet;
+		write.dstBinding			= 1;
+		write.dstArrayElement		= 0;
+		write.descriptorCount		= 2;
+		write.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pImageInfo			= nullptr;
+		write.pBufferInfo			= bufferInfos;
+		write.pTexelBufferView		= nullptr;
+
+		vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void GpuCuller::setInstances(uint32_t frame, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Points the frame's descriptor set at the instances to cull, the frame must not be in flight
+*					Rewritten only when the range moves, a linear pool usually hands out the same range every frame
+*
+*/
+void GpuCuller::setInstances(uint32_t frame, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size) {
+
+	Frame &target = frames[frame];
+	if (target.instanceBuffer == buffer && target.instanceOffset == offset && target.instanceSize == size) {
+
+		return;
+
+	}
+
+	target.instanceBuffer	= buffer;
+	target.instanceOffset	= offset;
+	target.instanceSize		= size;
+
+	VkDescriptorBufferInfo bufferInfo;
+	bufferInfo.buffer	= buffer;
+	bufferInfo.offset	= offset;
+	bufferInfo.range	= std::max(size, static_cast< VkDeviceSize >(sizeof(float)));
+
+	VkWriteDescriptorSet write;
+	write.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.pNext					= nullptr;
+	write.dstSet				= target.descriptorSet;
+	write.dstBinding			= 0;
+	write.dstArrayElement		= 0;
+	write.descriptorCount		= 1;
+	write.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	write.pImageInfo			= nullptr;
+	write.pBufferInfo			= &bufferInfo;
+	write.pTexelBufferView		= nullptr;
+
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+}
+
+/*
+*	Function:		void GpuCuller::cmdCull(VkCommandBuffer commandBuffer, uint32_t frame, const CullConstants &constants)
+*	Purpose:		Records the culling dispatch outside of a render pass, the compute shader writes the
+*					buffers of indirectBuffer() and countBuffer(), their readers have to wait for it
+*
+*/
+void GpuCuller::cmdCull(VkCommandBuffer commandBuffer, uint32_t frame, const CullConstants &constants) {
+
+	Frame &target = frames[frame];
+	target.objectCount	= constants.objectCount;
+	target.culled		= true;
+
+	vkCmdFillBuffer(commandBuffer, target.count.handle(), 0, sizeof(uint32_t), 0);
+
+	VkMemoryBarrier clearBarrier;
+	clearBarrier.sType				= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	clearBarrier.pNext				= nullptr;
+	clearBarrier.srcAccessMask		= VK_ACCESS_TRANSFER_WRITE_BIT;
+	clearBarrier.dstAccessMask		= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+	vkCmdPipelineBarrier(
+
+		commandBuffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0,
+		1,
+		&clearBarrier,
+		0,
+		nullptr,
+		0,
+		nullptr
+
+	);
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+	vkCmdBindDescriptorSets(
+
+		commandBuffer,
+		VK_PIPELINE_BIND_POINT_COMPUTE,
+		pipelineLayout,
+		0,
+		1,
+		&target.descriptorSet,
+		0,
+		nullptr
+
+	);
+	vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants), &constants);
+	vkCmdDispatch(commandBuffer, (constants.objectCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1);
+
+}
+
+/*
+*	Function:		void GpuCuller::cmdDraw(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t firstObject, uint32_t amountOfObjects)
+*	Purpose:		Records the indirect draws of a range of objects, the mesh has to be bound
+*					In INDIRECT_MODE_COUNT the visible commands are compacted to the front, the range
+*					starting at object 0 draws all of them and every other range records nothing
+*
+*/
+void GpuCuller::cmdDraw(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t firstObject, uint32_t amountOfObjects) const {
+
+	const Frame &target = frames[frame];
+	const uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+	if (indirectMode == INDIRECT_MODE_COUNT) {
+
+		if (firstObject == 0 && target.objectCount > 0) {
+
+			drawIndexedIndirectCount(
+
+				commandBuffer,
+				target.commands.handle(),
+				0,
+				target.count.handle(),
+				0,
+				target.objectCount,
+				stride
+
+			);
+
+		}
+		return;
+
+	}
+
+	// maxDrawIndirectCount may be as low as 65535
+	uint32_t end = firstObject + amountOfObjects;
+	for (uint32_t first = firstObject; first < end; first += maxDrawCount) {
+
+		vkCmdDrawIndexedIndirect(
+
+			commandBuffer,
+			target.commands.handle(),
+			static_cast< VkDeviceSize >(first) * stride,
+			std::min(maxDrawCount, end - first),
+			stride
+
+		);
+
+	}
+
+}
+
+/*
+*	Function:		bool GpuCuller::visibleObjects(uint32_t frame, uint32_t &visible)
+*	Purpose:		Reads the amount of objects that passed the last cull of the frame, call after its fence,
+*					returns false if the frame was not culled since the last read
+*
+*/
+bool GpuCuller::visibleObjects(uint32_t frame, uint32_t &visible) {
+
+	Frame &target = frames[frame];
+	if (!target.culled) {
+
+		return false;
+
+	}
+
+	target.culled = false;
+	if (target.count.invalidate(0, sizeof(uint32_t)) != VK_SUCCESS) {
+
+		return false;
+
+	}
+
+	visible = *static_cast< const uint32_t* >(target.count.mapped());
+	return true;
+
+}
+
+VkBuffer GpuCuller::indirectBuffer(uint32_t frame) const {
+
+	return frames[frame].commands.handle();
+
+}
+
+VkBuffer GpuCuller::countBuffer(uint32_t frame) const {
+
+	return frames[frame].count.handle();
+
+}
+
+IndirectMode GpuCuller::mode() const {
+
+	return indirectMode;
+
+}
+
+/*
+*	Function:		void GpuCuller::destroy()
+*	Purpose:		Destroys the pipeline and the indirect buffers, no frame may be in flight
+*					The descriptor sets and their layout belong to the allocator and the layout cache
+*
+*/
+void GpuCuller::destroy() {
+
+	for (Frame &frame : frames) {
+
+		frame.commands.destroy();
+		frame.count.destroy();
+
+	}
+	frames.clear();
+
+	vkDestroyPipeline(device, pipeline, allocationCallbacks);
+	vkDestroyPipelineLayout(device, pipelineLayout, allocationCallbacks);
+
+	pipeline				= VK_NULL_HANDLE;
+	pipelineLayout			= VK_NULL_HANDLE;
+	descriptorSetLayout		= VK_NULL_HANDLE;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+GpuCuller::~GpuCuller() {
+
+
+
+}
+
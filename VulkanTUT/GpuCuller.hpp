@@ -0,0 +1,88 @@
+/*
+*	File:			GpuCuller.hpp
+*	Purpose:		Contains struct CullConstants and class GpuCuller
+*
+*/
+#pragma once
+#include "GpuBuffer.hpp"
+#include "DescriptorAllocator.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+#define CULL_WORKGROUP_SIZE				64						// local_size_x of cull.comp
+#define CULL_INSTANCE_FLOATS			7						// Floats per instance in the instance buffer, sizeof(InstanceData) / 4
+
+enum IndirectMode {
+
+	INDIRECT_MODE_MULTI_DRAW,									// One command per object, culled objects get instanceCount 0
+	INDIRECT_MODE_COUNT											// Visible commands are compacted, the GPU written count limits the draw
+
+};
+
+/*
+*	Struct:			CullConstants
+*	Purpose:		Push constants of cull.comp
+*
+*/
+struct CullConstants {
+
+	float						planes[4][4];					// (normal x, normal y, 0, distance), dot(normal, center) + distance >= -radius is inside
+	uint32_t					objectCount;
+	uint32_t					indexCount;						// Of the mesh every command draws
+	float						boundingRadius;					// Of the mesh, scaled by every instance
+	uint32_t					compact;						// Set for INDIRECT_MODE_COUNT
+
+};
+
+/*
+*	Class:			GpuCuller
+*	Purpose:		Culls objects against the view frustum in a compute shader that writes one
+*					VkDrawIndexedIndirectCommand per visible object plus the amount of visible objects,
+*					the graphics pass draws them with a few indirect calls whatever the object count
+*
+*/
+class GpuCuller
+{
+public:
+	GpuCuller();
+	VkResult create(VkDevice device, MemoryAllocator &allocator, DescriptorLayoutCache &layoutCache, DescriptorAllocator &descriptorAllocator, VkPipelineCache cache, VkShaderModule cullShader, uint32_t amountOfFrames, uint32_t maxObjects, IndirectMode mode, uint32_t maxDrawIndirectCount, const VkAllocationCallbacks* allocationCallbacks = nullptr);
+	void setInstances(uint32_t frame, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size);
+	void cmdCull(VkCommandBuffer commandBuffer, uint32_t frame, const CullConstants &constants);
+	void cmdDraw(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t firstObject, uint32_t amountOfObjects) const;
+	bool visibleObjects(uint32_t frame, uint32_t &visible);
+	VkBuffer indirectBuffer(uint32_t frame) const;
+	VkBuffer countBuffer(uint32_t frame) const;
+	IndirectMode mode(void) const;
+	void destroy(void);
+	~GpuCuller();
+private:
+	/*
+	*	Struct:			Frame
+	*	Purpose:		Indirect buffers of one frame in flight, rewritten every frame
+	*
+	*/
+	struct Frame {
+
+		GpuBuffer						commands;
+		GpuBuffer						count;					// Host visible, read back once the frame fence signaled
+		VkDescriptorSet					descriptorSet;
+		VkBuffer						instanceBuffer;			// Currently written to the descriptor set
+		VkDeviceSize					instanceOffset;
+		VkDeviceSize					instanceSize;
+		uint32_t						objectCount;			// Of the last cull, 0 once read back
+		bool							culled;
+
+	};
+
+	VkDevice									device;
+	const VkAllocationCallbacks*				allocationCallbacks;
+	IndirectMode								indirectMode;
+	uint32_t									maxDrawCount;		// maxDrawIndirectCount of the device
+	VkDescriptorSetLayout						descriptorSetLayout;	// Owned by the layout cache
+	VkPipelineLayout							pipelineLayout;
+	VkPipeline									pipeline;
+	PFN_vkCmdDrawIndexedIndirectCountKHR		drawIndexedIndirectCount;
+	std::vector< Frame >						frames;
+};
+
@@ -0,0 +1,535 @@
+/*
+*	File:			HostAllocator.cpp
+*	Purpose:		Contains functions for class HostAllocator
+*
+*/
+#include "HostAllocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+thread_local HostAllocator::ThreadCache HostAllocator::threadCache;
+
+/*
+*	Function:		void raiseTo(std::atomic< uint64_t > &peak, uint64_t value)
+*	Purpose:		Lifts peak to value unless another thread already stored a higher one
+*
+*/
+static void raiseTo(std::atomic< uint64_t > &peak, uint64_t value) {
+
+	uint64_t current = peak.load(std::memory_order_relaxed);
+	while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+
+	}
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+HostAllocator::HostAllocator() :
+	pooledBytes(0),
+	allocations(0),
+	largeAllocations(0),
+	totalLiveBytes(0),
+	totalPeakBytes(0) {
+
+	vkCallbacks.pUserData				= this;
+	vkCallbacks.pfnAllocation			= allocationCallback;
+	vkCallbacks.pfnReallocation			= reallocationCallback;
+	vkCallbacks.pfnFree					= freeCallback;
+	vkCallbacks.pfnInternalAllocation	= internalAllocationCallback;
+	vkCallbacks.pfnInternalFree			= internalFreeCallback;
+
+	for (ScopeCounters &counters : scopes) {
+
+		counters.allocations.store(0);
+		counters.frees.store(0);
+		counters.liveBytes.store(0);
+		counters.peakBytes.store(0);
+		counters.internalBytes.store(0);
+
+	}
+
+}
+
+/*
+*	Function:		const VkAllocationCallbacks* HostAllocator::callbacks() const
+*	Purpose:		Returns the callbacks to pass as pAllocator, destroy calls need the same pointer
+*
+*/
+const VkAllocationCallbacks* HostAllocator::callbacks() const {
+
+	return &vkCallbacks;
+
+}
+
+/*
+*	Function:		HostStatistics HostAllocator::statistics() const
+*	Purpose:		Returns the counters of all scopes, threads allocating meanwhile may skew them slightly
+*
+*/
+HostStatistics HostAllocator::statistics() const {
+
+	HostStatistics statistics = {};
+	for (uint32_t i = 0; i < HOST_ALLOCATOR_SCOPES; i++) {
+
+		statistics.scopes[i].allocations	= scopes[i].allocations.load();
+		statistics.scopes[i].frees			= scopes[i].frees.load();
+		statistics.scopes[i].liveBytes		= scopes[i].liveBytes.load();
+		statistics.scopes[i].peakBytes		= scopes[i].peakBytes.load();
+		statistics.scopes[i].internalBytes	= scopes[i].internalBytes.load();
+
+	}
+	statistics.allocations		= allocations.load();
+	statistics.liveBytes		= totalLiveBytes.load();
+	statistics.peakBytes		= totalPeakBytes.load();
+	statistics.largeAllocations	= largeAllocations.load();
+
+	std::lock_guard< std::mutex > lock(mutex);
+	statistics.pooledBytes		= pooledBytes;
+
+	return statistics;
+
+}
+
+/*
+*	Function:		uint64_t HostAllocator::amountOfAllocations() const
+*	Purpose:		Returns the allocations since creation, the difference of two calls counts a frame's allocations
+*
+*/
+uint64_t HostAllocator::amountOfAllocations() const {
+
+	return allocations.load(std::memory_order_relaxed);
+
+}
+
+uint64_t HostAllocator::liveBytes() const {
+
+	return totalLiveBytes.load(std::memory_order_relaxed);
+
+}
+
+/*
+*	Function:		const char* HostAllocator::scopeName(uint32_t scope)
+*	Purpose:		Returns the name of a VkSystemAllocationScope for logging
+*
+*/
+const char* HostAllocator::scopeName(uint32_t scope) {
+
+	static const char* names[HOST_ALLOCATOR_SCOPES] = { "command", "object", "cache", "device", "instance" };
+	return scope < HOST_ALLOCATOR_SCOPES ? names[scope] : "unknown";
+
+}
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::allocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+
+	return static_cast< HostAllocator* >(userData)->allocate(size, alignment, scope);
+
+}
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::reallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+
+	return static_cast< HostAllocator* >(userData)->reallocate(original, size, alignment, scope);
+
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::freeCallback(void* userData, void* memory) {
+
+	static_cast< HostAllocator* >(userData)->release(memory);
+
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+
+	static_cast< HostAllocator* >(userData)->scopes[std::min< uint32_t >(scope, HOST_ALLOCATOR_SCOPES - 1)].internalBytes += size;
+
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::internalFreeCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+
+	static_cast< HostAllocator* >(userData)->scopes[std::min< uint32_t >(scope, HOST_ALLOCATOR_SCOPES - 1)].internalBytes -= size;
+
+}
+
+/*
+*	Function:		void* HostAllocator::allocate(size_t size, size_t alignment, VkSystemAllocationScope scope)
+*	Purpose:		Serves small requests from the thread's cache of the matching size class, requests larger
+*					than the largest class or aligned beyond HOST_ALLOCATOR_HEADER from the system heap
+*
+*/
+void* HostAllocator::allocate(size_t size, size_t alignment, VkSystemAllocationScope scope) {
+
+	if (size == 0) {
+
+		return nullptr;
+
+	}
+
+	uint32_t sizeClass = sizeClassOf(size);
+	char* memory;
+	Header* header;
+	if (sizeClass < HOST_ALLOCATOR_CLASSES && alignment <= HOST_ALLOCATOR_HEADER) {
+
+		char* block = static_cast< char* >(takeBlock(sizeClass));
+		if (block == nullptr) {
+
+			return nullptr;
+
+		}
+		memory			= block + HOST_ALLOCATOR_HEADER;
+		header			= reinterpret_cast< Header* >(block);
+		header->base	= block;
+
+	}
+	else {
+
+		// alignment is a power of two, an offset of at least one header keeps memory aligned
+		size_t offset = std::max< size_t >(HOST_ALLOCATOR_HEADER, alignment);
+		char* base = static_cast< char* >(systemAllocate(offset + size, offset));
+		if (base == nullptr) {
+
+			return nullptr;
+
+		}
+		memory			= base + offset;
+		header			= reinterpret_cast< Header* >(memory - HOST_ALLOCATOR_HEADER);
+		header->base	= base;
+		sizeClass		= HOST_ALLOCATOR_CLASSES;
+		largeAllocations++;
+
+	}
+	header->size		= size;
+	header->sizeClass	= sizeClass;
+	header->scope		= scope;
+
+	track(scope, static_cast< int64_t >(size), true);
+
+	return memory;
+
+}
+
+/*
+*	Function:		void* HostAllocator::reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+*	Purpose:		Resizes an allocation, in place while it stays within its size class, the original is
+*					left untouched if a new allocation fails
+*
+*/
+void* HostAllocator::reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+
+	if (original == nullptr) {
+
+		return allocate(size, alignment, scope);
+
+	}
+	if (size == 0) {
+
+		release(original);
+		return nullptr;
+
+	}
+
+	Header* header = reinterpret_cast< Header* >(static_cast< char* >(original) - HOST_ALLOCATOR_HEADER);
+	if (header->sizeClass < HOST_ALLOCATOR_CLASSES && sizeClassOf(size) == header->sizeClass && alignment <= HOST_ALLOCATOR_HEADER) {
+
+		track(header->scope, -static_cast< int64_t >(header->size), false);
+		track(header->scope, static_cast< int64_t >(size), true);
+		header->size = size;
+		return original;
+
+	}
+
+	void* memory = allocate(size, alignment, scope);
+	if (memory == nullptr) {
+
+		return nullptr;
+
+	}
+	memcpy(memory, original, std::min< size_t >(size, header->size));
+	release(original);
+
+	return memory;
+
+}
+
+/*
+*	Function:		void HostAllocator::release(void* memory)
+*	Purpose:		Returns a block to the thread's cache of its size class or a large allocation to the system heap
+*
+*/
+void HostAllocator::release(void* memory) {
+
+	if (memory == nullptr) {
+
+		return;
+
+	}
+
+	Header* header = reinterpret_cast< Header* >(static_cast< char* >(memory) - HOST_ALLOCATOR_HEADER);
+	track(header->scope, -static_cast< int64_t >(header->size), false);
+
+	if (header->sizeClass < HOST_ALLOCATOR_CLASSES) {
+
+		returnBlock(header->sizeClass, header->base);
+
+	}
+	else {
+
+		systemFree(header->base);
+
+	}
+
+}
+
+/*
+*	Function:		void* HostAllocator::takeBlock(uint32_t sizeClass)
+*	Purpose:		Pops a free block of the size class from the calling thread's cache
+*
+*/
+void* HostAllocator::takeBlock(uint32_t sizeClass) {
+
+	ThreadCache &cache = threadCache;
+	if (cache.owner != this) {
+
+		cache.flush();
+		cache.owner = this;
+
+	}
+
+	std::vector< void* > &blocks = cache.blocks[sizeClass];
+	if (blocks.empty()) {
+
+		refill(blocks, sizeClass);
+		if (blocks.empty()) {
+
+			return nullptr;
+
+		}
+
+	}
+
+	void* block = blocks.back();
+	blocks.pop_back();
+
+	return block;
+
+}
+
+/*
+*	Function:		void HostAllocator::returnBlock(uint32_t sizeClass, void* block)
+*	Purpose:		Pushes a block onto the calling thread's cache, a full cache gives half to the shared list
+*
+*/
+void HostAllocator::returnBlock(uint32_t sizeClass, void* block) {
+
+	ThreadCache &cache = threadCache;
+	if (cache.owner != this) {
+
+		cache.flush();
+		cache.owner = this;
+
+	}
+
+	std::vector< void* > &blocks = cache.blocks[sizeClass];
+	blocks.push_back(block);
+	if (blocks.size() > HOST_ALLOCATOR_CACHE_SIZE) {
+
+		std::lock_guard< std::mutex > lock(mutex);
+		size_t keep = HOST_ALLOCATOR_CACHE_SIZE / 2;
+		freeBlocks[sizeClass].insert(freeBlocks[sizeClass].end(), blocks.begin() + keep, blocks.end());
+		blocks.resize(keep);
+
+	}
+
+}
+
+/*
+*	Function:		void HostAllocator::refill(std::vector< void* > &cache, uint32_t sizeClass)
+*	Purpose:		Moves half a cache worth of blocks from the shared list, which takes a new chunk
+*					from the system heap when it ran empty
+*
+*/
+void HostAllocator::refill(std::vector< void* > &cache, uint32_t sizeClass) {
+
+	// Reserving the whole cache once keeps the cache itself from allocating in steady state
+	cache.reserve(HOST_ALLOCATOR_CACHE_SIZE + 1);
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	std::vector< void* > &shared = freeBlocks[sizeClass];
+	if (shared.empty()) {
+
+		size_t stride		= blockSize(sizeClass);
+		size_t chunkSize	= std::max< size_t >(HOST_ALLOCATOR_CHUNK_SIZE, stride);
+		char* chunk = static_cast< char* >(systemAllocate(chunkSize, HOST_ALLOCATOR_HEADER));
+		if (chunk == nullptr) {
+
+			return;
+
+		}
+		chunks.push_back(chunk);
+		pooledBytes += chunkSize;
+
+		for (size_t offset = 0; offset + stride <= chunkSize; offset += stride) {
+
+			shared.push_back(chunk + offset);
+
+		}
+
+	}
+
+	size_t amount = std::min< size_t >(shared.size(), HOST_ALLOCATOR_CACHE_SIZE / 2);
+	cache.insert(cache.end(), shared.end() - amount, shared.end());
+	shared.resize(shared.size() - amount);
+
+}
+
+/*
+*	Function:		void HostAllocator::track(uint32_t scope, int64_t bytes, bool allocation)
+*	Purpose:		Adds bytes to the live bytes of the scope and the total and counts the allocation or free
+*
+*/
+void HostAllocator::track(uint32_t scope, int64_t bytes, bool allocation) {
+
+	ScopeCounters &counters = scopes[std::min< uint32_t >(scope, HOST_ALLOCATOR_SCOPES - 1)];
+	if (allocation) {
+
+		counters.allocations.fetch_add(1, std::memory_order_relaxed);
+		allocations.fetch_add(1, std::memory_order_relaxed);
+
+	}
+	else {
+
+		counters.frees.fetch_add(1, std::memory_order_relaxed);
+
+	}
+
+	// Unsigned wrap-around subtracts negative amounts
+	uint64_t delta = static_cast< uint64_t >(bytes);
+	raiseTo(counters.peakBytes, counters.liveBytes.fetch_add(delta, std::memory_order_relaxed) + delta);
+	raiseTo(totalPeakBytes, totalLiveBytes.fetch_add(delta, std::memory_order_relaxed) + delta);
+
+}
+
+/*
+*	Function:		uint32_t HostAllocator::sizeClassOf(size_t size)
+*	Purpose:		Returns the smallest class holding size, HOST_ALLOCATOR_CLASSES if none does
+*
+*/
+uint32_t HostAllocator::sizeClassOf(size_t size) {
+
+	uint32_t sizeClass = 0;
+	while (sizeClass < HOST_ALLOCATOR_CLASSES && (static_cast< size_t >(HOST_ALLOCATOR_MIN_CLASS) << sizeClass) < size) {
+
+		sizeClass++;
+
+	}
+
+	return sizeClass;
+
+}
+
+size_t HostAllocator::blockSize(uint32_t sizeClass) {
+
+	return HOST_ALLOCATOR_HEADER + (static_cast< size_t >(HOST_ALLOCATOR_MIN_CLASS) << sizeClass);
+
+}
+
+/*
+*	Function:		void* HostAllocator::systemAllocate(size_t size, size_t alignment)
+*	Purpose:		Aligned allocation from the system heap, alignment has to be a power of two
+*
+*/
+void* HostAllocator::systemAllocate(size_t size, size_t alignment) {
+
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void* memory = nullptr;
+	if (posix_memalign(&memory, std::max(alignment, sizeof(void*)), size) != 0) {
+
+		return nullptr;
+
+	}
+	return memory;
+#endif
+
+}
+
+void HostAllocator::systemFree(void* memory) {
+
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+
+}
+
+/*
+*	Function:		void HostAllocator::ThreadCache::flush()
+*	Purpose:		Hands every cached block back to the shared lists of the owner
+*
+*/
+void HostAllocator::ThreadCache::flush() {
+
+	if (owner == nullptr) {
+
+		return;
+
+	}
+
+	std::lock_guard< std::mutex > lock(owner->mutex);
+	for (uint32_t i = 0; i < HOST_ALLOCATOR_CLASSES; i++) {
+
+		owner->freeBlocks[i].insert(owner->freeBlocks[i].end(), blocks[i].begin(), blocks[i].end());
+		blocks[i].clear();
+
+	}
+	owner = nullptr;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+HostAllocator::ThreadCache::~ThreadCache() {
+
+	flush();
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+HostAllocator::~HostAllocator() {
+
+	// Blocks cached by this thread point into the chunks, other threads have to be gone by now
+	if (threadCache.owner == this) {
+
+		for (std::vector< void* > &blocks : threadCache.blocks) {
+
+			blocks.clear();
+
+		}
+		threadCache.owner = nullptr;
+
+	}
+
+	for (void* chunk : chunks) {
+
+		systemFree(chunk);
+
+	}
+
+}
+
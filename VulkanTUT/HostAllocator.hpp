@@ -0,0 +1,149 @@
+/*
+*	File:			HostAllocator.hpp
+*	Purpose:		Contains structs HostScopeStatistics and HostStatistics and class HostAllocator
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+#define HOST_ALLOCATOR_MIN_CLASS		32						// Smallest size class, every class doubles it
+#define HOST_ALLOCATOR_CLASSES			8						// 32 B to 4 KiB, larger requests go to the system heap
+#define HOST_ALLOCATOR_HEADER			32						// Bytes in front of every allocation, pooled blocks stay 32 byte aligned
+#define HOST_ALLOCATOR_CHUNK_SIZE		(64 * 1024)				// Bytes a size class takes from the system heap at once
+#define HOST_ALLOCATOR_CACHE_SIZE		64						// Blocks a thread keeps per size class, half of them go back when exceeded
+#define HOST_ALLOCATOR_SCOPES			5						// VK_SYSTEM_ALLOCATION_SCOPE_COMMAND to VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+
+/*
+*	Struct:			HostScopeStatistics
+*	Purpose:		Host memory the driver requested with one VkSystemAllocationScope
+*
+*/
+struct HostScopeStatistics {
+
+	uint64_t			allocations;			// Since creation, a reallocation counts as one
+	uint64_t			frees;
+	uint64_t			liveBytes;				// Requested sizes of the allocations not freed yet
+	uint64_t			peakBytes;
+	uint64_t			internalBytes;			// Allocated by the driver itself and reported through pfnInternalAllocation
+
+};
+
+/*
+*	Struct:			HostStatistics
+*	Purpose:		Snapshot of the host allocator for logging
+*
+*/
+struct HostStatistics {
+
+	HostScopeStatistics	scopes[HOST_ALLOCATOR_SCOPES];
+	uint64_t			allocations;
+	uint64_t			liveBytes;
+	uint64_t			peakBytes;
+	uint64_t			largeAllocations;		// Served by the system heap, too large or too strictly aligned for a size class
+	uint64_t			pooledBytes;			// Taken from the system heap for the size classes, never returned before destruction
+
+};
+
+/*
+*	Class:			HostAllocator
+*	Purpose:		VkAllocationCallbacks serving driver host allocations from size class pools, every
+*					thread keeps a cache of free blocks per class so most calls take no lock, statistics
+*					are kept per VkSystemAllocationScope to tell setup allocations from per-frame ones
+*					Has to outlive every object created with its callbacks and every thread that used them
+*
+*/
+class HostAllocator
+{
+public:
+	HostAllocator();
+	const VkAllocationCallbacks* callbacks(void) const;
+	HostStatistics statistics(void) const;
+	uint64_t amountOfAllocations(void) const;
+	uint64_t liveBytes(void) const;
+	static const char* scopeName(uint32_t scope);
+	~HostAllocator();
+private:
+	HostAllocator(const HostAllocator &) = delete;
+	HostAllocator &operator=(const HostAllocator &) = delete;
+
+	/*
+	*	Struct:			Header
+	*	Purpose:		Stored in the HOST_ALLOCATOR_HEADER bytes in front of every allocation
+	*
+	*/
+	struct Header {
+
+		void*						base;					// What the system heap returned for large allocations
+		uint64_t					size;					// Requested size
+		uint32_t					sizeClass;				// HOST_ALLOCATOR_CLASSES for large allocations
+		uint32_t					scope;
+
+	};
+	static_assert(sizeof(Header) <= HOST_ALLOCATOR_HEADER, "HostAllocator::Header does not fit in front of the allocations");
+
+	/*
+	*	Struct:			ThreadCache
+	*	Purpose:		Free blocks of one thread, handed back to the owner when the thread exits
+	*
+	*/
+	struct ThreadCache {
+
+		HostAllocator*				owner = nullptr;
+		std::vector< void* >		blocks[HOST_ALLOCATOR_CLASSES];
+
+		void flush(void);
+		~ThreadCache();
+
+	};
+
+	/*
+	*	Struct:			ScopeCounters
+	*	Purpose:		Lock-free counters behind HostScopeStatistics
+	*
+	*/
+	struct ScopeCounters {
+
+		std::atomic< uint64_t >		allocations;
+		std::atomic< uint64_t >		frees;
+		std::atomic< uint64_t >		liveBytes;
+		std::atomic< uint64_t >		peakBytes;
+		std::atomic< uint64_t >		internalBytes;
+
+	};
+
+	static VKAPI_ATTR void* VKAPI_CALL allocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+	static VKAPI_ATTR void* VKAPI_CALL reallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+	static VKAPI_ATTR void VKAPI_CALL freeCallback(void* userData, void* memory);
+	static VKAPI_ATTR void VKAPI_CALL internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+	static VKAPI_ATTR void VKAPI_CALL internalFreeCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+	void* allocate(size_t size, size_t alignment, VkSystemAllocationScope scope);
+	void* reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+	void release(void* memory);
+	void* takeBlock(uint32_t sizeClass);
+	void returnBlock(uint32_t sizeClass, void* block);
+	void refill(std::vector< void* > &cache, uint32_t sizeClass);
+	void track(uint32_t scope, int64_t bytes, bool allocation);
+	static uint32_t sizeClassOf(size_t size);
+	static size_t blockSize(uint32_t sizeClass);
+	static void* systemAllocate(size_t size, size_t alignment);
+	static void systemFree(void* memory);
+
+	static thread_local ThreadCache				threadCache;
+
+	VkAllocationCallbacks						vkCallbacks;
+	std::vector< void* >						freeBlocks[HOST_ALLOCATOR_CLASSES];		// Shared by all threads, guarded by mutex
+	std::vector< void* >						chunks;
+	uint64_t									pooledBytes;
+	mutable std::mutex							mutex;
+	ScopeCounters								scopes[HOST_ALLOCATOR_SCOPES];
+	std::atomic< uint64_t >						allocations;
+	std::atomic< uint64_t >						largeAllocations;
+	std::atomic< uint64_t >						totalLiveBytes;
+	std::atomic< uint64_t >						totalPeakBytes;
+};
+
@@ -4,132 +4,656 @@
 *
 */
 #include "Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
 /*
 *	Default constructor
 *
 *
 */
-Logger::Logger(std::string directory_) {
+Logger::Logger(std::string directory_) :
+	binary(false),
+	enqueuePos(0),
+	dequeuePos(0),
+	writtenPos(0),
+	producers(0),
+	running(false),
+	urgent(false) {
 
 	directory = directory_;
 
+	// Lines logged before start() are written directly to these, start() picks the extension of the mode
+	eventLogStreamFileName		= "event.log";
+	errorLogStreamFileName		= "error.log";
+	startStopStreamFileName		= "startup.log";
+
+	// Format id 0 carries the plain text of Logger::log() in binary mode
+	formats.push_back("{}");
+
+	ring = new Record[LOGGER_RING_SIZE];
+	for (uint64_t i = 0; i < LOGGER_RING_SIZE; i++) {
+
+		ring[i].sequence.store(i, std::memory_order_relaxed);
+
+	}
+
 }
 
 /*
-*	Function:		void Logger::start()
-*	Purpose:		Initializes Logger
+*	Function:		void Logger::start(bool binary)
+*	Purpose:		Initializes Logger, opens the log files and starts the writer thread
+*					In binary mode the files are written as .blog, see LogDecoder
 *
 */
-void Logger::start() {
+void Logger::start(bool binary_) {
 
-	eventLogStreamFileName		= "event.log";
-	errorLogStreamFileName		= "error.log";
-	startStopStreamFileName		= "startup.log";
+	if (running.load(std::memory_order_acquire)) {
+
+		return;
+
+	}
+
+	binary = binary_;
+
+	const char* extension = binary ? ".blog" : ".log";
+	std::ios::openmode mode = binary ? std::ios::binary : static_cast< std::ios::openmode >(0);
+
+	eventLogStreamFileName		= std::string("event") + extension;
+	errorLogStreamFileName		= std::string("error") + extension;
+	startStopStreamFileName		= std::string("startup") + extension;
+
+	eventLogStream.open(directory + eventLogStreamFileName, std::ios::out | std::ios::trunc | mode);
+	errorLogStream.open(directory + errorLogStreamFileName, std::ios::out | std::ios::trunc | mode);
+	startStopStream.open(directory + startStopStreamFileName, std::ios::out | std::ios::app | mode);
+
+	if (binary) {
+
+		writeFileHeader(eventLogStream, EVENT_LOG);
+		writeFileHeader(errorLogStream, ERROR_LOG);
+		writeFileHeader(startStopStream, START_STOP_LOG);
+
+	}
+
+	running.store(true, std::memory_order_release);
+	writer = std::thread(&Logger::writerThread, this);
 
 }
 
 /*
-*	Function:		void log()
-*	Purpose:		Writes to selected Log-File
+*	Function:		void Logger::log()
+*	Purpose:		Formats a line and hands it to the writer thread
+*					Lines logged before start() or after stop() are written synchronously
 *
 */
-void Logger::log(int logNr, std::string text) {
+void Logger::log(int logNr, const std::string &text) {
 
-	static int countEvent = 0;
-	static int countError = 0;
-	std::ofstream stream;
+	if (binary) {
 
-	switch (logNr) {
-	case EVENT_LOG:
-		if (countEvent == 0) {
+		logFormat(logNr, 0, "{}", text);
+		return;
+
+	}
+
+	submit(logNr, text.data(), text.size(), nullptr);
+
+}
+
+/*
+*	Function:		void Logger::flush()
+*	Purpose:		Blocks until every line logged so far is on disk,
+*					but never longer than LOGGER_FLUSH_TIMEOUT_MS
+*
+*/
+void Logger::flush() {
+
+	if (!running.load(std::memory_order_acquire)) {
+
+		std::lock_guard< std::mutex > lock(directMutex);
+		flushStreams();
+		return;
+
+	}
+
+	uint64_t target = enqueuePos.load(std::memory_order_acquire);
+
+	std::unique_lock< std::mutex > lock(wakeMutex);
+	urgent.store(true, std::memory_order_release);
+	wakeCondition.notify_one();
+	flushedCondition.wait_for(
+
+		lock,
+		std::chrono::milliseconds(LOGGER_FLUSH_TIMEOUT_MS),
+		[&]() { return writtenPos.load(std::memory_order_acquire) >= target; }
+
+	);
+
+}
+
+/*
+*	Function:		void Logger::stop()
+*	Purpose:		Drains the ring buffer, joins the writer thread and closes the log files
+*
+*/
+void Logger::stop() {
+
+	{
+
+		std::lock_guard< std::mutex > lock(wakeMutex);
+		if (!running.exchange(false)) {
+
+			return;
 
-			stream.open(directory + eventLogStreamFileName, std::ios::trunc);
-			countEvent++;
-		
 		}
-		else {
 
-			stream.open(directory + eventLogStreamFileName, std::ios::app);
-		
+	}
+
+	// Direct writes must not interleave with the final drain
+	std::lock_guard< std::mutex > lock(directMutex);
+	wakeCondition.notify_one();
+	writer.join();
+
+	eventLogStream.close();
+	errorLogStream.close();
+	startStopStream.close();
+
+}
+
+/*
+*	Function:		uint16_t Logger::addFormat(const char* format)
+*	Purpose:		Registers a format string and returns its id
+*
+*/
+uint16_t Logger::addFormat(const char* format) {
+
+	std::lock_guard< std::mutex > lock(formatMutex);
+
+	for (size_t i = 0; i < formats.size(); i++) {
+
+		if (formats[i] == format) {
+
+			return static_cast< uint16_t >(i);
+
 		}
-		break;
-	case ERROR_LOG:
-		if (countError == 0) {
 
-			stream.open(directory + errorLogStreamFileName, std::ios::trunc);
-			countError++;
-		
+	}
+
+	if (formats.size() >= BLOG_MAX_FORMATS) {
+
+		return 0;
+
+	}
+
+	formats.push_back(format);
+	return static_cast< uint16_t >(formats.size() - 1);
+
+}
+
+/*
+*	Function:		void Logger::logEncoded(int logNr, uint16_t formatId, const char* format, ...)
+*	Purpose:		Stores the encoded arguments as binary record or expands them into a text line
+*
+*/
+void Logger::logEncoded(int logNr, uint16_t formatId, const char* format, const uint8_t* payload, uint32_t payloadSize, uint8_t argCount) {
+
+	if (binary) {
+
+		BinaryLogRecordHeader header;
+		header.kind				= BLOG_RECORD_ENTRY;
+		header.argCount			= argCount;
+		header.formatId			= formatId;
+		header.payloadSize		= static_cast< uint16_t >(payloadSize);
+		header.timestamp		= binlog::monotonicNanoseconds();
+
+		submit(logNr, reinterpret_cast< const char* >(payload), payloadSize, &header);
+		return;
+
+	}
+
+	char text[LOGGER_RECORD_SIZE];
+	uint32_t length = binlog::expand(text, sizeof(text), format, payload, payloadSize, argCount);
+	submit(logNr, text, length, nullptr);
+
+}
+
+/*
+*	Function:		void Logger::submit(int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header)
+*	Purpose:		Hands a text line (header == nullptr) or a binary record to the writer thread
+*
+*/
+void Logger::submit(int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header) {
+
+	if (logNr != EVENT_LOG && logNr != ERROR_LOG && logNr != START_STOP_LOG) {
+
+		return;
+
+	}
+
+	// Sequentially consistent with stop(), the final drain waits for this producer or it sees running cleared
+	producers.fetch_add(1);
+	uint64_t pos	= 0;
+	Record* record	= running.load() ? reserve(pos) : nullptr;
+
+	if (record == nullptr) {
+
+		producers.fetch_sub(1, std::memory_order_release);
+		std::lock_guard< std::mutex > lock(directMutex);
+
+		Record direct;
+		fill(direct, logNr, data, length, header);
+		writeRecord(direct);
+		flushStreams();
+		return;
+
+	}
+
+	fill(*record, logNr, data, length, header);
+	publish(record, pos);
+	producers.fetch_sub(1, std::memory_order_release);
+
+	if (logNr == ERROR_LOG) {
+
+		flush();
+
+	}
+
+}
+
+/*
+*	Function:		Logger::Record* Logger::reserve(uint64_t &pos)
+*	Purpose:		Reserves a slot in the MPSC ring buffer,
+*					returns nullptr if the ring is full and the writer is gone
+*
+*/
+Logger::Record* Logger::reserve(uint64_t &pos) {
+
+	pos = enqueuePos.load(std::memory_order_relaxed);
+
+	for (;;) {
+
+		Record* record = &ring[pos & (LOGGER_RING_SIZE - 1)];
+		uint64_t sequence = record->sequence.load(std::memory_order_acquire);
+		int64_t diff = static_cast< int64_t >(sequence) - static_cast< int64_t >(pos);
+
+		if (diff == 0) {
+
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+
+				return record;
+
+			}
+
+		}
+		else if (diff < 0) {
+
+			// Ring is full, let the writer catch up
+			if (!running.load(std::memory_order_acquire)) {
+
+				return nullptr;
+
+			}
+			urgent.store(true, std::memory_order_release);
+			wakeCondition.notify_one();
+			std::this_thread::yield();
+			pos = enqueuePos.load(std::memory_order_relaxed);
+
 		}
 		else {
-		
-			stream.open(directory + errorLogStreamFileName, std::ios::app);
-		
+
+			pos = enqueuePos.load(std::memory_order_relaxed);
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		void Logger::publish(Record* record, uint64_t pos)
+*	Purpose:		Makes a filled slot visible to the writer thread
+*
+*/
+void Logger::publish(Record* record, uint64_t pos) {
+
+	record->sequence.store(pos + 1, std::memory_order_release);
+
+}
+
+/*
+*	Function:		void Logger::fill(Record &record, int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header)
+*	Purpose:		Formats a text line or copies a binary record into a slot
+*
+*/
+void Logger::fill(Record &record, int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header) {
+
+	record.logNr = logNr;
+
+	if (header == nullptr) {
+
+		record.length = format(record.text, LOGGER_RECORD_SIZE, data, length);
+		return;
+
+	}
+
+	memcpy(record.text, header, sizeof(*header));
+	memcpy(record.text + sizeof(*header), data, header->payloadSize);
+	record.length = static_cast< uint32_t >(sizeof(*header) + header->payloadSize);
+
+}
+
+/*
+*	Function:		Logger::Record* Logger::peek()
+*	Purpose:		Returns the next published record or nullptr, only called by the writer thread
+*
+*/
+Logger::Record* Logger::peek() {
+
+	Record* record = &ring[dequeuePos & (LOGGER_RING_SIZE - 1)];
+	if (record->sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+
+		return nullptr;
+
+	}
+
+	return record;
+
+}
+
+/*
+*	Function:		void Logger::release(Record* record)
+*	Purpose:		Hands a consumed slot back to the producers
+*
+*/
+void Logger::release(Record* record) {
+
+	record->sequence.store(dequeuePos + LOGGER_RING_SIZE, std::memory_order_release);
+	dequeuePos++;
+
+}
+
+/*
+*	Function:		void Logger::writerThread()
+*	Purpose:		Background thread batching the ring buffer contents to the log files
+*
+*/
+void Logger::writerThread() {
+
+	while (running.load(std::memory_order_acquire)) {
+
+		{
+
+			std::unique_lock< std::mutex > lock(wakeMutex);
+			wakeCondition.wait_for(
+
+				lock,
+				std::chrono::milliseconds(LOGGER_FLUSH_INTERVAL_MS),
+				[this]() { return urgent.load(std::memory_order_acquire) || !running.load(std::memory_order_acquire); }
+
+			);
+
 		}
+
+		drain();
+
+	}
+
+	// A producer that saw running before stop() cleared it still publishes, the final drain has to see its slot
+	while (producers.load() != 0) {
+
+		std::this_thread::yield();
+
+	}
+	drain();
+
+}
+
+/*
+*	Function:		void Logger::drain()
+*	Purpose:		Writes every published record and flushes the files once per batch
+*
+*/
+void Logger::drain() {
+
+	bool written = false;
+	Record* record;
+
+	while ((record = peek()) != nullptr) {
+
+		writeRecord(*record);
+		release(record);
+		written = true;
+
+	}
+
+	if (urgent.exchange(false, std::memory_order_acq_rel) || written) {
+
+		flushStreams();
+
+	}
+
+	{
+
+		std::lock_guard< std::mutex > lock(wakeMutex);
+		writtenPos.store(dequeuePos, std::memory_order_release);
+
+	}
+	flushedCondition.notify_all();
+
+}
+
+/*
+*	Function:		void Logger::writeRecord(const Record &record)
+*	Purpose:		Writes one preformatted line or binary record to the selected Log-File
+*
+*/
+void Logger::writeRecord(const Record &record) {
+
+	std::ofstream* stream;
+	const std::string* fileName;
+
+	switch (record.logNr) {
+	case EVENT_LOG:
+		stream		= &eventLogStream;
+		fileName	= &eventLogStreamFileName;
+		break;
+	case ERROR_LOG:
+		stream		= &errorLogStream;
+		fileName	= &errorLogStreamFileName;
 		break;
 	case START_STOP_LOG:
-		stream.open(directory + startStopStreamFileName, std::ios::app);
+		stream		= &startStopStream;
+		fileName	= &startStopStreamFileName;
 		break;
 	default:
-		break;
+		return;
 
 	}
 
-	time_t current_time;
-	struct tm local_time;
+	if (!stream->is_open()) {
 
-	time(&current_time);
-	localtime_s(&local_time, &current_time);
+		stream->open(directory + *fileName, std::ios::out | std::ios::app | (binary ? std::ios::binary : static_cast< std::ios::openmode >(0)));
+		if (binary) {
 
-	int Year	= local_time.tm_year + 1900;
-	int Month	= local_time.tm_mon + 1;
-	int Day		= local_time.tm_mday;
+			writeFileHeader(*stream, record.logNr);
 
-	int Hour	= local_time.tm_hour;
-	int Min		= local_time.tm_min;
-	int Sec		= local_time.tm_sec;
+		}
 
-	if (logNr == ERROR_LOG) {
+	}
 
-		stream << Day << ":"
-			<< Month << ":"
-			<< Year << "   "
-			<< Hour << ":"
-			<< Min << ":"
-			<< Sec << "		===		"
-			<< text << std::endl;
+	if (!binary) {
 
-		std::cerr << Day << ":"
-			<< Month << ":"
-			<< Year << "   "
-			<< Hour << ":"
-			<< Min << ":"
-			<< Sec << "		===		"
-			<< text << std::endl;
+		stream->write(record.text, record.length);
+
+		if (record.logNr == ERROR_LOG) {
+
+			std::cerr.write(record.text, record.length);
+
+		}
+		return;
+
+	}
+
+	BinaryLogRecordHeader header;
+	memcpy(&header, record.text, sizeof(header));
+
+	std::vector< bool > &defined = definedFormats[record.logNr];
+	if (header.formatId >= defined.size() || !defined[header.formatId]) {
+
+		writeFormatDefinition(*stream, record.logNr, header.formatId);
+
+	}
+	stream->write(record.text, record.length);
+
+	if (record.logNr == ERROR_LOG) {
+
+		std::string format;
+		{
+
+			std::lock_guard< std::mutex > lock(formatMutex);
+			format = header.formatId < formats.size() ? formats[header.formatId] : "{}";
+
+		}
+
+		char text[LOGGER_RECORD_SIZE];
+		char line[LOGGER_RECORD_SIZE];
+		uint32_t textLength = binlog::expand(
+
+			text,
+			sizeof(text),
+			format.c_str(),
+			reinterpret_cast< const uint8_t* >(record.text + sizeof(header)),
+			header.payloadSize,
+			header.argCount
+
+		);
+		uint32_t length = Logger::format(line, sizeof(line), text, textLength);
+		std::cerr.write(line, length);
+
+	}
+
+}
+
+/*
+*	Function:		void Logger::writeFileHeader(std::ofstream &stream, int logNr)
+*	Purpose:		Starts a binary logging session, format ids have to be defined again afterwards
+*
+*/
+void Logger::writeFileHeader(std::ofstream &stream, int logNr) {
+
+	BinaryLogFileHeader header;
+	header.magic				= BLOG_MAGIC;
+	header.version				= BLOG_VERSION;
+	header.reserved				= 0;
+	header.wallClockSeconds		= static_cast< int64_t >(time(nullptr));
+	header.monotonicBase		= binlog::monotonicNanoseconds();
+
+	stream.write(reinterpret_cast< const char* >(&header), sizeof(header));
+	definedFormats[logNr].clear();
+
+}
+
+/*
+*	Function:		void Logger::writeFormatDefinition(std::ofstream &stream, int logNr, uint16_t formatId)
+*	Purpose:		Writes the format string of an id before its first use in a binary file
+*
+*/
+void Logger::writeFormatDefinition(std::ofstream &stream, int logNr, uint16_t formatId) {
+
+	std::string format;
+	{
+
+		std::lock_guard< std::mutex > lock(formatMutex);
+		format = formatId < formats.size() ? formats[formatId] : "{}";
 
 	}
-	else {
-	
-		stream << Day << ":"
-			<< Month << ":"
-			<< Year << "   "
-			<< Hour << ":"
-			<< Min << ":"
-			<< Sec << "		===		"
-			<< text << std::endl;
-	
+	if (format.size() > UINT16_MAX) {
+
+		format.resize(UINT16_MAX);
+
+	}
+
+	BinaryLogRecordHeader header;
+	header.kind				= BLOG_RECORD_FORMAT;
+	header.argCount			= 0;
+	header.formatId			= formatId;
+	header.payloadSize		= static_cast< uint16_t >(format.size());
+	header.timestamp		= 0;
+
+	stream.write(reinterpret_cast< const char* >(&header), sizeof(header));
+	stream.write(format.data(), format.size());
+
+	std::vector< bool > &defined = definedFormats[logNr];
+	if (formatId >= defined.size()) {
+
+		defined.resize(formatId + 1, false);
+
 	}
-	stream.close();
+	defined[formatId] = true;
+
+}
+
+/*
+*	Function:		void Logger::flushStreams()
+*	Purpose:		Pushes the buffered lines of all Log-Files to disk
+*
+*/
+void Logger::flushStreams() {
+
+	eventLogStream.flush();
+	errorLogStream.flush();
+	startStopStream.flush();
+	std::cerr.flush();
+
+}
+
+/*
+*	Function:		uint32_t Logger::format(char* out, uint32_t capacity, const char* text, size_t length)
+*	Purpose:		Writes "D:M:Y   H:M:S		===		text" plus newline to out,
+*					the date prefix is only reformatted once per second and thread
+*
+*/
+uint32_t Logger::format(char* out, uint32_t capacity, const char* text, size_t length) {
+
+	thread_local time_t cachedSecond		= 0;
+	thread_local char cachedPrefix[64];
+	thread_local uint32_t cachedLength		= 0;
+
+	time_t current_time;
+	time(&current_time);
+
+	if (current_time != cachedSecond || cachedLength == 0) {
+
+		cachedLength = binlog::formatPrefix(cachedPrefix, sizeof(cachedPrefix), current_time);
+		cachedSecond = current_time;
+
+	}
+
+	uint32_t used = cachedLength < capacity - 1 ? cachedLength : capacity - 1;
+	memcpy(out, cachedPrefix, used);
+
+	size_t textLength = length;
+	if (textLength > capacity - 1 - used) {
+
+		textLength = capacity - 1 - used;
+
+	}
+	memcpy(out + used, text, textLength);
+	used += static_cast< uint32_t >(textLength);
+	out[used++] = '\n';
+
+	return used;
 
 }
 
 /*
 *	Default destructor
-*	
+*
 *
 */
 Logger::~Logger() {
 
-
+	stop();
+	delete[] ring;
 
 }
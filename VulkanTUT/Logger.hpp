@@ -8,21 +8,160 @@
 #include <iostream>
 #include <fstream>
 #include <time.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <vector>
+#include "BinaryLog.hpp"
 
 #define EVENT_LOG 0
 #define ERROR_LOG 1
 #define START_STOP_LOG 2
+
+#define LOGGER_RING_SIZE			4096		// Amount of records in the ring buffer, must be a power of two
+#define LOGGER_RECORD_SIZE			256			// Maximum length of one preformatted line, longer lines get truncated
+#define LOGGER_FLUSH_INTERVAL_MS	10			// Upper bound for the time a record stays unwritten
+#define LOGGER_FLUSH_TIMEOUT_MS		1000		// Upper bound for the time flush() blocks the caller
+
+#define LOG_LEVEL_EVENT				0
+#define LOG_LEVEL_START_STOP		1
+#define LOG_LEVEL_ERROR				2
+#define LOG_LEVEL_NONE				3
+
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL			LOG_LEVEL_EVENT		// Levels below are compiled out, override per build configuration
+#endif
+
+/*
+*	Makro:			LOGGER_FORMAT(logger, logNr, format, args...)
+*	Purpose:		Logs a "{}" format string, the format is registered once per call site
+*					so binary logs only store its id and the raw arguments
+*
+*/
+#define LOGGER_FORMAT(logger, logNr, ...)\
+	\
+	do {\
+	\
+		static const uint16_t loggerFormatId = (logger).registerFormat(__VA_ARGS__);\
+		(logger).logFormat(logNr, loggerFormatId, __VA_ARGS__);\
+	\
+	} while (0)
+
+#if LOGGER_MIN_LEVEL <= LOG_LEVEL_EVENT
+#define LOG_EVENT(logger, ...)			LOGGER_FORMAT(logger, EVENT_LOG, __VA_ARGS__)
+#else
+#define LOG_EVENT(logger, ...)			((void)0)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOG_LEVEL_START_STOP
+#define LOG_START_STOP(logger, ...)		LOGGER_FORMAT(logger, START_STOP_LOG, __VA_ARGS__)
+#else
+#define LOG_START_STOP(logger, ...)		((void)0)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(logger, ...)			LOGGER_FORMAT(logger, ERROR_LOG, __VA_ARGS__)
+#else
+#define LOG_ERROR(logger, ...)			((void)0)
+#endif
+
 class Logger
 {
 public:
 	Logger(std::string directory = "");
-	void start(void);
-	void log(int logNr, std::string text);
+	void start(bool binary = false);
+	void log(int logNr, const std::string &text);
+	void flush(void);
+	void stop(void);
 	~Logger();
+
+	/*
+	*	Function:		uint16_t Logger::registerFormat(const char* format, ...)
+	*	Purpose:		Returns the id of a format string, the arguments are only there
+	*					so LOGGER_FORMAT can forward its argument list unchanged
+	*
+	*/
+	template< typename... Args >
+	uint16_t registerFormat(const char* format, const Args&...) {
+
+		return addFormat(format);
+
+	}
+
+	/*
+	*	Function:		void Logger::logFormat(int logNr, uint16_t formatId, const char* format, ...)
+	*	Purpose:		Encodes the arguments and logs them as binary record or expanded text line
+	*
+	*/
+	template< typename... Args >
+	void logFormat(int logNr, uint16_t formatId, const char* format, const Args&... args) {
+
+		uint8_t payload[LOGGER_RECORD_SIZE - sizeof(BinaryLogRecordHeader)];
+		binlog::Writer writer(payload, sizeof(payload));
+		binlog::encodeAll(writer, args...);
+
+		logEncoded(logNr, formatId, format, payload, writer.used, writer.count);
+
+	}
 private:
+	/*
+	*	Struct:			Logger::Record
+	*	Purpose:		One slot of the ring buffer, sequence implements the MPSC hand-over
+	*
+	*/
+	struct Record {
+
+		std::atomic< uint64_t >		sequence;
+		int							logNr;
+		uint32_t					length;
+		char						text[LOGGER_RECORD_SIZE];
+
+	};
+
+	uint16_t addFormat(const char* format);
+	void logEncoded(int logNr, uint16_t formatId, const char* format, const uint8_t* payload, uint32_t payloadSize, uint8_t argCount);
+	void submit(int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header);
+	void fill(Record &record, int logNr, const char* data, size_t length, const BinaryLogRecordHeader* header);
+	Record* reserve(uint64_t &pos);
+	void publish(Record* record, uint64_t pos);
+	Record* peek(void);
+	void release(Record* record);
+	void writerThread(void);
+	void drain(void);
+	void writeRecord(const Record &record);
+	void writeFileHeader(std::ofstream &stream, int logNr);
+	void writeFormatDefinition(std::ofstream &stream, int logNr, uint16_t formatId);
+	void flushStreams(void);
+	static uint32_t format(char* out, uint32_t capacity, const char* text, size_t length);
+
 	std::string directory;
 	std::string eventLogStreamFileName;
 	std::string errorLogStreamFileName;
 	std::string startStopStreamFileName;
+
+	std::ofstream eventLogStream;
+	std::ofstream errorLogStream;
+	std::ofstream startStopStream;
+
+	bool						binary;
+	std::vector< std::string >	formats;
+	std::vector< bool >			definedFormats[3];		// Per logNr, format ids already written to the current binary file
+	std::mutex					formatMutex;
+
+	Record*						ring;
+	std::atomic< uint64_t >		enqueuePos;
+	uint64_t					dequeuePos;
+	std::atomic< uint64_t >		writtenPos;
+	std::atomic< uint32_t >		producers;				// Threads between reading running and publishing their slot
+
+	std::thread					writer;
+	std::atomic< bool >			running;
+	std::atomic< bool >			urgent;
+	std::mutex					wakeMutex;
+	std::condition_variable		wakeCondition;
+	std::condition_variable		flushedCondition;
+	std::mutex					directMutex;
 };
 
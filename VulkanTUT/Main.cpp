@@ -1,1474 +1,4125 @@
-/*
-*	Main.cpp: Defines the entry point for the console application.
-*
-*/
-#define VK_USE_PLATFORM_WIN32_KHR
-#include "Logger.hpp"
-#define GLFW_INCLUDE_VULKAN
-#include <GLFW\glfw3.h>
-//#include "vulkan/vulkan.h"
-#include <iostream>
-#include <intrin.h>
-#include <vector>
-#include <thread>
-
-/*
-*	Makro:			ASSERT_VULKAN(val)
-*	Purpose:		Checks for error codes and pauses code execution if necessary
-*
-*/
-#define ASSERT_VULKAN(val)\
-	\
-	if(val != VK_SUCCESS) {\
-	\
-		__debugbreak();\
-	\
-	}
-
-/*
-*	Prototypes
-*
-*/
-namespace game {
-
-	namespace vulkan {
-
-		void init(void);
-		void deviceProperties(VkPhysicalDevice &device);
-		void deviceFeatures(VkPhysicalDevice &device);
-		void deviceMemoryProperties(VkPhysicalDevice &device);
-		void queueFamilyProperties(VkPhysicalDevice &device);
-		void deviceQueueCreateInfos(VkPhysicalDevice &device);
-		void deviceCreateInfo();
-		void device(void);
-		void createQueue(void);
-		void createSurface(void);
-		void surfaceCapabilities(VkPhysicalDevice &device);
-		void swapchainCreate(void);
-		void shutdownVulkan(void);		
-		void drawFrame();
-		void createShaderModule(const std::vector< char >& code, VkShaderModule* shaderModule);
-		std::vector< char > readFile(const std::string &filename);
-
-	}
-
-	namespace glfw {
-
-		void init(void);
-		void gameLoop(void);
-		void shutdownGLFW(void);
-
-	}
-
-}
-
-/*
-*	Namespace:		game
-*	Purpose:		Prevent global naming conflicts
-*
-*/
-namespace game {
-
-	/*
-	*	Global Variables
-	*
-	*/
-	VkResult										result;
-
-	GLFWwindow*										window;
-
-	VkInstance										instance;
-	VkDevice										logicalDevice;
-	VkSurfaceKHR									surface;
-	VkSwapchainKHR									swapchain;
-	VkImageView*									imageViews;
-	VkFramebuffer*									framebuffers;
-	VkCommandPool									commandPool;
-	VkQueue											queue;
-	VkCommandBuffer*								commandBuffers;
-	VkPipelineLayout								pipelineLayout;
-	VkPipeline										pipeline;
-	VkRenderPass									renderPass;
-	VkSemaphore										semaphoreImageAvailable;
-	VkSemaphore										semaphoreRenderingFinished;
-	VkViewport										viewport;
-
-	const unsigned int WINDOW_WIDTH					= 1280;
-	const unsigned int WINDOW_HEIGHT				= 780;
-	const char* TITLE								= "D3PSI's first VULKAN engine";
-	const VkFormat colorAttachmentFormat			= VK_FORMAT_B8G8R8A8_UNORM;		// TODO: Check if valid
-
-
-	/*
-	*	Namespace:		vulkan
-	*	Purpose:		Differentiate between GLFW and VULKAN
-	*
-	*/
-	namespace vulkan {
-
-		/*
-		*	Global Variables in namespace
-		*
-		*/
-		Logger										logger;
-		VkPhysicalDevice*							physicalDevices;
-		VkLayerProperties*							layers;
-		VkExtensionProperties*						extensions;
-
-		uint32_t amountOfImagesInSwapchain			= 0;
-			   
-		VkShaderModule shaderModuleVert;
-		VkShaderModule shaderModuleFrag;
-
-		/*
-		*	Function:		void vulkan::init()
-		*	Purpose:		Initializes the Vulkan API
-		*
-		*/
-		void init() {
-
-			logger.start();
-			logger.log(START_STOP_LOG, "Startup initialized...");
-
-			// Application info
-			VkApplicationInfo appInfo;
-			appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
-			appInfo.pNext = NULL;
-			appInfo.pApplicationName = "VULKAN TUTORIAL";
-			appInfo.applicationVersion = VK_MAKE_VERSION(0, 0, 0);
-			appInfo.pEngineName = "Tutorial Vulkan Engine";
-			appInfo.engineVersion = VK_MAKE_VERSION(0, 0, 0);
-			appInfo.apiVersion = VK_API_VERSION_1_1;
-
-			logger.log(EVENT_LOG, "VkApplicationInfo gathered");
-
-			uint32_t amountOfLayers = 0;
-			vkEnumerateInstanceLayerProperties(&amountOfLayers, NULL);
-			layers = new VkLayerProperties[amountOfLayers];
-			vkEnumerateInstanceLayerProperties(&amountOfLayers, layers);
-
-			std::cout << "Amount of instance layers:	" << amountOfLayers << std::endl;
-			for (unsigned int i = 0; i < amountOfLayers; i++) {
-
-				std::cout << "Name:				" << layers[i].layerName					<< std::endl;
-				std::cout << "Spec-Version:		" << layers[i].specVersion					<< std::endl;
-				std::cout << "Impl-Version:		" << layers[i].implementationVersion		<< std::endl;
-				std::cout << "Description:		" << layers[i].description					<< std::endl;
-				std::cout << "------------------"											<< std::endl;
-
-			}
-
-			uint32_t amountOfExtensions = 0;
-			vkEnumerateInstanceExtensionProperties(
-
-				NULL,
-				&amountOfExtensions,
-				NULL
-
-			);
-			extensions = new VkExtensionProperties[amountOfExtensions];
-			vkEnumerateInstanceExtensionProperties(
-
-				NULL,
-				&amountOfExtensions,
-				extensions
-
-			);
-
-			std::cout << "Amount of extensions:	" << amountOfExtensions << std::endl;
-			for (unsigned int i = 0; i < amountOfExtensions; i++) {
-
-				std::cout << "Name:	"				<< extensions[i].extensionName		<< std::endl;
-				std::cout << "Spec-Version:	"		<< extensions[i].specVersion		<< std::endl;
-				std::cout << "------------------"	<< std::endl;
-
-			}
-
-			const std::vector< const char* > validationLayers = {
-
-				"VK_LAYER_LUNARG_standard_validation"
-
-			};
-
-			uint32_t amountOfGlfwExtensions = 0;
-			auto glfwExtensions = glfwGetRequiredInstanceExtensions(&amountOfGlfwExtensions);
-
-			/*const std::vector< const char* > usedExtensions = {
-
-				"VK_KHR_surface",
-				VK_KHR_SURFACE_EXTENSION_NAME
-
-			};*/
-
-			// Instance info
-			VkInstanceCreateInfo instanceInfo;
-			instanceInfo.sType							= VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
-			instanceInfo.pNext							= NULL;
-			instanceInfo.flags							= 0;
-			instanceInfo.pApplicationInfo				= &appInfo;
-			instanceInfo.enabledLayerCount				= validationLayers.size();
-			instanceInfo.ppEnabledLayerNames			= validationLayers.data();
-			instanceInfo.enabledExtensionCount			= amountOfGlfwExtensions;
-			instanceInfo.ppEnabledExtensionNames		= glfwExtensions;
-
-			logger.log(EVENT_LOG, "VkInstanceCreateInfo gathered");
-
-			// Instance creation
-			result = vkCreateInstance(
-
-				&instanceInfo,	// Pass instance info
-				NULL,			// Pass no allocation callback
-				&instance		// Pass the actual instance
-
-			);
-			ASSERT_VULKAN(result);
-
-			logger.log(EVENT_LOG, "Instance created successfully");
-
-			// Surface creation
-			result = glfwCreateWindowSurface(
-
-				instance,		// Pass instance
-				window,			// Pass the window
-				nullptr,		// We do not want to use our own allocator
-				&surface		// Pass the actual surface itself
-
-			);
-			ASSERT_VULKAN(result);
-
-			// Enumerate GPU's (physically)
-			uint32_t amountOfPhysicalDevices = 0;
-			result = vkEnumeratePhysicalDevices(
-
-				instance,						// Pass the instance
-				&amountOfPhysicalDevices,		// Pass the variable for the amount of GPU's
-				NULL							// Pass no array to store them, so we can just get the number of GPU's
-
-			);
-			ASSERT_VULKAN(result);
-
-			physicalDevices = new VkPhysicalDevice[amountOfPhysicalDevices];
-			result = vkEnumeratePhysicalDevices(
-
-				instance,						// Pass the instance
-				&amountOfPhysicalDevices,		// Pass the amount of GPU's
-				physicalDevices					// Pass the array to store the enumerated GPU's
-
-			);
-			ASSERT_VULKAN(result);
-
-			std::cout << "Number of GPU's:	" << amountOfPhysicalDevices << std::endl;
-			for (unsigned int i = 0; i < amountOfPhysicalDevices; i++) {
-
-				deviceProperties(physicalDevices[i]);
-				deviceFeatures(physicalDevices[i]);
-				deviceMemoryProperties(physicalDevices[i]);
-				queueFamilyProperties(physicalDevices[i]);
-				deviceQueueCreateInfos(physicalDevices[i]);
-				surfaceCapabilities(physicalDevices[i]);
-
-			}
-
-			deviceCreateInfo();
-			swapchainCreate();
-
-		}
-
-		/*
-		*	Function:		void vulkan::deviceProperties(vkPhysicalDevice &device)
-		*	Purpose:		Prints the device information for every GPU
-		*
-		*/
-		void deviceProperties(VkPhysicalDevice &device) {
-
-			// Device properties
-			VkPhysicalDeviceProperties properties;
-			vkGetPhysicalDeviceProperties(device, &properties);
-
-			uint32_t apiVer = properties.apiVersion;
-
-			std::cout << "Name:	" << properties.deviceName << std::endl;
-			std::cout << "API-Version:	" << VK_VERSION_MAJOR(apiVer) <<
-				"." << VK_VERSION_MINOR(apiVer) << "." <<
-				VK_VERSION_PATCH(apiVer) << std::endl;
-			std::cout << "Discrete-Queue-Priorities:	" << properties.limits.discreteQueuePriorities		<< std::endl;
-			std::cout << "Driver-Version:				" << properties.driverVersion						<< std::endl;
-			std::cout << "Vendor-ID:					" << properties.vendorID							<< std::endl;
-			std::cout << "Device-ID:					" << properties.deviceID							<< std::endl;
-			std::cout << "Device-Type:					" << properties.deviceType							<< std::endl;
-			std::cout << "Pipeline-Cache-UUID:			" << properties.pipelineCacheUUID					<< std::endl;
-			std::cout << "------------------------------"													<< std::endl;
-
-		}
-
-		/*
-		*	Function:		void vulkan::deviceFeatures(VkPhysicalDevice &device)
-		*	Purpose:		Prints detailed information about the GPU
-		*
-		*/
-		void deviceFeatures(VkPhysicalDevice &device) {
-
-			// Device features
-			VkPhysicalDeviceFeatures features;
-			vkGetPhysicalDeviceFeatures(device, &features);
-
-			std::cout << "Features:											"															<< std::endl;
-			std::cout << "\tRobust Buffer Access:								" << features.robustBufferAccess							<< std::endl;
-			std::cout << "\tFull Draw Index Uint32:							" << features.fullDrawIndexUint32							<< std::endl;
-			std::cout << "\tImage Cube Array:									" << features.imageCubeArray								<< std::endl;
-			std::cout << "\tIndependent Blend:								" << features.independentBlend								<< std::endl;
-			std::cout << "\tGeometry Shader:									" << features.geometryShader								<< std::endl;
-			std::cout << "\tTesselation Shader:								" << features.tessellationShader							<< std::endl;
-			std::cout << "\tSample Rate Shading:								" << features.sampleRateShading								<< std::endl;
-			std::cout << "\tDual Src Blend:									" << features.dualSrcBlend									<< std::endl;
-			std::cout << "\tLogic Op:											" << features.logicOp										<< std::endl;
-			std::cout << "\tMulti Draw Indirect:								" << features.multiDrawIndirect								<< std::endl;
-			std::cout << "\tDraw Indirect First Instance:						" << features.drawIndirectFirstInstance						<< std::endl;
-			std::cout << "\tDepth Clamp:										" << features.depthClamp									<< std::endl;
-			std::cout << "\tDepth Bias Clamp:									" << features.depthBiasClamp								<< std::endl;
-			std::cout << "\tFill Mode Non Solid:								" << features.fillModeNonSolid								<< std::endl;
-			std::cout << "\tDepth Bounds:										" << features.depthBounds									<< std::endl;
-			std::cout << "\tWide Lines:										" << features.wideLines										<< std::endl;
-			std::cout << "\tLarge Points:										" << features.largePoints									<< std::endl;
-			std::cout << "\tAlpha To One:										" << features.alphaToOne									<< std::endl;
-			std::cout << "\tMulti Viewport:									" << features.multiViewport									<< std::endl;
-			std::cout << "\tSampler Anisotropy:								" << features.samplerAnisotropy								<< std::endl;
-			std::cout << "\tTexture Compression ETC2:							" << features.textureCompressionETC2						<< std::endl;
-			std::cout << "\tTexture Compression ASTC_LDR:						" << features.textureCompressionASTC_LDR					<< std::endl;
-			std::cout << "\tTexture Compression BC:							" << features.textureCompressionBC							<< std::endl;
-			std::cout << "\tOcclusion Query Precise:							" << features.occlusionQueryPrecise							<< std::endl;
-			std::cout << "\tPipeline Statistics Query:						" << features.pipelineStatisticsQuery						<< std::endl;
-			std::cout << "\tVertex Pipeline Stores and Atomics:				" << features.vertexPipelineStoresAndAtomics				<< std::endl;
-			std::cout << "\tFragment Stores and Atomics:						" << features.fragmentStoresAndAtomics						<< std::endl;
-			std::cout << "\tShader Tessellation and Geometry Point Size:		" << features.shaderTessellationAndGeometryPointSize		<< std::endl;
-			std::cout << "\tShader Image Gather Extended:						" << features.shaderImageGatherExtended						<< std::endl;
-			std::cout << "\tShader Storage Image Extended Formats:			" << features.shaderStorageImageExtendedFormats				<< std::endl;
-			std::cout << "\tShader Storage Image Multisample:					" << features.shaderStorageImageMultisample					<< std::endl;
-			std::cout << "\tShader Storage Image Read Without Format:			" << features.shaderStorageImageReadWithoutFormat			<< std::endl;
-			std::cout << "\tShader Storage Image Write Without Format:		" << features.shaderStorageImageWriteWithoutFormat			<< std::endl;
-			std::cout << "\tShader Uniform Buffer Array Dynamic Indexing:		" << features.shaderUniformBufferArrayDynamicIndexing		<< std::endl;
-			std::cout << "\tShader Sampled Image Array Dynamic Indexing:		" << features.shaderSampledImageArrayDynamicIndexing		<< std::endl;
-			std::cout << "\tShader Storage Buffer Array Dynamic Indexing:		" << features.shaderStorageBufferArrayDynamicIndexing		<< std::endl;
-			std::cout << "\tShader Storage Image Array Dynamic Indexing:		" << features.shaderStorageImageArrayDynamicIndexing		<< std::endl;
-			std::cout << "\tShader Clip Distance:								" << features.shaderClipDistance							<< std::endl;
-			std::cout << "\tShader Cull Distance:								" << features.shaderCullDistance							<< std::endl;
-			std::cout << "\tShader Float64:									" << features.shaderFloat64									<< std::endl;
-			std::cout << "\tShader Int64:										" << features.shaderInt64									<< std::endl;
-			std::cout << "\tShader Int16:										" << features.shaderInt16									<< std::endl;
-			std::cout << "\tShader Resource Residency:						" << features.shaderResourceResidency						<< std::endl;
-			std::cout << "\tShader Resource Min Load:							" << features.shaderResourceMinLod							<< std::endl;
-			std::cout << "\tSparse Binding:									" << features.sparseBinding									<< std::endl;
-			std::cout << "\tSparse Residency Buffer:							" << features.sparseResidencyBuffer							<< std::endl;
-			std::cout << "\tSparse Residency Image2D:							" << features.sparseResidencyImage2D						<< std::endl;
-			std::cout << "\tSparse Residency Image3D:							" << features.sparseResidencyImage3D						<< std::endl;
-			std::cout << "\tSparse Residency 2 Samples:						" << features.sparseResidency2Samples						<< std::endl;
-			std::cout << "\tSparse Residency 4 Samples:						" << features.sparseResidency4Samples						<< std::endl;
-			std::cout << "\tSparse Residency 8 Samples:						" << features.sparseResidency8Samples						<< std::endl;
-			std::cout << "\tSparse Residency 16 Samples:						" << features.sparseResidency16Samples						<< std::endl;
-			std::cout << "\tSparse Residency Aliased:							" << features.sparseResidencyAliased						<< std::endl;
-			std::cout << "\tVariable Multisample Rate:						" << features.variableMultisampleRate						<< std::endl;
-			std::cout << "\tInherit Queries:									" << features.inheritedQueries								<< std::endl;
-			std::cout << "--------------------------------------------------"															<< std::endl;
-
-		}
-
-		/*
-		*	Function:		void vulkan::deviceMemoryProperties(VkPhysicalDevice &device)
-		*	Purpose:		Prints the memory properties of the GPU
-		*
-		*/
-		void deviceMemoryProperties(VkPhysicalDevice &device) {
-
-			// Device memory properties
-			VkPhysicalDeviceMemoryProperties memProp;
-			vkGetPhysicalDeviceMemoryProperties(device, &memProp);
-
-			std::cout << "Memory Type Count:	" << memProp.memoryTypeCount << std::endl;
-			std::cout << "Memory HEAP Count:	" << memProp.memoryHeapCount << std::endl;
-
-		}
-
-		/*
-		*	Function:		void vulkan::qeueFamilyProperties(VkPhysicalDevice &device)
-		*	Purpose:		Prints the queue family properties
-		*
-		*/
-		void queueFamilyProperties(VkPhysicalDevice &device) {
-
-			// Queue family properties
-			uint32_t amountOfQueueFamilies = 0;
-			vkGetPhysicalDeviceQueueFamilyProperties(
-
-				device,							// Pass the device / GPU
-				&amountOfQueueFamilies,			// Pass the variable to store amount of queue families
-				NULL							// Pass no array to store them, so we can just get the number of queue families
-
-			);
-			VkQueueFamilyProperties* familyProperties = new VkQueueFamilyProperties[amountOfQueueFamilies];
-			vkGetPhysicalDeviceQueueFamilyProperties(
-
-				device,							// Pass the device / GPU
-				&amountOfQueueFamilies,			// Pass the variable to store amount of queue families
-				familyProperties				// Pass the array to store the enumerated queue families
-			);
-
-			std::cout << "Amount of Queue Families:	" << amountOfQueueFamilies << std::endl;
-
-			for (unsigned int i = 0; i < amountOfQueueFamilies; i++) {
-
-				std::cout << "Queue Family Number:				" << i																			<< std::endl;
-				std::cout << "\tVK_QUEUE_GRAPHICS_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)			<< std::endl;
-				std::cout << "\tVK_QUEUE_COMPUTE_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0)				<< std::endl;
-				std::cout << "\tVK_QUEUE_TRANSFER_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_TRANSFER_BIT) != 0)			<< std::endl;
-				std::cout << "\tVK_QUEUE_SPARSE_BINDING_BIT:	" << ((familyProperties[i].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0)		<< std::endl;
-				std::cout << "\tQueue Count:					" << familyProperties[i].queueCount												<< std::endl;
-				std::cout << "\tTimestamp Valid Bits:			" << familyProperties[i].timestampValidBits										<< std::endl;
-
-				uint32_t width		= familyProperties[i].minImageTransferGranularity.width;
-				uint32_t height		= familyProperties[i].minImageTransferGranularity.height;
-				uint32_t depth		= familyProperties[i].minImageTransferGranularity.depth;
-				std::cout << "Min Image Timestamp Granularity:	" << width << "," << height << "," << depth									<< std::endl;
-
-			}
-
-			delete[] familyProperties;
-
-		}
-
-		/*
-		*	Function:		void vulkan::deviceQueueCreateInfo(VkPhysicalDevice &device)
-		*	Purpose:		Gather information to create logical device
-		*
-		*/
-		// Device queue create info
-		VkDeviceQueueCreateInfo deviceQueueCreateInfo;
-		float queuePriorities[] = { 
-			
-			1.0f,
-			1.0f,
-			1.0f,
-			1.0f
-		
-		};
-		void deviceQueueCreateInfos(VkPhysicalDevice &device) {
-
-			deviceQueueCreateInfo.sType					= VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-			deviceQueueCreateInfo.pNext					= NULL;
-			deviceQueueCreateInfo.flags					= 0;
-			deviceQueueCreateInfo.queueFamilyIndex		= 0;		// TODO: Enumerate best queue family and choose the correct index
-			deviceQueueCreateInfo.queueCount			= 1;		// TODO: Check if amount is valid
-			deviceQueueCreateInfo.pQueuePriorities		= queuePriorities;
-
-		}
-
-		/*
-		*	Function:		void vulkan::deviceCreateInfo(VkPhysicalDevice &device)
-		*	Purpose:		Prints the device creation info
-		*
-		*/
-		
-		// Device create info
-		VkDeviceCreateInfo createInfo;
-		void deviceCreateInfo() {
-
-			// Physical device features
-			VkPhysicalDeviceFeatures usedFeatures = {
-
-
-
-			};
-
-			const std::vector< const char* > deviceExtensions = {
-			
-				VK_KHR_SWAPCHAIN_EXTENSION_NAME
-			
-			};
-
-			createInfo.sType						= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-			createInfo.pNext						= NULL;
-			createInfo.flags						= 0;
-			createInfo.queueCreateInfoCount			= 1;
-			createInfo.pQueueCreateInfos			= &deviceQueueCreateInfo;
-			createInfo.enabledLayerCount			= 0;
-			createInfo.ppEnabledLayerNames			= NULL;
-			createInfo.enabledExtensionCount		= deviceExtensions.size();
-			createInfo.ppEnabledExtensionNames		= deviceExtensions.data();
-			createInfo.pEnabledFeatures				= &usedFeatures;
-			
-			device();
-			
-		}
-
-		/*
-		*	Function:		void vulkan::device()
-		*	Purpose:		Creates the logical device from the physical device
-		*
-		*/
-		void device() {
-
-			// TODO: Pick best device instead of first device
-			result = vkCreateDevice(
-				
-				physicalDevices[0], 
-				&createInfo, 
-				NULL, 
-				&logicalDevice
-			
-			);
-			ASSERT_VULKAN(result);
-
-			logger.log(EVENT_LOG, "Device created successfully");
-
-			createQueue();
-
-		}
-
-		/*
-		*	Function:		void vulkan::createQueue()
-		*	Purpose:		Creates the queue for the logical device
-		*
-		*/
-		void createQueue() {
-
-			vkGetDeviceQueue(
-				
-				logicalDevice, 
-				0, 
-				0, 
-				&queue
-			
-			);
-
-			VkBool32 surfaceSupport = false;
-
-			result = vkGetPhysicalDeviceSurfaceSupportKHR(
-				
-				physicalDevices[0], 
-				0, 
-				surface,
-				&surfaceSupport
-			
-			);
-			ASSERT_VULKAN(result);
-
-			if (!surfaceSupport) {
-			
-				logger.log(ERROR_LOG, "Surface not supported!");
-				__debugbreak();
-
-			}
-
-		}
-
-		
-		/*
-		*	Function:		void vulkan::createSurface()
-		*	Purpose:		Would be used to create surface if we didn't do it with GLFW
-		*
-		*/
-		// Surface create info
-		VkWin32SurfaceCreateInfoKHR surfaceCreateInfo;
-		void createSurface() {
-
-			surfaceCreateInfo.sType			= VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR;
-			surfaceCreateInfo.pNext			= NULL;
-			surfaceCreateInfo.flags			= 0;
-			surfaceCreateInfo.hinstance		= NULL;
-			surfaceCreateInfo.hwnd			= NULL;
-
-			result = vkCreateWin32SurfaceKHR(
-
-				instance,
-				&surfaceCreateInfo,
-				NULL,
-				&surface
-
-			);
-			ASSERT_VULKAN(result);
-
-			logger.log(EVENT_LOG, "Surface created successfully");
-
-		}
-
-		/*
-		*	Function:		void vulkan::surfaceCapabilities()
-		*	Purpose:		Get stats of surface
-		*
-		*/
-		// Surface Capabilities
-		VkSurfaceCapabilitiesKHR surfaceCapabs;
-		void surfaceCapabilities(VkPhysicalDevice &device) {
-		
-			result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
-			
-				device,
-				surface,
-				&surfaceCapabs
-			
-			);
-			ASSERT_VULKAN(result);
-
-			std::cout << "Surface capabilities:	"														<< std::endl;
-			std::cout << "\tminImageCount: "			<< surfaceCapabs.minImageCount					<< std::endl;
-			std::cout << "\tmaxImageCount: "			<< surfaceCapabs.maxImageCount					<< std::endl;
-			std::cout << "\tcurrentExtent: "			<< surfaceCapabs.currentExtent.width			<< " / " 
-														<< surfaceCapabs.currentExtent.height			<< std::endl;
-			std::cout << "\tminImageExtent: "			<< surfaceCapabs.minImageExtent.width			<< " / " 
-														<< surfaceCapabs.minImageExtent.height			<< std::endl;
-			std::cout << "\tmaxImageExtent: "			<< surfaceCapabs.maxImageExtent.width			<< " / " 
-														<< surfaceCapabs.maxImageExtent.height			<< std::endl;
-			std::cout << "\tmaxImageArrayLayers: "		<< surfaceCapabs.maxImageArrayLayers			<< std::endl;
-			std::cout << "\tsupportedTransforms: "		<< surfaceCapabs.supportedTransforms			<< std::endl;
-			std::cout << "\tcurrentTransform: "			<< surfaceCapabs.currentTransform				<< std::endl;
-			std::cout << "\tsupportedCompositeAlpha: "	<< surfaceCapabs.supportedCompositeAlpha		<< std::endl;
-			std::cout << "\tsupportedUsageFlags: "		<< surfaceCapabs.supportedUsageFlags			<< std::endl;
-		
-			uint32_t amountOfFormats = 0;
-			result = vkGetPhysicalDeviceSurfaceFormatsKHR(
-				
-				device,
-				surface,
-				&amountOfFormats,
-				nullptr
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkSurfaceFormatKHR* surfaceFormats = new VkSurfaceFormatKHR[amountOfFormats];
-			result = vkGetPhysicalDeviceSurfaceFormatsKHR(
-			
-				device,
-				surface,
-				&amountOfFormats,
-				surfaceFormats
-						
-			);
-			ASSERT_VULKAN(result);
-
-			std::cout << "-------------------------------" << std::endl;
-			std::cout << "Amount of Formats:	" << amountOfFormats << std::endl;
-			for (unsigned int i = 0; i < amountOfFormats; i++) {
-			
-				std::cout << "Format:	" << surfaceFormats[i].format << std::endl;
-			
-			}
-
-			uint32_t amountOfPresentationModes = 0;
-			vkGetPhysicalDeviceSurfacePresentModesKHR(
-			
-				device,
-				surface,
-				&amountOfPresentationModes,
-				nullptr
-
-			);
-
-			VkPresentModeKHR* presentModes = new VkPresentModeKHR[amountOfPresentationModes];
-			vkGetPhysicalDeviceSurfacePresentModesKHR(
-
-				device,
-				surface,
-				&amountOfPresentationModes,
-				presentModes
-
-			);
-
-			std::cout << "Amount of Presentation Modes:	" << amountOfPresentationModes << std::endl;
-			for (unsigned int i = 0; i < amountOfPresentationModes; i++) {
-			
-				std::cout << "\tSupported Presentation Mode: " << presentModes[i] << std::endl;
-			
-			}
-
-			delete[] surfaceFormats;
-			delete[] presentModes;
-
-		}
-
-		/*
-		*	Function:		void vulkan::swapchain()
-		*	Purpose:		Creates the swapchain
-		*
-		*/
-		// SwapchainCreateInfo
-		VkSwapchainCreateInfoKHR swapchainCreateInfo;
-		void swapchainCreate() {
-		
-			swapchainCreateInfo.sType						= VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-			swapchainCreateInfo.pNext						= nullptr;
-			swapchainCreateInfo.flags						= 0;
-			swapchainCreateInfo.surface						= surface;
-			swapchainCreateInfo.minImageCount				= 3;									// TODO: Check if valid
-			swapchainCreateInfo.imageFormat					= colorAttachmentFormat;				// TODO: Check if valid
-			swapchainCreateInfo.imageColorSpace				= VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;	// TODO: Check if valid
-			swapchainCreateInfo.imageExtent					= VkExtent2D {
-
-																WINDOW_WIDTH, 
-																WINDOW_HEIGHT
-
-															};
-			swapchainCreateInfo.imageArrayLayers			= 1;
-			swapchainCreateInfo.imageUsage					= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-			swapchainCreateInfo.imageSharingMode			= VK_SHARING_MODE_EXCLUSIVE;			// TODO: Check if valid
-			swapchainCreateInfo.queueFamilyIndexCount		= 0;
-			swapchainCreateInfo.pQueueFamilyIndices			= nullptr;
-			swapchainCreateInfo.preTransform				= VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
-			swapchainCreateInfo.compositeAlpha				= VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-			swapchainCreateInfo.presentMode					= VK_PRESENT_MODE_FIFO_KHR;				// TODO: Check if valid, VK_PRESENT_MODE_MAILBOX_KHR?
-			swapchainCreateInfo.clipped						= VK_TRUE;
-			swapchainCreateInfo.oldSwapchain				= VK_NULL_HANDLE;
-		
-			result = vkCreateSwapchainKHR(
-			
-				logicalDevice,
-				&swapchainCreateInfo,
-				nullptr,
-				&swapchain
-			
-			);
-			ASSERT_VULKAN(result);
-
-			vkGetSwapchainImagesKHR(
-			
-				logicalDevice,
-				swapchain,
-				&amountOfImagesInSwapchain,
-				nullptr
-			
-			);
-			VkImage* swapchainImages = new VkImage[amountOfImagesInSwapchain];
-			result = vkGetSwapchainImagesKHR(
-			
-				logicalDevice,
-				swapchain,
-				&amountOfImagesInSwapchain,
-				swapchainImages
-			
-			);
-			ASSERT_VULKAN(result);
-
-			imageViews = new VkImageView[amountOfImagesInSwapchain];
-			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
-
-				// Image view create info
-				VkImageViewCreateInfo imageViewCreateInfo;
-
-				imageViewCreateInfo.sType								= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-				imageViewCreateInfo.pNext								= nullptr;
-				imageViewCreateInfo.flags								= 0;
-				imageViewCreateInfo.image								= swapchainImages[i];
-				imageViewCreateInfo.viewType							= VK_IMAGE_VIEW_TYPE_2D;
-				imageViewCreateInfo.format								= colorAttachmentFormat;			// TODO: Check if valid
-				imageViewCreateInfo.components.r						= VK_COMPONENT_SWIZZLE_IDENTITY;
-				imageViewCreateInfo.components.g						= VK_COMPONENT_SWIZZLE_IDENTITY;
-				imageViewCreateInfo.components.b						= VK_COMPONENT_SWIZZLE_IDENTITY;
-				imageViewCreateInfo.components.a						= VK_COMPONENT_SWIZZLE_IDENTITY;
-				imageViewCreateInfo.subresourceRange.aspectMask			= VK_IMAGE_ASPECT_COLOR_BIT;
-				imageViewCreateInfo.subresourceRange.baseMipLevel		= 0;
-				imageViewCreateInfo.subresourceRange.levelCount			= 1;
-				imageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
-				imageViewCreateInfo.subresourceRange.layerCount			= 1;
-			
-				result = vkCreateImageView(
-				
-					logicalDevice,
-					&imageViewCreateInfo,
-					nullptr,
-					&imageViews[i]
-				
-				);
-				ASSERT_VULKAN(result);
-
-			}
-
-			std::vector< char > shaderCodeVert = readFile("vert.spv");
-			std::vector< char > shaderCodeFrag = readFile("frag.spv");
-
-			createShaderModule(shaderCodeVert, &shaderModuleVert);
-			createShaderModule(shaderCodeFrag, &shaderModuleFrag);
-
-			VkPipelineShaderStageCreateInfo shaderStageCreateInfoVert;
-			shaderStageCreateInfoVert.sType						= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			shaderStageCreateInfoVert.pNext						= nullptr;
-			shaderStageCreateInfoVert.flags						= 0;
-			shaderStageCreateInfoVert.stage						= VK_SHADER_STAGE_VERTEX_BIT;
-			shaderStageCreateInfoVert.module					= shaderModuleVert;
-			shaderStageCreateInfoVert.pName						= "main";
-			shaderStageCreateInfoVert.pSpecializationInfo		= nullptr;
-
-			VkPipelineShaderStageCreateInfo shaderStageCreateInfoFrag;
-			shaderStageCreateInfoFrag.sType						= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			shaderStageCreateInfoFrag.pNext						= nullptr;
-			shaderStageCreateInfoFrag.flags						= 0;
-			shaderStageCreateInfoFrag.stage						= VK_SHADER_STAGE_FRAGMENT_BIT;
-			shaderStageCreateInfoFrag.module					= shaderModuleFrag;
-			shaderStageCreateInfoFrag.pName						= "main";
-			shaderStageCreateInfoFrag.pSpecializationInfo		= nullptr;
-
-			VkPipelineShaderStageCreateInfo shaderStages[] = {
-			
-				shaderStageCreateInfoVert,
-				shaderStageCreateInfoFrag
-			
-			};
-
-			VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo;
-			vertexInputCreateInfo.sType								= VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-			vertexInputCreateInfo.pNext								= nullptr;
-			vertexInputCreateInfo.flags								= 0;
-			vertexInputCreateInfo.vertexBindingDescriptionCount		= 0;
-			vertexInputCreateInfo.pVertexBindingDescriptions		= nullptr;
-			vertexInputCreateInfo.vertexAttributeDescriptionCount	= 0;
-			vertexInputCreateInfo.pVertexAttributeDescriptions		= nullptr;
-
-			VkPipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo;
-			inputAssemblyCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-			inputAssemblyCreateInfo.pNext						= nullptr;
-			inputAssemblyCreateInfo.flags						= 0;
-			inputAssemblyCreateInfo.topology					= VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-			inputAssemblyCreateInfo.primitiveRestartEnable		= VK_FALSE;
-
-			viewport.x				= 0.0f;
-			viewport.y				= 0.0f;
-			viewport.width			= WINDOW_WIDTH;
-			viewport.height			= WINDOW_HEIGHT;
-			viewport.minDepth		= 0.0f;
-			viewport.maxDepth		= 1.0f;
-
-			VkRect2D scissor;
-			scissor.offset = {
-			
-				0,
-				0
-
-			};
-			scissor.extent = {
-			
-				WINDOW_WIDTH,
-				WINDOW_HEIGHT
-			
-			};
-
-			VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
-			viewportStateCreateInfo.sType				= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-			viewportStateCreateInfo.pNext				= nullptr;
-			viewportStateCreateInfo.flags				= 0;
-			viewportStateCreateInfo.viewportCount		= 1;
-			viewportStateCreateInfo.pViewports			= &viewport;
-			viewportStateCreateInfo.scissorCount		= 1;
-			viewportStateCreateInfo.pScissors			= &scissor;
-
-			VkPipelineRasterizationStateCreateInfo rasterizationCreateInfo;
-			rasterizationCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-			rasterizationCreateInfo.pNext						= nullptr;
-			rasterizationCreateInfo.flags						= 0;
-			rasterizationCreateInfo.depthClampEnable			= VK_FALSE;
-			rasterizationCreateInfo.rasterizerDiscardEnable		= VK_TRUE;
-			rasterizationCreateInfo.polygonMode					= VK_POLYGON_MODE_FILL;
-			rasterizationCreateInfo.cullMode					= VK_CULL_MODE_BACK_BIT;
-			rasterizationCreateInfo.frontFace					= VK_FRONT_FACE_CLOCKWISE;
-			rasterizationCreateInfo.depthBiasEnable				= VK_FALSE;
-			rasterizationCreateInfo.depthBiasConstantFactor		= 0.0f;
-			rasterizationCreateInfo.depthBiasClamp				= 0.0f;
-			rasterizationCreateInfo.depthBiasSlopeFactor		= 0.0f;
-			rasterizationCreateInfo.lineWidth					= 1.0f;
-
-			VkPipelineMultisampleStateCreateInfo multisampleCreateInfo;
-			multisampleCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-			multisampleCreateInfo.pNext						= nullptr;
-			multisampleCreateInfo.flags						= 0;
-			multisampleCreateInfo.rasterizationSamples		= VK_SAMPLE_COUNT_1_BIT;
-			multisampleCreateInfo.sampleShadingEnable		= VK_FALSE;
-			multisampleCreateInfo.minSampleShading			= 1.0f;
-			multisampleCreateInfo.pSampleMask				= nullptr;
-			multisampleCreateInfo.alphaToCoverageEnable		= VK_FALSE;
-			multisampleCreateInfo.alphaToOneEnable			= VK_FALSE;
-
-			VkPipelineColorBlendAttachmentState colorBlendAttachment;
-			colorBlendAttachment.blendEnable				= VK_TRUE;
-			colorBlendAttachment.srcColorBlendFactor		= VK_BLEND_FACTOR_SRC_ALPHA;
-			colorBlendAttachment.dstColorBlendFactor		= VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			colorBlendAttachment.colorBlendOp				= VK_BLEND_OP_ADD;
-			colorBlendAttachment.srcAlphaBlendFactor		= VK_BLEND_FACTOR_ONE;
-			colorBlendAttachment.dstAlphaBlendFactor		= VK_BLEND_FACTOR_ZERO;
-			colorBlendAttachment.alphaBlendOp				= VK_BLEND_OP_ADD;
-			colorBlendAttachment.colorWriteMask				= VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-
-			VkPipelineColorBlendStateCreateInfo colorBlendCreateInfo;
-			colorBlendCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-			colorBlendCreateInfo.pNext					= nullptr;
-			colorBlendCreateInfo.flags					= 0;
-			colorBlendCreateInfo.logicOpEnable			= VK_FALSE;
-			colorBlendCreateInfo.logicOp				= VK_LOGIC_OP_NO_OP;
-			colorBlendCreateInfo.attachmentCount		= 1;
-			colorBlendCreateInfo.pAttachments			= &colorBlendAttachment;
-			colorBlendCreateInfo.blendConstants[0]		= 0.0f;
-			colorBlendCreateInfo.blendConstants[1]		= 0.0f;
-			colorBlendCreateInfo.blendConstants[2]		= 0.0f;
-			colorBlendCreateInfo.blendConstants[3]		= 0.0f;
-
-			VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
-			pipelineLayoutCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-			pipelineLayoutCreateInfo.pNext						= nullptr;
-			pipelineLayoutCreateInfo.flags						= 0;
-			pipelineLayoutCreateInfo.setLayoutCount				= 0;
-			pipelineLayoutCreateInfo.pSetLayouts				= nullptr;
-			pipelineLayoutCreateInfo.pushConstantRangeCount		= 0;
-			pipelineLayoutCreateInfo.pPushConstantRanges		= nullptr;
-
-			result = vkCreatePipelineLayout(
-			
-				logicalDevice,
-				&pipelineLayoutCreateInfo,
-				nullptr,
-				&pipelineLayout
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkAttachmentDescription attachmentDescription;
-			attachmentDescription.flags				= 0;
-			attachmentDescription.format			= colorAttachmentFormat;
-			attachmentDescription.samples			= VK_SAMPLE_COUNT_1_BIT;
-			attachmentDescription.loadOp			= VK_ATTACHMENT_LOAD_OP_CLEAR;
-			attachmentDescription.storeOp			= VK_ATTACHMENT_STORE_OP_STORE;
-			attachmentDescription.stencilLoadOp		= VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescription.stencilStoreOp	= VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescription.initialLayout		= VK_IMAGE_LAYOUT_UNDEFINED;
-			attachmentDescription.finalLayout		= VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-			VkAttachmentReference attachmentReference;
-			attachmentReference.attachment		= 0;
-			attachmentReference.layout			= VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-			VkSubpassDescription subpassDescription;
-			subpassDescription.flags						= 0;
-			subpassDescription.pipelineBindPoint			= VK_PIPELINE_BIND_POINT_GRAPHICS;
-			subpassDescription.inputAttachmentCount			= 0;
-			subpassDescription.pInputAttachments			= nullptr;
-			subpassDescription.colorAttachmentCount			= 1;
-			subpassDescription.pColorAttachments			= &attachmentReference;
-			subpassDescription.pResolveAttachments			= nullptr;
-			subpassDescription.pDepthStencilAttachment		= nullptr;
-			subpassDescription.preserveAttachmentCount		= 0;
-			subpassDescription.pPreserveAttachments			= nullptr;
-
-			VkSubpassDependency subpassDependency;
-			subpassDependency.srcSubpass			= VK_SUBPASS_EXTERNAL;
-			subpassDependency.dstSubpass			= 0;
-			subpassDependency.srcStageMask			= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subpassDependency.dstStageMask			= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subpassDependency.srcAccessMask			= 0;
-			subpassDependency.dstAccessMask			= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subpassDependency.dependencyFlags		= 0;
-
-			VkRenderPassCreateInfo renderPassCreateInfo;
-			renderPassCreateInfo.sType					= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-			renderPassCreateInfo.pNext					= nullptr;
-			renderPassCreateInfo.flags					= 0;
-			renderPassCreateInfo.attachmentCount 		= 1;
-			renderPassCreateInfo.pAttachments			= &attachmentDescription;
-			renderPassCreateInfo.subpassCount			= 1;
-			renderPassCreateInfo.pSubpasses				= &subpassDescription;
-			renderPassCreateInfo.dependencyCount		= 0;
-			renderPassCreateInfo.pDependencies			= &subpassDependency;
-
-			result = vkCreateRenderPass(
-			
-				logicalDevice,
-				&renderPassCreateInfo,
-				nullptr,
-				&renderPass
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkGraphicsPipelineCreateInfo pipelineCreateInfo;
-			pipelineCreateInfo.sType					= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-			pipelineCreateInfo.pNext					= nullptr;
-			pipelineCreateInfo.flags					= 0;
-			pipelineCreateInfo.stageCount				= 2;
-			pipelineCreateInfo.pStages					= shaderStages;
-			pipelineCreateInfo.pVertexInputState		= &vertexInputCreateInfo;
-			pipelineCreateInfo.pInputAssemblyState		= &inputAssemblyCreateInfo;
-			pipelineCreateInfo.pTessellationState		= nullptr;
-			pipelineCreateInfo.pViewportState			= &viewportStateCreateInfo;
-			pipelineCreateInfo.pRasterizationState		= &rasterizationCreateInfo;
-			pipelineCreateInfo.pMultisampleState		= &multisampleCreateInfo;
-			pipelineCreateInfo.pDepthStencilState		= nullptr;
-			pipelineCreateInfo.pColorBlendState			= &colorBlendCreateInfo;
-			pipelineCreateInfo.pDynamicState			= nullptr;
-			pipelineCreateInfo.layout					= pipelineLayout;
-			pipelineCreateInfo.renderPass				= renderPass;
-			pipelineCreateInfo.subpass					= 0;
-			pipelineCreateInfo.basePipelineHandle		= VK_NULL_HANDLE;
-			pipelineCreateInfo.basePipelineIndex		= -1;
-
-			result = vkCreateGraphicsPipelines(
-			
-				logicalDevice,
-				VK_NULL_HANDLE,
-				1,
-				&pipelineCreateInfo,
-				nullptr,
-				&pipeline
-
-			);
-			ASSERT_VULKAN(result);
-
-			framebuffers = new VkFramebuffer[amountOfImagesInSwapchain];
-			for (size_t i = 0; i < amountOfImagesInSwapchain; i++) {
-			
-				VkFramebufferCreateInfo frambufferCreateInfo;
-				frambufferCreateInfo.sType				= VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-				frambufferCreateInfo.pNext				= nullptr;
-				frambufferCreateInfo.flags				= 0;
-				frambufferCreateInfo.renderPass			= renderPass;
-				frambufferCreateInfo.attachmentCount	= 1;
-				frambufferCreateInfo.pAttachments		= &(imageViews[i]);
-				frambufferCreateInfo.width				= WINDOW_WIDTH;
-				frambufferCreateInfo.height				= WINDOW_HEIGHT;
-				frambufferCreateInfo.layers				= 1;
-
-				result = vkCreateFramebuffer(
-					
-					logicalDevice, 
-					&frambufferCreateInfo,
-					nullptr, 
-					&(framebuffers[i])
-				
-				);
-				ASSERT_VULKAN(result);
-
-			}
-
-			VkCommandPoolCreateInfo commandPoolCreateInfo;
-			commandPoolCreateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-			commandPoolCreateInfo.pNext					= nullptr;
-			commandPoolCreateInfo.flags					= 0;
-			commandPoolCreateInfo.queueFamilyIndex		= 0;		// TODO: Check if valid
-
-			result = vkCreateCommandPool(
-			
-				logicalDevice,
-				&commandPoolCreateInfo,
-				nullptr,
-				&commandPool
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkCommandBufferAllocateInfo commandBufferAllocateInfo;
-			commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			commandBufferAllocateInfo.pNext					= nullptr;
-			commandBufferAllocateInfo.commandPool			= commandPool;
-			commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-			commandBufferAllocateInfo.commandBufferCount	= amountOfImagesInSwapchain;
-
-			commandBuffers = new VkCommandBuffer[amountOfImagesInSwapchain];
-			result = vkAllocateCommandBuffers(
-				
-				logicalDevice,
-				&commandBufferAllocateInfo,
-				commandBuffers
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkCommandBufferBeginInfo commandBufferBeginInfo;
-			commandBufferBeginInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			commandBufferBeginInfo.pNext				= nullptr;
-			commandBufferBeginInfo.flags				= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-			commandBufferBeginInfo.pInheritanceInfo		= nullptr;
-
-			for (size_t i = 0; i < amountOfImagesInSwapchain; i++) {
-			
-				result = vkBeginCommandBuffer(commandBuffers[i], &commandBufferBeginInfo);
-				ASSERT_VULKAN(result);
-
-				VkRenderPassBeginInfo renderPassBeginInfo;
-				renderPassBeginInfo.sType					= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-				renderPassBeginInfo.pNext					= nullptr;
-				renderPassBeginInfo.renderPass				= renderPass;
-				renderPassBeginInfo.framebuffer				= framebuffers[i];
-				renderPassBeginInfo.renderArea.offset		= { 0, 0 };
-				renderPassBeginInfo.renderArea.extent		= { WINDOW_WIDTH, WINDOW_HEIGHT };
-				VkClearValue clearValue						= { 0.0f, 0.0f, 0.0f, 1.0f };
-				renderPassBeginInfo.clearValueCount			= 1;
-				renderPassBeginInfo.pClearValues			= &clearValue;
-
-				vkCmdBeginRenderPass(
-				
-					commandBuffers[i], 
-					&renderPassBeginInfo,
-					VK_SUBPASS_CONTENTS_INLINE
-				
-				);
-
-				vkCmdBindPipeline(
-					
-					commandBuffers[i],
-					VK_PIPELINE_BIND_POINT_GRAPHICS, 
-					pipeline
-				
-				);
-
-				vkCmdDraw(
-					
-					commandBuffers[i], 
-					3, 
-					1,
-					0, 
-					0
-				
-				);
-
-				vkCmdEndRenderPass(commandBuffers[i]);
-
-				result = vkEndCommandBuffer(commandBuffers[i]);
-				ASSERT_VULKAN(result);
-			
-			}
-
-			VkSemaphoreCreateInfo semaphoreCreateInfo;
-			semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-			semaphoreCreateInfo.pNext = nullptr;
-			semaphoreCreateInfo.flags = 0;
-
-			result = vkCreateSemaphore(
-				
-				logicalDevice, 
-				&semaphoreCreateInfo, 
-				nullptr, 
-				&semaphoreImageAvailable
-			
-			);
-			ASSERT_VULKAN(result);
-			result = vkCreateSemaphore(
-				
-				logicalDevice, 
-				&semaphoreCreateInfo,
-				nullptr, 
-				&semaphoreRenderingFinished
-			
-			);
-			ASSERT_VULKAN(result);
-
-
-			delete[] swapchainImages;
-			delete[] layers;
-			delete[] extensions;
-
-		}
-
-		/*
-		*	Function:		void vulkan::createShaderModule(const std::vector< char >& code, VkShaderModule* shaderModule)
-		*	Purpose:		Creates a shader module
-		*
-		*/
-		void createShaderModule(const std::vector< char >& code, VkShaderModule* shaderModule) {
-
-			VkShaderModuleCreateInfo shaderCreateInfo;
-			shaderCreateInfo.sType			= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			shaderCreateInfo.pNext			= nullptr;
-			shaderCreateInfo.flags			= 0;
-			shaderCreateInfo.codeSize		= code.size();
-			shaderCreateInfo.pCode			= (uint32_t*)code.data();
-
-			result = vkCreateShaderModule(
-			
-				logicalDevice,
-				&shaderCreateInfo,
-				nullptr,
-				shaderModule
-			
-			);
-			ASSERT_VULKAN(result);
-		
-		}
-
-		/*
-		*	Function:		std::vector< char > vulkan::readFile(const std::string &filename)
-		*	Purpose:		Reads files and loads them to HEAP
-		*
-		*/
-		std::vector< char > readFile(const std::string &filename) {
-		
-			std::ifstream file(filename, std::ios::binary | std::ios::ate);
-		
-			if (file) {
-			
-				size_t filesize = static_cast< size_t >(file.tellg());
-				std::vector< char > fileBuffer(filesize);
-				file.seekg(0);
-				file.read(fileBuffer.data(), filesize);
-				file.close();
-				return fileBuffer;
-			
-			}
-			else {
-			
-				logger.log(ERROR_LOG, "Failed to open shader-file at " + filename);
-				throw std::runtime_error("Failed to open shader-file at " + filename);
-			
-			}
-
-		}
-
-		/*
-		*	Function:		void vulkan::shutdownVulkan()
-		*	Purpose:		Handles main shutdown of the VULKAN API
-		*
-		*/
-		void shutdownVulkan() {
-
-			vulkan::logger.log(START_STOP_LOG, "Shutdown initialized...");
-
-			result = vkDeviceWaitIdle(logicalDevice);
-			ASSERT_VULKAN(result);
-
-			vkDestroySemaphore(logicalDevice, semaphoreImageAvailable, nullptr);
-			vkDestroySemaphore(logicalDevice, semaphoreRenderingFinished, nullptr);
-
-			vkFreeCommandBuffers(
-				
-				logicalDevice,
-				commandPool, 
-				amountOfImagesInSwapchain,
-				commandBuffers
-
-			);
-			delete[] commandBuffers;
-
-			vkDestroyCommandPool(
-				
-				logicalDevice,
-				commandPool, 
-				nullptr);
-
-			for (size_t i = 0; i < amountOfImagesInSwapchain; i++) {
-			
-				vkDestroyFramebuffer(
-				
-					logicalDevice,
-					framebuffers[i],
-					nullptr
-				
-				);
-			
-			}
-			delete[] framebuffers;
-
-			vkDestroyPipeline(
-
-				logicalDevice,
-				pipeline,
-				nullptr
-
-			);
-
-			vkDestroyRenderPass(
-			
-				logicalDevice,
-				renderPass,
-				nullptr
-			
-			);
-
-			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
-			
-				vkDestroyImageView(
-				
-					logicalDevice,
-					imageViews[i],
-					nullptr
-				
-				);
-			
-			}
-			delete[] imageViews;
-
-			vkDestroyPipelineLayout(
-			
-				logicalDevice,
-				pipelineLayout,
-				nullptr
-			
-			);
-
-			vkDestroyShaderModule(
-				
-				logicalDevice, 
-				shaderModuleVert,
-				nullptr
-			
-			); 
-
-			vkDestroyShaderModule(
-
-				logicalDevice,
-				shaderModuleFrag,
-				nullptr
-
-			);
-
-			vkDestroySwapchainKHR(
-				
-				logicalDevice, 
-				swapchain, 
-				nullptr
-			
-			);
-			vkDestroyDevice(logicalDevice, NULL);
-			vkDestroySurfaceKHR(
-
-				instance,
-				surface,
-				NULL
-
-			);
-			vkDestroyInstance(instance, NULL);
-			delete[] vulkan::physicalDevices;
-
-		}
-
-		/*
-		*	Function:		vulkan::drawFrame()
-		*	Purpose:		Renders a frame to the screen
-		*
-		*/
-		void drawFrame() {
-		
-			uint32_t imageIndex;
-			vkAcquireNextImageKHR(
-			
-				logicalDevice,
-				swapchain,
-				(size_t)(std::numeric_limits< uint64_t >::max),
-				semaphoreImageAvailable,
-				VK_NULL_HANDLE,
-				&imageIndex
-			
-			);
-
-			VkSubmitInfo submitInfo;
-			submitInfo.sType						= VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.pNext						= nullptr;
-			submitInfo.waitSemaphoreCount			= 1;
-			submitInfo.pWaitSemaphores				= &semaphoreImageAvailable;
-			VkPipelineStageFlags waitStageMask[]	= { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-			submitInfo.pWaitDstStageMask			= waitStageMask;
-			submitInfo.commandBufferCount			= 1;
-			submitInfo.pCommandBuffers				= &(commandBuffers[imageIndex]);
-			submitInfo.signalSemaphoreCount			= 1;
-			submitInfo.pSignalSemaphores			= &semaphoreRenderingFinished;
-
-			result = vkQueueSubmit(
-			
-				queue, 
-				1,
-				&submitInfo, 
-				VK_NULL_HANDLE
-			
-			);
-			ASSERT_VULKAN(result);
-
-			VkPresentInfoKHR presentInfo;
-			presentInfo.sType					= VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-			presentInfo.pNext					= nullptr;
-			presentInfo.waitSemaphoreCount		= 1;
-			presentInfo.pWaitSemaphores			= &semaphoreRenderingFinished;
-			presentInfo.swapchainCount			= 1;
-			presentInfo.pSwapchains				= &swapchain;
-			presentInfo.pImageIndices			= &imageIndex;
-			presentInfo.pResults				= nullptr;
-
-			result = vkQueuePresentKHR(
-			
-				queue,
-				&presentInfo
-			
-			);
-			ASSERT_VULKAN(result);
-
-		}
-
-	}
-
-	/*
-	*	Namespace:		glfw
-	*	Purpose:		Differenciate GLFW from VULKAN
-	*
-	*/
-	namespace glfw {
-
-		/*
-		*	Function:		void glfw::init()
-		*	Purpose:		Handles GLFW-Initialization
-		*
-		*/
-		void init() {
-
-			glfwInit();
-			glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-			glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
-
-			window = glfwCreateWindow(
-				
-				WINDOW_WIDTH,
-				WINDOW_HEIGHT, 
-				TITLE, 
-				nullptr, 
-				nullptr
-			
-			);
-
-		}
-
-		/*
-		*	Function:		void glfw::gameLoop()
-		*	Purpose:		Contains the main game loop
-		*
-		*/
-		void gameLoop() {
-
-			while (!glfwWindowShouldClose(window)) {
-
-				glfwPollEvents();
-				vulkan::drawFrame();
-
-			}
-
-		}
-
-		/*
-		*	Function:		void glfw::shutdownGLFW()
-		*	Purpose:		Handles main shutdown of GLFW
-		*
-		*/
-		void shutdownGLFW() {
-
-			glfwDestroyWindow(window);
-
-		}
-
-	}
-
-}
-
-/*
-*	Function:		int main()
-*	Purpose:		Entry point for the application
-*
-*/
-int main() {
-
-	game::glfw::init();
-	game::vulkan::init();
-	game::glfw::gameLoop();
-	game::vulkan::shutdownVulkan();
-	game::glfw::shutdownGLFW();
-
-	return 0;
-
+/*
+*	Main.cpp: Defines the entry point for the console application.
+*
+*/
+#ifdef _WIN32
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+#include "FrameWriter.hpp"
+#include "Profiler.hpp"
+#include "DeviceSelector.hpp"
+#include "PipelineCache.hpp"
+#include "ShaderLibrary.hpp"
+#include "PipelineBuilder.hpp"
+#include "CommandRecorder.hpp"
+#include "MemoryAllocator.hpp"
+#include "GeometryBuffer.hpp"
+#include "GpuCuller.hpp"
+#include "TaskGraph.hpp"
+#include "HostAllocator.hpp"
+#include "DescriptorAllocator.hpp"
+#include "BindlessSet.hpp"
+#include "UniformRing.hpp"
+#include "RenderGraph.hpp"
+#ifdef SHADERS_EMBEDDED
+#include "EmbeddedShaders.hpp"				// Generated by Shaders.targets
+#endif
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+//#include "vulkan/vulkan.h"
+#include <iostream>
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <csignal>
+#define __debugbreak() raise(SIGTRAP)
+#endif
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <cstring>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cmath>
+
+/*
+*	Makro:			ASSERT_VULKAN(val)
+*	Purpose:		Checks for error codes and pauses code execution if necessary
+*
+*/
+#define ASSERT_VULKAN(val)\
+	\
+	if(val != VK_SUCCESS) {\
+	\
+		__debugbreak();\
+	\
+	}
+
+/*
+*	Prototypes
+*
+*/
+namespace game {
+
+	struct FrameResources;
+
+	namespace vulkan {
+
+		void init(void);
+		void enumerateLayers(void);
+		void printLayers(void);
+		void printExtensions(void);
+		void createInstance(void);
+		void createWindowSurface(void);
+		void selectPhysicalDevice(void);
+		void printPhysicalDevices(void);
+		void deviceProperties(VkPhysicalDevice &device);
+		void deviceFeatures(VkPhysicalDevice &device);
+		void deviceMemoryProperties(VkPhysicalDevice &device);
+		void queueFamilyProperties(VkPhysicalDevice &device);
+		void deviceQueueCreateInfos(VkPhysicalDevice &device);
+		void deviceCreateInfo();
+		void device(void);
+		void createAllocator(void);
+		void createPipelineCache(void);
+		void createQueue(void);
+#ifdef _WIN32
+		void createSurface(void);
+#endif
+		void surfaceCapabilities(VkPhysicalDevice &device);
+		void querySurface(void);
+		void createSwapchain(void);
+		void createRenderPass(void);
+		void createCommandPool(void);
+		VkPresentModeKHR choosePresentMode(void);
+		uint32_t chooseImageCount(VkPresentModeKHR presentMode);
+		VkExtent2D chooseSwapchainExtent(void);
+		VkImage* createSwapchainImages(VkSwapchainKHR oldSwapchain);
+		void createImageViews(const VkImage* images);
+		void createPipelines(void);
+		void createFramebuffers(void);
+		void recreateSwapchain(void);
+		void destroyRetiredSwapchains(bool deviceIdle);
+		VkImage* createOffscreenImages(void);
+		void shutdownVulkan(void);		
+		void createFrameResources(void);
+		void createReadbackBuffers(void);
+		int acquireReadbackBuffer(void);
+		void retireReadbackBuffer(int index);
+		void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, VkBuffer readbackBuffer);
+		void recordCull(const RenderPassContext &context);
+		void recordMain(const RenderPassContext &context);
+		void recordReadback(const RenderPassContext &context);
+		void recordDraws(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t amountOfDraws);
+		void createGeometry(void);
+		void createInstances(void);
+		void createCuller(void);
+		void createDescriptors(void);
+		void createUniforms(void);
+		void updateUniforms(FrameResources &frame);
+		bool deviceExtensionSupported(const char* name);
+		void updateInstances(FrameResources &frame);
+		void drawFrame();
+		void headlessLoop(void);
+		VkShaderModule loadShader(const std::string &filename);
+
+	}
+
+	namespace glfw {
+
+		void init(void);
+		void createWindow(void);
+		void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+		void gameLoop(void);
+		void shutdownGLFW(void);
+
+	}
+
+}
+
+/*
+*	Namespace:		game
+*	Purpose:		Prevent global naming conflicts
+*
+*/
+namespace game {
+
+	/*
+	*	Global Variables
+	*
+	*/
+	thread_local VkResult							result;							// Startup tasks run on several threads
+
+	GLFWwindow*										window;
+
+	VkInstance										instance;
+	VkDevice										logicalDevice;
+	VkSurfaceKHR									surface;
+	VkSwapchainKHR									swapchain;
+	VkImageView*									imageViews;
+	VkFramebuffer*									framebuffers;
+	VkCommandPool									commandPool;
+	VkQueue											queue;							// Graphics and present
+	VkQueue											computeQueue;					// Async compute, the graphics queue if the hardware has no other
+	VkQueue											transferQueue;					// Uploads, may be the compute or graphics queue
+	VkPipelineLayout								pipelineLayout;
+	VkPipeline										pipeline;
+	VkRenderPass									renderPass;
+	VkViewport										viewport;
+	VkExtent2D										swapchainExtent;				// Of the swapchain images, WINDOW_WIDTH x WINDOW_HEIGHT in headless mode
+	bool											framebufferResized = false;		// Set by the GLFW framebuffer size callback, consumed by the next recreation
+
+	const unsigned int WINDOW_WIDTH					= 1280;
+	const unsigned int WINDOW_HEIGHT				= 780;
+	const char* TITLE								= "D3PSI's first VULKAN engine";
+	const VkFormat colorAttachmentFormat			= VK_FORMAT_B8G8R8A8_UNORM;		// TODO: Check if valid
+	const bool BINARY_LOGGING						= false;						// Write .blog files, decode them with LogDecoder
+	const unsigned int MAX_FRAMES_IN_FLIGHT			= 2;							// Frames the CPU may record ahead of the GPU
+	const unsigned int FRAME_STATS_INTERVAL			= 1000;							// Frames between two overlap reports in the event log
+	const unsigned int HEADLESS_IMAGE_COUNT			= MAX_FRAMES_IN_FLIGHT;			// Offscreen color targets replacing the swapchain images
+	const unsigned int READBACK_BUFFER_COUNT		= MAX_FRAMES_IN_FLIGHT + 2;		// Host copies of frames, covers frames in flight plus frames being encoded
+	const char* PROFILE_TRACE_FILE					= "profile_trace.json";			// Chrome trace_event export of the profiler
+	const char* PROFILE_SUMMARY_FILE				= "profile_summary.csv";		// Frame time percentiles of the profiler
+	const char* PIPELINE_CACHE_FILE					= "pipeline.cache";				// VkPipelineCache blob reused between runs
+	const char* DEVICE_CACHE_FILE					= "device.cache";				// Capability snapshot of the selected GPU
+	const VkDeviceSize TRANSIENT_POOL_SIZE			= 4 * 1024 * 1024;				// Per-frame linear pool for data written once and read by one frame
+	const float INSTANCE_SPIN						= 0.01f;						// Radians every instance turns per frame
+	const uint32_t BINDLESS_MAX_BUFFERS				= 1024;							// Storage buffers of the bindless set, fewer if the device limits them
+	const uint32_t BINDLESS_MAX_IMAGES				= 4096;							// Textures of the bindless set, fewer if the device limits them
+	const VkDeviceSize UNIFORM_REGION_SIZE			= 256 * 1024;					// Uniform ring bytes per frame in flight on top of one block per draw
+	const uint32_t FRAGMENT_CONSTANT_GRAYSCALE		= 0;							// constant_id of GRAYSCALE in shader.frag
+	const uint32_t FRAGMENT_CONSTANT_POSTERIZE		= 1;							// constant_id of POSTERIZE_LEVELS in shader.frag
+
+	bool headless									= false;						// Render offscreen without GLFW, surface and swapchain (--headless)
+	unsigned int headlessFrames						= 1000;							// Frames rendered by the headless loop (--frames N)
+	std::string captureDirectory					= "";							// Write every headless frame to this directory (--capture DIR)
+	int captureFormat								= FRAME_FORMAT_PNG;				// --capture-format raw|png
+	bool pipelineVariants							= false;						// Also compile every blend, topology and cull variant (--pipeline-variants)
+	bool grayscale									= false;						// Fragment shader permutation without color (--grayscale)
+	unsigned int posterizeLevels					= 0;							// Color levels per channel of the fragment shader permutation, 0 keeps all (--posterize N)
+	unsigned int drawsPerFrame						= 1;							// Draw calls recorded every frame (--draws N)
+	unsigned int recordThreads						= 0;							// Threads recording draws, 0 uses every core (--record-threads N)
+	unsigned int instancesPerFrame					= 1;							// Instances spread over the draws of a frame (--instances N)
+	bool gpuCulling									= false;						// Cull instances in a compute shader and draw them indirectly (--gpu-culling)
+	bool bindless									= false;						// Read the instances through one bindless descriptor set (--bindless)
+	VkSampleCountFlagBits msaaSamples				= VK_SAMPLE_COUNT_1_BIT;		// Samples per pixel, resolved into the target (--msaa N)
+	bool dynamicViewport							= false;						// Viewport and scissor set per command buffer, resizes keep the pipelines (--dynamic-rendering)
+	bool dynamicRendering							= false;						// vkCmdBeginRenderingKHR instead of render passes and framebuffers where supported (--dynamic-rendering)
+	VkPresentModeKHR presentModePolicy				= VK_PRESENT_MODE_FIFO_KHR;		// --present-mode fifo|relaxed|mailbox|immediate, FIFO if the surface lacks it
+
+	/*
+	*	Struct:			Vertex
+	*	Purpose:		Vertex of the meshes, described to the pipeline by vulkan::vertexFormat
+	*
+	*/
+	struct Vertex {
+
+		float			position[2];
+		float			color[3];
+
+	};
+
+	/*
+	*	Struct:			InstanceData
+	*	Purpose:		Per-instance attributes, described to the pipeline by vulkan::instanceFormat
+	*
+	*/
+	struct InstanceData {
+
+		float			transform[4];			// Offset x, offset y, scale, rotation in radians
+		float			color[3];				// Multiplied with the vertex color
+
+	};
+
+	/*
+	*	Struct:			FrameConstants
+	*	Purpose:		Uniform block of set 0 binding 0, written once per frame into vulkan::uniformRing
+	*
+	*/
+	struct FrameConstants {
+
+		float			cameraOffset[2];		// Subtracted from every position
+		float			cameraZoom;
+		float			time;					// Seconds at 60 frames per second, derived from the frame number
+
+	};
+
+	/*
+	*	Struct:			ObjectConstants
+	*	Purpose:		Uniform block of set 0 binding 1, written for every draw into vulkan::uniformRing
+	*
+	*/
+	struct ObjectConstants {
+
+		float			tint[4];				// Multiplied with the color of every instance the draw covers
+
+	};
+
+	/*
+	*	Struct:			DrawConstants
+	*	Purpose:		Vertex push constants of bindless.vert, pushed once per command buffer
+	*
+	*/
+	struct DrawConstants {
+
+		uint32_t		instanceBuffer;			// Element of vulkan::bindlessSet holding the instances
+		uint32_t		instanceOffset;			// In floats
+
+	};
+
+	/*
+	*	Struct:			FrameResources
+	*	Purpose:		Everything one frame in flight owns, reused every MAX_FRAMES_IN_FLIGHT frames
+	*
+	*/
+	struct FrameResources {
+
+		VkSemaphore					imageAvailable;
+		VkSemaphore					renderingFinished;
+		VkFence						inFlight;
+		VkCommandBuffer				commandBuffer;
+		int							readback;				// Readback buffer the frame copies its image to, -1 if none
+		uint32_t					transientPool;			// Linear pool of vulkan::memoryAllocator, reset once the frame fence signaled
+		std::vector< VkSemaphore >	uploadSemaphores;		// Uploads the frame waits on, returned to vulkan::stagingBuffer after the fence
+		LinearAllocation			instances;				// This frame's copy of vulkan::instances in transientPool
+		uint32_t					bindlessInstances;		// Element of vulkan::bindlessSet pointing at transientPool, BINDLESS_INVALID until the first frame
+		VkBuffer					bindlessBuffer;			// Currently written to that element
+		uint32_t					frameConstants;			// Dynamic offset of this frame's FrameConstants in vulkan::uniformRing
+		uint32_t					fallbackObject;			// Dynamic offset of ObjectConstants used by draws the ring had no room for
+
+	};
+
+	/*
+	*	Struct:			RetiredSwapchain
+	*	Purpose:		Swapchain replaced by a recreation, kept alive until the frames that used it finished
+	*
+	*/
+	struct RetiredSwapchain {
+
+		VkSwapchainKHR					swapchain;
+		std::vector< VkImageView >		imageViews;
+		std::vector< VkFramebuffer >	framebuffers;
+		std::vector< VkPipeline >		pipelines;				// Baked the old extent, empty if the extent stayed
+		RenderGraphTransients			transients;				// Of the old extent, empty if the extent stayed
+		uint64_t						frameNumber;			// First frame not using it
+
+	};
+
+	/*
+	*	Enum:			ReadbackState
+	*	Purpose:		Owner of a readback buffer, FREE -> GPU (copy pending) -> ENCODING (worker) -> FREE
+	*
+	*/
+	enum ReadbackState {
+
+		READBACK_FREE,
+		READBACK_GPU,
+		READBACK_ENCODING
+
+	};
+
+	/*
+	*	Struct:			ReadbackBuffer
+	*	Purpose:		Persistently mapped host buffer receiving one rendered frame
+	*
+	*/
+	struct ReadbackBuffer {
+
+		VkBuffer			buffer;
+		MemoryAllocation	allocation;
+		uint64_t			frameNumber;
+		ReadbackState		state;					// Guarded by readbackMutex
+
+	};
+
+	FrameResources									frames[MAX_FRAMES_IN_FLIGHT];
+	VkFence*										imagesInFlight;					// Per swapchain image, fence of the frame rendering to it
+	uint32_t										currentFrame = 0;
+	uint64_t										frameNumber = 0;				// Frames submitted since startup
+	std::chrono::high_resolution_clock::time_point	startupTime;					// Set first thing in main, the reference of the time to first frame
+
+
+	/*
+	*	Namespace:		vulkan
+	*	Purpose:		Differentiate between GLFW and VULKAN
+	*
+	*/
+	namespace vulkan {
+
+		/*
+		*	Global Variables in namespace
+		*
+		*/
+		Logger										logger;
+		Profiler									profiler;
+		HostAllocator								hostAllocator;					// pAllocator of every Vulkan object, here and in the helper classes
+		uint64_t									hostBytesAfterStartup = 0;		// Live driver host memory once init finished
+		MemoryAllocator								memoryAllocator;
+		PipelineCache								pipelineCache(PIPELINE_CACHE_FILE);
+		ShaderLibrary								shaderLibrary;
+		PipelineBuilder								pipelineBuilder;
+		std::vector< VkPipeline >					variantPipelines;
+		CommandRecorder								commandRecorder;
+		std::vector< VkCommandBuffer >				secondaryCommandBuffers;		// Recorded for the current frame, executed by its primary
+		StagingBuffer								stagingBuffer;
+		GeometryBuffer								triangleGeometry;
+		VertexFormat								vertexFormat;
+		VertexFormat								instanceFormat(1, VK_VERTEX_INPUT_RATE_INSTANCE);
+		std::vector< InstanceData >					instances;						// CPU side, animated and copied into the frame's transient pool every frame
+		float										meshRadius = 0.0f;				// Bounding circle of triangleGeometry around its origin
+		GpuCuller									gpuCuller;
+		DescriptorLayoutCache						descriptorLayoutCache;
+		DescriptorAllocator							descriptorAllocator;			// Persistent sets and per-frame sets reset after the frame fence
+		BindlessSet									bindlessSet;					// Created with --bindless only
+		UniformRing									uniformRing;
+		VkDescriptorSetLayout						uniformSetLayout;				// Set 0 of pipelineLayout, owned by descriptorLayoutCache
+		VkDescriptorSet								uniformSet;						// Written once, dynamic offsets select the blocks
+		RenderGraph									renderGraph;					// Culling, drawing and readback of a frame with their barriers
+		uint32_t									targetResource;					// Swapchain or offscreen image of the frame
+		uint32_t									indirectResource;				// gpuCuller buffers of the frame, with --gpu-culling only
+		uint32_t									countResource;
+		uint32_t									readbackResource;				// Headless capture only
+		uint32_t									mainPass;						// Its render pass is renderPass
+		std::vector< VkImage >						targetImages;					// Indexed like imageViews
+		IndirectMode								indirectMode = INDIRECT_MODE_MULTI_DRAW;	// Negotiated in deviceCreateInfo
+		VkPhysicalDevice*							physicalDevices;
+		DeviceSelector								deviceSelector(DEVICE_CACHE_FILE);
+		VkPhysicalDevice							physicalDevice;					// Chosen by deviceSelector
+		uint32_t									graphicsQueueFamily = 0;		// Renders and, unless headless, presents
+		uint32_t									computeQueueFamily = 0;
+		uint32_t									transferQueueFamily = 0;
+		uint32_t									amountOfPhysicalDevices = 0;
+		VkLayerProperties*							layers;
+		uint32_t									amountOfLayers = 0;
+		VkExtensionProperties*						extensions;
+		std::mutex									consoleMutex;					// Startup tasks print from several threads
+
+		uint32_t amountOfImagesInSwapchain			= 0;			// Also the amount of offscreen images in headless mode
+		std::vector< VkPresentModeKHR >				presentModes;					// Supported by the surface on physicalDevice
+		std::vector< RetiredSwapchain >				retiredSwapchains;
+		uint32_t									swapchainRecreations = 0;
+		VkImage*									offscreenImages;
+		MemoryAllocation*							offscreenImageMemory;
+
+		ThreadPool*									threadPool;
+		FrameWriter									frameWriter;
+		ReadbackBuffer								readbackBuffers[READBACK_BUFFER_COUNT];
+		bool										readbackCoherent;				// Otherwise mapped ranges are invalidated before encoding
+		std::mutex									readbackMutex;
+		std::condition_variable						readbackCondition;
+			   
+		VkShaderModule shaderModuleVert;
+		VkShaderModule shaderModuleFrag;
+
+		/*
+		*	Function:		void vulkan::init()
+		*	Purpose:		Initializes the Vulkan API, every step is a task of a graph run on the thread pool
+		*					so window creation, instance setup, shader I/O, geometry uploads and pipeline
+		*					builds overlap, the critical path shows which chain bounds the startup time
+		*
+		*/
+		void init() {
+
+			logger.start(BINARY_LOGGING);
+			LOG_START_STOP(logger, "Startup initialized...");
+
+			threadPool = new ThreadPool();
+			LOG_EVENT(logger, "Thread pool started with {} workers", threadPool->size());
+
+			TaskGraph startup;
+			typedef TaskGraph::Task Task;
+
+			Task layersTask			= startup.add("init: layers", enumerateLayers);
+			startup.add("init: print layers", printLayers, { layersTask });
+			startup.add("init: extensions", printExtensions);
+
+			std::vector< Task > instanceDependencies	= { layersTask };
+			std::vector< Task > deviceDependencies;
+			Task windowTask = 0;
+			if (!headless) {
+
+				// GLFW has to be initialized and drive its windows from the main thread
+				Task glfwTask	= startup.add("init: glfw", glfw::init, {}, TASK_MAIN_THREAD);
+				windowTask		= startup.add("init: window", glfw::createWindow, { glfwTask }, TASK_MAIN_THREAD);
+				instanceDependencies.push_back(glfwTask);
+
+			}
+
+			Task instanceTask = startup.add("init: instance", createInstance, instanceDependencies);
+			deviceDependencies.push_back(instanceTask);
+
+			Task surfaceTask = instanceTask;
+			if (!headless) {
+
+				surfaceTask = startup.add("init: surface", createWindowSurface, { instanceTask, windowTask });
+				deviceDependencies.push_back(surfaceTask);
+
+			}
+
+			Task physicalDeviceTask		= startup.add("init: physical devices", selectPhysicalDevice, deviceDependencies);
+			startup.add("init: print physical devices", printPhysicalDevices, { physicalDeviceTask });
+			Task createInfoTask			= startup.add("init: device create info", deviceCreateInfo, { physicalDeviceTask });
+			Task deviceTask				= startup.add("init: device", device, { createInfoTask });
+			Task queueTask				= startup.add("init: queues", createQueue, { deviceTask });
+			Task allocatorTask			= startup.add("init: allocator", createAllocator, { deviceTask });
+			Task pipelineCacheTask		= startup.add("init: pipeline cache", createPipelineCache, { deviceTask });
+
+			// Mapping and hashing the SPIR-V needs no device, only the module creation waits for it
+			const bool cull = gpuCulling;
+			const char* vertexShaderFile = bindless ? "bindless.spv" : "vert.spv";
+			Task shaderFilesTask = startup.add("init: shader files", [cull, vertexShaderFile]() {
+
+#ifdef SHADERS_EMBEDDED
+				// The build compiled and optimized every shader into the binary, no file is read
+				size_t embeddedWords = 0;
+				for (const EmbeddedShader &shader : EMBEDDED_SHADERS) {
+
+					if (!shaderLibrary.embed(shader.fileName, shader.code, shader.words)) {
+
+						LOG_EVENT(logger, "Embedded shader skipped, loading the file instead: {}", shaderLibrary.lastError());
+
+					}
+					embeddedWords += shader.words;
+
+				}
+				LOG_EVENT(logger, "Shaders: {} embedded modules, {} bytes of SPIR-V", sizeof(EMBEDDED_SHADERS) / sizeof(EmbeddedShader), embeddedWords * sizeof(uint32_t));
+#else
+				for (const char* fileName : { vertexShaderFile, "frag.spv", "comp.spv" }) {
+
+					if ((strcmp(fileName, "comp.spv") != 0 || cull) && !shaderLibrary.prefetch(fileName)) {
+
+						LOG_EVENT(logger, "Shader prefetch failed, loading it later: {}", shaderLibrary.lastError());
+
+					}
+
+				}
+#endif
+
+			});
+			Task shaderModulesTask = startup.add("init: shader modules", []() {
+
+				shaderLibrary.init(logicalDevice, hostAllocator.callbacks());
+				shaderModuleVert = loadShader(bindless ? "bindless.spv" : "vert.spv");
+				shaderModuleFrag = loadShader("frag.spv");
+
+			}, { deviceTask, shaderFilesTask });
+
+			Task geometryTask = startup.add("init: geometry", createGeometry, { queueTask, allocatorTask });
+			Task descriptorsTask = startup.add("init: descriptors", createDescriptors, { deviceTask });
+			Task uniformsTask = startup.add("init: uniforms", createUniforms, { allocatorTask, descriptorsTask });
+
+			// deviceCreateInfo turns gpuCulling off if the device lacks the features
+			startup.add("init: culling", []() {
+
+				if (gpuCulling) {
+
+					createCuller();
+
+				}
+
+			}, { allocatorTask, pipelineCacheTask, shaderModulesTask, descriptorsTask });
+
+			// Without a fixed surface extent the swapchain asks GLFW for the framebuffer size, a main thread call
+			std::vector< Task > swapchainDependencies = { deviceTask, allocatorTask };
+			if (!headless) {
+
+				swapchainDependencies.push_back(surfaceTask);
+
+			}
+			Task swapchainTask		= startup.add("init: swapchain", createSwapchain, swapchainDependencies, !headless);
+			Task renderPassTask		= startup.add("init: render pass", createRenderPass, { descriptorsTask, uniformsTask });
+
+			// Waits for the compiles it hands to the pool, running it on a worker could starve them
+			startup.add("init: pipelines", createPipelines, { renderPassTask, shaderModulesTask, geometryTask, swapchainTask, pipelineCacheTask }, TASK_MAIN_THREAD);
+
+			// Nothing to retire yet
+			Task transientsTask = startup.add("init: transients", []() {
+
+				RenderGraphTransients none;
+				result = renderGraph.resize(swapchainExtent, none);
+				ASSERT_VULKAN(result);
+
+				LOG_EVENT(logger, "Render graph transients: {} bytes, {} bytes without aliasing", renderGraph.transientBytes(), renderGraph.unaliasedBytes());
+
+			}, { swapchainTask, renderPassTask });
+			startup.add("init: framebuffers", createFramebuffers, { transientsTask });
+
+			Task commandPoolTask	= startup.add("init: command pool", createCommandPool, { deviceTask });
+			startup.add("init: frame resources", createFrameResources, { commandPoolTask, swapchainTask, allocatorTask });
+
+			startup.run(*threadPool, profiler);
+
+			hostBytesAfterStartup = hostAllocator.liveBytes();
+
+			std::string criticalPath = startup.describe(startup.criticalPath());
+			LOG_START_STOP(logger, "Startup of {} tasks took {} ms on {} workers, {} ms if run one after another", startup.amountOfTasks(), startup.milliseconds(), threadPool->size(), startup.serialMilliseconds());
+			LOG_START_STOP(logger, "Startup critical path: {}", criticalPath);
+
+			std::lock_guard< std::mutex > lock(consoleMutex);
+			std::cout << "Startup:	" << startup.amountOfTasks() << " tasks in " << startup.milliseconds() << " ms ("
+				<< startup.serialMilliseconds() << " ms serial), critical path: " << criticalPath << std::endl;
+
+		}
+
+		/*
+		*	Function:		void vulkan::enumerateLayers()
+		*	Purpose:		Gets the available instance layers
+		*
+		*/
+		void enumerateLayers() {
+
+			vkEnumerateInstanceLayerProperties(&amountOfLayers, NULL);
+			layers = new VkLayerProperties[amountOfLayers];
+			vkEnumerateInstanceLayerProperties(&amountOfLayers, layers);
+
+		}
+
+		/*
+		*	Function:		void vulkan::printLayers()
+		*	Purpose:		Prints the available instance layers
+		*
+		*/
+		void printLayers() {
+
+			std::lock_guard< std::mutex > lock(consoleMutex);
+
+			std::cout << "Amount of instance layers:	" << amountOfLayers << std::endl;
+			for (unsigned int i = 0; i < amountOfLayers; i++) {
+
+				std::cout << "Name:				" << layers[i].layerName					<< std::endl;
+				std::cout << "Spec-Version:		" << layers[i].specVersion					<< std::endl;
+				std::cout << "Impl-Version:		" << layers[i].implementationVersion		<< std::endl;
+				std::cout << "Description:		" << layers[i].description					<< std::endl;
+				std::cout << "------------------"											<< std::endl;
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::printExtensions()
+		*	Purpose:		Gets and prints the available instance extensions
+		*
+		*/
+		void printExtensions() {
+
+			uint32_t amountOfExtensions = 0;
+			vkEnumerateInstanceExtensionProperties(
+
+				NULL,
+				&amountOfExtensions,
+				NULL
+
+			);
+			extensions = new VkExtensionProperties[amountOfExtensions];
+			vkEnumerateInstanceExtensionProperties(
+
+				NULL,
+				&amountOfExtensions,
+				extensions
+
+			);
+
+			std::lock_guard< std::mutex > lock(consoleMutex);
+
+			std::cout << "Amount of extensions:	" << amountOfExtensions << std::endl;
+			for (unsigned int i = 0; i < amountOfExtensions; i++) {
+
+				std::cout << "Name:	"				<< extensions[i].extensionName		<< std::endl;
+				std::cout << "Spec-Version:	"		<< extensions[i].specVersion		<< std::endl;
+				std::cout << "------------------"	<< std::endl;
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createInstance()
+		*	Purpose:		Creates the instance with the validation layers that exist
+		*
+		*/
+		void createInstance() {
+
+			// Application info
+			VkApplicationInfo appInfo;
+			appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+			appInfo.pNext = NULL;
+			appInfo.pApplicationName = "VULKAN TUTORIAL";
+			appInfo.applicationVersion = VK_MAKE_VERSION(0, 0, 0);
+			appInfo.pEngineName = "Tutorial Vulkan Engine";
+			appInfo.engineVersion = VK_MAKE_VERSION(0, 0, 0);
+			appInfo.apiVersion = VK_API_VERSION_1_1;
+
+			LOG_EVENT(logger, "VkApplicationInfo gathered");
+
+			const std::vector< const char* > wantedLayers = {
+
+				"VK_LAYER_LUNARG_standard_validation"
+
+			};
+
+			// Render nodes often ship without the SDK, only enable layers that exist
+			std::vector< const char* > validationLayers;
+			for (const char* wanted : wantedLayers) {
+
+				for (unsigned int i = 0; i < amountOfLayers; i++) {
+
+					if (strcmp(layers[i].layerName, wanted) == 0) {
+
+						validationLayers.push_back(wanted);
+						break;
+
+					}
+
+				}
+
+			}
+
+			// Headless mode neither initializes GLFW nor needs surface extensions
+			uint32_t amountOfGlfwExtensions = 0;
+			const char** glfwExtensions = nullptr;
+			if (!headless) {
+
+				glfwExtensions = glfwGetRequiredInstanceExtensions(&amountOfGlfwExtensions);
+
+			}
+
+			/*const std::vector< const char* > usedExtensions = {
+
+				"VK_KHR_surface",
+				VK_KHR_SURFACE_EXTENSION_NAME
+
+			};*/
+
+			// Instance info
+			VkInstanceCreateInfo instanceInfo;
+			instanceInfo.sType							= VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+			instanceInfo.pNext							= NULL;
+			instanceInfo.flags							= 0;
+			instanceInfo.pApplicationInfo				= &appInfo;
+			instanceInfo.enabledLayerCount				= validationLayers.size();
+			instanceInfo.ppEnabledLayerNames			= validationLayers.data();
+			instanceInfo.enabledExtensionCount			= amountOfGlfwExtensions;
+			instanceInfo.ppEnabledExtensionNames		= glfwExtensions;
+
+			LOG_EVENT(logger, "VkInstanceCreateInfo gathered");
+
+			// Instance creation
+			result = vkCreateInstance(
+
+				&instanceInfo,	// Pass instance info
+				hostAllocator.callbacks(),	// Pass the host allocator
+				&instance		// Pass the actual instance
+
+			);
+			ASSERT_VULKAN(result);
+
+			LOG_EVENT(logger, "Instance created successfully");
+
+		}
+
+		/*
+		*	Function:		void vulkan::createWindowSurface()
+		*	Purpose:		Creates the surface of the GLFW window
+		*
+		*/
+		void createWindowSurface() {
+
+			result = glfwCreateWindowSurface(
+
+				instance,		// Pass instance
+				window,			// Pass the window
+				hostAllocator.callbacks(),	// Pass the host allocator
+				&surface		// Pass the actual surface itself
+
+			);
+			ASSERT_VULKAN(result);
+
+		}
+
+		/*
+		*	Function:		void vulkan::selectPhysicalDevice()
+		*	Purpose:		Enumerates the GPU's, selects one by score and gathers its queue create infos
+		*
+		*/
+		void selectPhysicalDevice() {
+
+			// Enumerate GPU's (physically)
+			result = vkEnumeratePhysicalDevices(
+
+				instance,						// Pass the instance
+				&amountOfPhysicalDevices,		// Pass the variable for the amount of GPU's
+				NULL							// Pass no array to store them, so we can just get the number of GPU's
+
+			);
+			ASSERT_VULKAN(result);
+
+			physicalDevices = new VkPhysicalDevice[amountOfPhysicalDevices];
+			result = vkEnumeratePhysicalDevices(
+
+				instance,						// Pass the instance
+				&amountOfPhysicalDevices,		// Pass the amount of GPU's
+				physicalDevices					// Pass the array to store the enumerated GPU's
+
+			);
+			ASSERT_VULKAN(result);
+
+			DeviceRequirements requirements = {};
+			requirements.queueFlags		= VK_QUEUE_GRAPHICS_BIT;
+			requirements.surface		= headless ? VK_NULL_HANDLE : surface;
+			if (!headless) {
+
+				requirements.extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+			}
+
+			uint32_t selectedDevice = 0;
+			result = deviceSelector.select(amountOfPhysicalDevices, physicalDevices, requirements, selectedDevice);
+			if (result != VK_SUCCESS) {
+
+				LOG_ERROR(logger, "No suitable GPU: {}", deviceSelector.status());
+				throw std::runtime_error("No suitable GPU found");
+
+			}
+			physicalDevice		= physicalDevices[selectedDevice];
+			graphicsQueueFamily	= deviceSelector.capabilities().graphicsQueueFamily;
+			computeQueueFamily	= deviceSelector.capabilities().computeQueueFamily;
+			transferQueueFamily	= deviceSelector.capabilities().transferQueueFamily;
+
+			LOG_EVENT(logger, "Physical device: {}", deviceSelector.status());
+
+			deviceQueueCreateInfos(physicalDevice);
+
+		}
+
+		/*
+		*	Function:		void vulkan::printPhysicalDevices()
+		*	Purpose:		Prints every GPU and its score unless the capability snapshot was reused
+		*
+		*/
+		void printPhysicalDevices() {
+
+			// A reused snapshot means the devices are unchanged since they were last printed
+			if (deviceSelector.loadedFromCache()) {
+
+				return;
+
+			}
+
+			std::lock_guard< std::mutex > lock(consoleMutex);
+
+			std::cout << "Number of GPU's:	" << amountOfPhysicalDevices << std::endl;
+			for (unsigned int i = 0; i < amountOfPhysicalDevices; i++) {
+
+				deviceProperties(physicalDevices[i]);
+				deviceFeatures(physicalDevices[i]);
+				deviceMemoryProperties(physicalDevices[i]);
+				queueFamilyProperties(physicalDevices[i]);
+				if (!headless) {
+
+					surfaceCapabilities(physicalDevices[i]);
+
+				}
+
+			}
+
+			for (const DeviceCandidate &candidate : deviceSelector.candidates()) {
+
+				LOG_EVENT(logger, "GPU {}: score {} {}", candidate.name, candidate.score, candidate.reason);
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::deviceProperties(vkPhysicalDevice &device)
+		*	Purpose:		Prints the device information for every GPU
+		*
+		*/
+		void deviceProperties(VkPhysicalDevice &device) {
+
+			// Device properties
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(device, &properties);
+
+			uint32_t apiVer = properties.apiVersion;
+
+			std::cout << "Name:	" << properties.deviceName << std::endl;
+			std::cout << "API-Version:	" << VK_VERSION_MAJOR(apiVer) <<
+				"." << VK_VERSION_MINOR(apiVer) << "." <<
+				VK_VERSION_PATCH(apiVer) << std::endl;
+			std::cout << "Discrete-Queue-Priorities:	" << properties.limits.discreteQueuePriorities		<< std::endl;
+			std::cout << "Driver-Version:				" << properties.driverVersion						<< std::endl;
+			std::cout << "Vendor-ID:					" << properties.vendorID							<< std::endl;
+			std::cout << "Device-ID:					" << properties.deviceID							<< std::endl;
+			std::cout << "Device-Type:					" << properties.deviceType							<< std::endl;
+			std::cout << "Pipeline-Cache-UUID:			" << properties.pipelineCacheUUID					<< std::endl;
+			std::cout << "------------------------------"													<< std::endl;
+
+		}
+
+		/*
+		*	Function:		void vulkan::deviceFeatures(VkPhysicalDevice &device)
+		*	Purpose:		Prints detailed information about the GPU
+		*
+		*/
+		void deviceFeatures(VkPhysicalDevice &device) {
+
+			// Device features
+			VkPhysicalDeviceFeatures features;
+			vkGetPhysicalDeviceFeatures(device, &features);
+
+			std::cout << "Features:											"															<< std::endl;
+			std::cout << "\tRobust Buffer Access:								" << features.robustBufferAccess							<< std::endl;
+			std::cout << "\tFull Draw Index Uint32:							" << features.fullDrawIndexUint32							<< std::endl;
+			std::cout << "\tImage Cube Array:									" << features.imageCubeArray								<< std::endl;
+			std::cout << "\tIndependent Blend:								" << features.independentBlend								<< std::endl;
+			std::cout << "\tGeometry Shader:									" << features.geometryShader								<< std::endl;
+			std::cout << "\tTesselation Shader:								" << features.tessellationShader							<< std::endl;
+			std::cout << "\tSample Rate Shading:								" << features.sampleRateShading								<< std::endl;
+			std::cout << "\tDual Src Blend:									" << features.dualSrcBlend									<< std::endl;
+			std::cout << "\tLogic Op:											" << features.logicOp										<< std::endl;
+			std::cout << "\tMulti Draw Indirect:								" << features.multiDrawIndirect								<< std::endl;
+			std::cout << "\tDraw Indirect First Instance:						" << features.drawIndirectFirstInstance						<< std::endl;
+			std::cout << "\tDepth Clamp:										" << features.depthClamp									<< std::endl;
+			std::cout << "\tDepth Bias Clamp:									" << features.depthBiasClamp								<< std::endl;
+			std::cout << "\tFill Mode Non Solid:								" << features.fillModeNonSolid								<< std::endl;
+			std::cout << "\tDepth Bounds:										" << features.depthBounds									<< std::endl;
+			std::cout << "\tWide Lines:										" << features.wideLines										<< std::endl;
+			std::cout << "\tLarge Points:										" << features.largePoints									<< std::endl;
+			std::cout << "\tAlpha To One:										" << features.alphaToOne									<< std::endl;
+			std::cout << "\tMulti Viewport:									" << features.multiViewport									<< std::endl;
+			std::cout << "\tSampler Anisotropy:								" << features.samplerAnisotropy								<< std::endl;
+			std::cout << "\tTexture Compression ETC2:							" << features.textureCompressionETC2						<< std::endl;
+			std::cout << "\tTexture Compression ASTC_LDR:						" << features.textureCompressionASTC_LDR					<< std::endl;
+			std::cout << "\tTexture Compression BC:							" << features.textureCompressionBC							<< std::endl;
+			std::cout << "\tOcclusion Query Precise:							" << features.occlusionQueryPrecise							<< std::endl;
+			std::cout << "\tPipeline Statistics Query:						" << features.pipelineStatisticsQuery						<< std::endl;
+			std::cout << "\tVertex Pipeline Stores and Atomics:				" << features.vertexPipelineStoresAndAtomics				<< std::endl;
+			std::cout << "\tFragment Stores and Atomics:						" << features.fragmentStoresAndAtomics						<< std::endl;
+			std::cout << "\tShader Tessellation and Geometry Point Size:		" << features.shaderTessellationAndGeometryPointSize		<< std::endl;
+			std::cout << "\tShader Image Gather Extended:						" << features.shaderImageGatherExtended						<< std::endl;
+			std::cout << "\tShader Storage Image Extended Formats:			" << features.shaderStorageImageExtendedFormats				<< std::endl;
+			std::cout << "\tShader Storage Image Multisample:					" << features.shaderStorageImageMultisample					<< std::endl;
+			std::cout << "\tShader Storage Image Read Without Format:			" << features.shaderStorageImageReadWithoutFormat			<< std::endl;
+			std::cout << "\tShader Storage Image Write Without Format:		" << features.shaderStorageImageWriteWithoutFormat			<< std::endl;
+			std::cout << "\tShader Uniform Buffer Array Dynamic Indexing:		" << features.shaderUniformBufferArrayDynamicIndexing		<< std::endl;
+			std::cout << "\tShader Sampled Image Array Dynamic Indexing:		" << features.shaderSampledImageArrayDynamicIndexing		<< std::endl;
+			std::cout << "\tShader Storage Buffer Array Dynamic Indexing:		" << features.shaderStorageBufferArrayDynamicIndexing		<< std::endl;
+			std::cout << "\tShader Storage Image Array Dynamic Indexing:		" << features.shaderStorageImageArrayDynamicIndexing		<< std::endl;
+			std::cout << "\tShader Clip Distance:								" << features.shaderClipDistance							<< std::endl;
+			std::cout << "\tShader Cull Distance:								" << features.shaderCullDistance							<< std::endl;
+			std::cout << "\tShader Float64:									" << features.shaderFloat64									<< std::endl;
+			std::cout << "\tShader Int64:										" << features.shaderInt64									<< std::endl;
+			std::cout << "\tShader Int16:										" << features.shaderInt16									<< std::endl;
+			std::cout << "\tShader Resource Residency:						" << features.shaderResourceResidency						<< std::endl;
+			std::cout << "\tShader Resource Min Load:							" << features.shaderResourceMinLod							<< std::endl;
+			std::cout << "\tSparse Binding:									" << features.sparseBinding									<< std::endl;
+			std::cout << "\tSparse Residency Buffer:							" << features.sparseResidencyBuffer							<< std::endl;
+			std::cout << "\tSparse Residency Image2D:							" << features.sparseResidencyImage2D						<< std::endl;
+			std::cout << "\tSparse Residency Image3D:							" << features.sparseResidencyImage3D						<< std::endl;
+			std::cout << "\tSparse Residency 2 Samples:						" << features.sparseResidency2Samples						<< std::endl;
+			std::cout << "\tSparse Residency 4 Samples:						" << features.sparseResidency4Samples						<< std::endl;
+			std::cout << "\tSparse Residency 8 Samples:						" << features.sparseResidency8Samples						<< std::endl;
+			std::cout << "\tSparse Residency 16 Samples:						" << features.sparseResidency16Samples						<< std::endl;
+			std::cout << "\tSparse Residency Aliased:							" << features.sparseResidencyAliased						<< std::endl;
+			std::cout << "\tVariable Multisample Rate:						" << features.variableMultisampleRate						<< std::endl;
+			std::cout << "\tInherit Queries:									" << features.inheritedQueries								<< std::endl;
+			std::cout << "--------------------------------------------------"															<< std::endl;
+
+		}
+
+		/*
+		*	Function:		void vulkan::deviceMemoryProperties(VkPhysicalDevice &device)
+		*	Purpose:		Prints the memory properties of the GPU
+		*
+		*/
+		void deviceMemoryProperties(VkPhysicalDevice &device) {
+
+			// Device memory properties
+			VkPhysicalDeviceMemoryProperties memProp;
+			vkGetPhysicalDeviceMemoryProperties(device, &memProp);
+
+			std::cout << "Memory Type Count:	" << memProp.memoryTypeCount << std::endl;
+			std::cout << "Memory HEAP Count:	" << memProp.memoryHeapCount << std::endl;
+
+			for (uint32_t i = 0; i < memProp.memoryHeapCount; i++) {
+
+				std::cout << "Heap " << i << ":			" << (memProp.memoryHeaps[i].size >> 20) << " MiB"
+					<< ((memProp.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? ", device local" : "")				<< std::endl;
+
+			}
+
+			// The memory allocator picks among these types by their property flags
+			for (uint32_t i = 0; i < memProp.memoryTypeCount; i++) {
+
+				VkMemoryPropertyFlags flags = memProp.memoryTypes[i].propertyFlags;
+				std::cout << "Type " << i << ":			heap " << memProp.memoryTypes[i].heapIndex
+					<< ((flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)		? ", device local"	: "")
+					<< ((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)		? ", host visible"	: "")
+					<< ((flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)		? ", coherent"		: "")
+					<< ((flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)		? ", cached"		: "")
+					<< ((flags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)	? ", lazy"			: "")			<< std::endl;
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::qeueFamilyProperties(VkPhysicalDevice &device)
+		*	Purpose:		Prints the queue family properties
+		*
+		*/
+		void queueFamilyProperties(VkPhysicalDevice &device) {
+
+			// Queue family properties
+			uint32_t amountOfQueueFamilies = 0;
+			vkGetPhysicalDeviceQueueFamilyProperties(
+
+				device,							// Pass the device / GPU
+				&amountOfQueueFamilies,			// Pass the variable to store amount of queue families
+				NULL							// Pass no array to store them, so we can just get the number of queue families
+
+			);
+			VkQueueFamilyProperties* familyProperties = new VkQueueFamilyProperties[amountOfQueueFamilies];
+			vkGetPhysicalDeviceQueueFamilyProperties(
+
+				device,							// Pass the device / GPU
+				&amountOfQueueFamilies,			// Pass the variable to store amount of queue families
+				familyProperties				// Pass the array to store the enumerated queue families
+			);
+
+			std::cout << "Amount of Queue Families:	" << amountOfQueueFamilies << std::endl;
+
+			for (unsigned int i = 0; i < amountOfQueueFamilies; i++) {
+
+				std::cout << "Queue Family Number:				" << i																			<< std::endl;
+				std::cout << "\tVK_QUEUE_GRAPHICS_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)			<< std::endl;
+				std::cout << "\tVK_QUEUE_COMPUTE_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0)				<< std::endl;
+				std::cout << "\tVK_QUEUE_TRANSFER_BIT:			" << ((familyProperties[i].queueFlags & VK_QUEUE_TRANSFER_BIT) != 0)			<< std::endl;
+				std::cout << "\tVK_QUEUE_SPARSE_BINDING_BIT:	" << ((familyProperties[i].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0)		<< std::endl;
+				std::cout << "\tQueue Count:					" << familyProperties[i].queueCount												<< std::endl;
+				std::cout << "\tTimestamp Valid Bits:			" << familyProperties[i].timestampValidBits										<< std::endl;
+
+				uint32_t width		= familyProperties[i].minImageTransferGranularity.width;
+				uint32_t height		= familyProperties[i].minImageTransferGranularity.height;
+				uint32_t depth		= familyProperties[i].minImageTransferGranularity.depth;
+				std::cout << "Min Image Timestamp Granularity:	" << width << "," << height << "," << depth									<< std::endl;
+
+			}
+
+			delete[] familyProperties;
+
+		}
+
+		/*
+		*	Function:		void vulkan::deviceQueueCreateInfo(VkPhysicalDevice &device)
+		*	Purpose:		Gather information to create logical device, one entry per queue family
+		*					covering every queue the graphics, compute and transfer roles use
+		*
+		*/
+		// Device queue create info
+		std::vector< VkDeviceQueueCreateInfo > queueCreateInfos;
+		float queuePriorities[] = { 
+			
+			1.0f,
+			1.0f,
+			1.0f,
+			1.0f
+		
+		};
+		void deviceQueueCreateInfos(VkPhysicalDevice &device) {
+
+			const DeviceCapabilities &capabilities = deviceSelector.capabilities();
+			const uint32_t families[]	= { capabilities.graphicsQueueFamily, capabilities.computeQueueFamily, capabilities.transferQueueFamily };
+			const uint32_t indices[]	= { 0, capabilities.computeQueueIndex, capabilities.transferQueueIndex };
+
+			queueCreateInfos.clear();
+			for (unsigned int i = 0; i < 3; i++) {
+
+				auto existing = std::find_if(queueCreateInfos.begin(), queueCreateInfos.end(), [&](const VkDeviceQueueCreateInfo &info) { return info.queueFamilyIndex == families[i]; });
+				if (existing != queueCreateInfos.end()) {
+
+					existing->queueCount = std::max(existing->queueCount, indices[i] + 1);
+					continue;
+
+				}
+
+				VkDeviceQueueCreateInfo deviceQueueCreateInfo;
+				deviceQueueCreateInfo.sType					= VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+				deviceQueueCreateInfo.pNext					= NULL;
+				deviceQueueCreateInfo.flags					= 0;
+				deviceQueueCreateInfo.queueFamilyIndex		= families[i];
+				deviceQueueCreateInfo.queueCount			= indices[i] + 1;
+				deviceQueueCreateInfo.pQueuePriorities		= queuePriorities;
+				queueCreateInfos.push_back(deviceQueueCreateInfo);
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::deviceCreateInfo()
+		*	Purpose:		Gathers the device creation info
+		*
+		*/
+		
+		// Device create info, the features and extensions it points to outlive the task filling it
+		VkDeviceCreateInfo createInfo;
+		VkPhysicalDeviceFeatures usedFeatures;
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures;
+#ifdef VK_KHR_dynamic_rendering
+		VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures;
+#endif
+		std::vector< const char* > deviceExtensions;
+		void deviceCreateInfo() {
+
+			// Physical device features
+			usedFeatures = {
+
+
+
+			};
+
+			deviceExtensions.clear();
+			if (!headless) {
+
+				deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+			}
+
+			// GPU culling writes one command per object with firstInstance selecting the object
+			if (gpuCulling) {
+
+				const VkPhysicalDeviceFeatures &supportedFeatures = deviceSelector.capabilities().features;
+				if (supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance) {
+
+					usedFeatures.multiDrawIndirect			= VK_TRUE;
+					usedFeatures.drawIndirectFirstInstance	= VK_TRUE;
+
+					// The count variant reads its limit from one call, more objects than one call may draw need the multi draw path
+					if (deviceExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) &&
+						instancesPerFrame <= deviceSelector.capabilities().properties.limits.maxDrawIndirectCount) {
+
+						deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+						indirectMode = INDIRECT_MODE_COUNT;
+
+					}
+					LOG_EVENT(logger, "GPU culling: {}", indirectMode == INDIRECT_MODE_COUNT ? "vkCmdDrawIndexedIndirectCountKHR" : "vkCmdDrawIndexedIndirect");
+
+				}
+				else {
+
+					LOG_EVENT(logger, "GPU culling disabled, the device lacks multiDrawIndirect or drawIndirectFirstInstance");
+					gpuCulling = false;
+
+				}
+
+			}
+
+			// Bindless draws index arrays written while other frames are in flight, which takes update after bind,
+			// and bindless.vert picks its storage buffer by a push constant, which takes dynamic indexing
+			if (bindless) {
+
+				VkPhysicalDeviceDescriptorIndexingFeaturesEXT supportedIndexing = {};
+				supportedIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+				VkPhysicalDeviceFeatures2 supportedFeatures2 = {};
+				supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				supportedFeatures2.pNext = &supportedIndexing;
+
+				if (deviceSelector.capabilities().properties.apiVersion >= VK_API_VERSION_1_1 && deviceExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+
+					vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+
+				}
+
+				if (deviceSelector.capabilities().features.shaderStorageBufferArrayDynamicIndexing &&
+					supportedIndexing.runtimeDescriptorArray &&
+					supportedIndexing.descriptorBindingPartiallyBound &&
+					supportedIndexing.descriptorBindingUpdateUnusedWhilePending &&
+					supportedIndexing.descriptorBindingStorageBufferUpdateAfterBind &&
+					supportedIndexing.descriptorBindingSampledImageUpdateAfterBind) {
+
+					usedFeatures.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+
+					descriptorIndexingFeatures = {};
+					descriptorIndexingFeatures.sType										= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+					descriptorIndexingFeatures.runtimeDescriptorArray						= VK_TRUE;
+					descriptorIndexingFeatures.descriptorBindingPartiallyBound				= VK_TRUE;
+					descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending	= VK_TRUE;
+					descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind	= VK_TRUE;
+					descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind	= VK_TRUE;
+					deviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+					LOG_EVENT(logger, "Bindless descriptors: VK_EXT_descriptor_indexing");
+
+				}
+				else {
+
+					LOG_EVENT(logger, "Bindless descriptors disabled, the device lacks VK_EXT_descriptor_indexing, its update after bind features or shaderStorageBufferArrayDynamicIndexing");
+					bindless = false;
+
+				}
+
+			}
+
+			// Dynamic rendering needs the create renderpass 2 and depth stencil resolve extensions it builds on
+#ifdef VK_KHR_dynamic_rendering
+			if (dynamicRendering) {
+
+				VkPhysicalDeviceDynamicRenderingFeaturesKHR supportedDynamicRendering = {};
+				supportedDynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+
+				VkPhysicalDeviceFeatures2 supportedFeatures2 = {};
+				supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				supportedFeatures2.pNext = &supportedDynamicRendering;
+
+				if (deviceSelector.capabilities().properties.apiVersion >= VK_API_VERSION_1_1 &&
+					deviceExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+					deviceExtensionSupported(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) &&
+					deviceExtensionSupported(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME)) {
+
+					vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+
+				}
+
+				if (supportedDynamicRendering.dynamicRendering) {
+
+					dynamicRenderingFeatures = {};
+					dynamicRenderingFeatures.sType				= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+					dynamicRenderingFeatures.pNext				= bindless ? &descriptorIndexingFeatures : nullptr;
+					dynamicRenderingFeatures.dynamicRendering	= VK_TRUE;
+					deviceExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+					deviceExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+					deviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+					LOG_EVENT(logger, "Dynamic rendering: VK_KHR_dynamic_rendering");
+
+				}
+				else {
+
+					LOG_EVENT(logger, "Dynamic rendering disabled, the device lacks VK_KHR_dynamic_rendering, render passes with dynamic viewports are used");
+					dynamicRendering = false;
+
+				}
+
+			}
+#else
+			dynamicRendering = false;
+#endif
+
+			// Halve the sample count until color attachments of the device support it
+			VkSampleCountFlagBits requestedSamples = msaaSamples;
+			while (msaaSamples != VK_SAMPLE_COUNT_1_BIT && (deviceSelector.capabilities().properties.limits.framebufferColorSampleCounts & msaaSamples) == 0) {
+
+				msaaSamples = static_cast< VkSampleCountFlagBits >(msaaSamples >> 1);
+
+			}
+			if (msaaSamples != requestedSamples) {
+
+				LOG_EVENT(logger, "MSAA: {} samples unsupported, using {}", static_cast< uint32_t >(requestedSamples), static_cast< uint32_t >(msaaSamples));
+
+			}
+
+			createInfo.sType						= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+			createInfo.pNext						= bindless ? &descriptorIndexingFeatures : NULL;
+#ifdef VK_KHR_dynamic_rendering
+			if (dynamicRendering) {
+
+				createInfo.pNext					= &dynamicRenderingFeatures;
+
+			}
+#endif
+			createInfo.flags						= 0;
+			createInfo.queueCreateInfoCount			= static_cast< uint32_t >(queueCreateInfos.size());
+			createInfo.pQueueCreateInfos			= queueCreateInfos.data();
+			createInfo.enabledLayerCount			= 0;
+			createInfo.ppEnabledLayerNames			= NULL;
+			createInfo.enabledExtensionCount		= deviceExtensions.size();
+			createInfo.ppEnabledExtensionNames		= deviceExtensions.empty() ? nullptr : deviceExtensions.data();
+			createInfo.pEnabledFeatures				= &usedFeatures;
+
+		}
+
+		/*
+		*	Function:		bool vulkan::deviceExtensionSupported(const char* name)
+		*	Purpose:		Checks whether the selected physical device offers an optional device extension
+		*
+		*/
+		bool deviceExtensionSupported(const char* name) {
+
+			uint32_t amountOfExtensions = 0;
+			result = vkEnumerateDeviceExtensionProperties(
+
+				physicalDevice,
+				nullptr,
+				&amountOfExtensions,
+				nullptr
+
+			);
+			ASSERT_VULKAN(result);
+
+			std::vector< VkExtensionProperties > deviceExtensions(amountOfExtensions);
+			result = vkEnumerateDeviceExtensionProperties(
+
+				physicalDevice,
+				nullptr,
+				&amountOfExtensions,
+				deviceExtensions.data()
+
+			);
+			ASSERT_VULKAN(result);
+
+			for (const VkExtensionProperties &extension : deviceExtensions) {
+
+				if (strcmp(extension.extensionName, name) == 0) {
+
+					return true;
+
+				}
+
+			}
+
+			return false;
+
+		}
+
+		/*
+		*	Function:		void vulkan::device()
+		*	Purpose:		Creates the logical device from the physical device
+		*
+		*/
+		void device() {
+
+			result = vkCreateDevice(
+				
+				physicalDevice, 
+				&createInfo, 
+				hostAllocator.callbacks(), 
+				&logicalDevice
+			
+			);
+			ASSERT_VULKAN(result);
+
+			LOG_EVENT(logger, "Device created successfully");
+
+		}
+
+		/*
+		*	Function:		void vulkan::createAllocator()
+		*	Purpose:		Sets up the memory allocator on the logical device
+		*
+		*/
+		void createAllocator() {
+
+			memoryAllocator.create(logicalDevice, physicalDevice, hostAllocator.callbacks());
+
+		}
+
+		/*
+		*	Function:		void vulkan::createPipelineCache()
+		*	Purpose:		Loads the pipeline cache and hands it to the pipeline builder
+		*
+		*/
+		void createPipelineCache() {
+
+			result = pipelineCache.create(logicalDevice, physicalDevice, hostAllocator.callbacks());
+			ASSERT_VULKAN(result);
+
+			LOG_EVENT(logger, "Pipeline cache: {}", pipelineCache.status());
+
+			pipelineBuilder.init(logicalDevice, pipelineCache.handle(), threadPool, hostAllocator.callbacks());
+
+		}
+
+		/*
+		*	Function:		void vulkan::createQueue()
+		*	Purpose:		Creates the queue for the logical device
+		*
+		*/
+		void createQueue() {
+
+			vkGetDeviceQueue(
+				
+				logicalDevice, 
+				graphicsQueueFamily, 
+				0, 
+				&queue
+			
+			);
+			vkGetDeviceQueue(logicalDevice, computeQueueFamily, deviceSelector.capabilities().computeQueueIndex, &computeQueue);
+			vkGetDeviceQueue(logicalDevice, transferQueueFamily, deviceSelector.capabilities().transferQueueIndex, &transferQueue);
+
+			LOG_EVENT(
+
+				logger,
+				"Queues: graphics family {}, compute family {} queue {}{}, transfer family {} queue {}{}",
+				graphicsQueueFamily,
+				computeQueueFamily,
+				deviceSelector.capabilities().computeQueueIndex,
+				computeQueue == queue ? " (shared)" : "",
+				transferQueueFamily,
+				deviceSelector.capabilities().transferQueueIndex,
+				transferQueue == queue ? " (shared)" : ""
+
+			);
+
+			if (headless) {
+
+				return;
+
+			}
+
+			VkBool32 surfaceSupport = false;
+
+			result = vkGetPhysicalDeviceSurfaceSupportKHR(
+				
+				physicalDevice, 
+				graphicsQueueFamily, 
+				surface,
+				&surfaceSupport
+			
+			);
+			ASSERT_VULKAN(result);
+
+			if (!surfaceSupport) {
+			
+				LOG_ERROR(logger, "Surface not supported!");
+				__debugbreak();
+
+			}
+
+		}
+
+		
+		/*
+		*	Function:		void vulkan::createSurface()
+		*	Purpose:		Would be used to create surface if we didn't do it with GLFW
+		*
+		*/
+#ifdef _WIN32
+		// Surface create info
+		VkWin32SurfaceCreateInfoKHR surfaceCreateInfo;
+		void createSurface() {
+
+			surfaceCreateInfo.sType			= VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR;
+			surfaceCreateInfo.pNext			= NULL;
+			surfaceCreateInfo.flags			= 0;
+			surfaceCreateInfo.hinstance		= NULL;
+			surfaceCreateInfo.hwnd			= NULL;
+
+			result = vkCreateWin32SurfaceKHR(
+
+				instance,
+				&surfaceCreateInfo,
+				hostAllocator.callbacks(),
+				&surface
+
+			);
+			ASSERT_VULKAN(result);
+
+			LOG_EVENT(logger, "Surface created successfully");
+
+		}
+#endif
+
+		/*
+		*	Function:		void vulkan::surfaceCapabilities()
+		*	Purpose:		Get stats of surface
+		*
+		*/
+		// Surface capabilities of the selected device, refreshed by querySurface
+		VkSurfaceCapabilitiesKHR surfaceCapabs;
+		void surfaceCapabilities(VkPhysicalDevice &device) {
+		
+			VkSurfaceCapabilitiesKHR capabilities;
+			result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+			
+				device,
+				surface,
+				&capabilities
+			
+			);
+			ASSERT_VULKAN(result);
+
+			std::cout << "Surface capabilities:	"														<< std::endl;
+			std::cout << "\tminImageCount: "			<< capabilities.minImageCount					<< std::endl;
+			std::cout << "\tmaxImageCount: "			<< capabilities.maxImageCount					<< std::endl;
+			std::cout << "\tcurrentExtent: "			<< capabilities.currentExtent.width			<< " / " 
+														<< capabilities.currentExtent.height			<< std::endl;
+			std::cout << "\tminImageExtent: "			<< capabilities.minImageExtent.width			<< " / " 
+														<< capabilities.minImageExtent.height			<< std::endl;
+			std::cout << "\tmaxImageExtent: "			<< capabilities.maxImageExtent.width			<< " / " 
+														<< capabilities.maxImageExtent.height			<< std::endl;
+			std::cout << "\tmaxImageArrayLayers: "		<< capabilities.maxImageArrayLayers			<< std::endl;
+			std::cout << "\tsupportedTransforms: "		<< capabilities.supportedTransforms			<< std::endl;
+			std::cout << "\tcurrentTransform: "			<< capabilities.currentTransform				<< std::endl;
+			std::cout << "\tsupportedCompositeAlpha: "	<< capabilities.supportedCompositeAlpha		<< std::endl;
+			std::cout << "\tsupportedUsageFlags: "		<< capabilities.supportedUsageFlags			<< std::endl;
+		
+			uint32_t amountOfFormats = 0;
+			result = vkGetPhysicalDeviceSurfaceFormatsKHR(
+				
+				device,
+				surface,
+				&amountOfFormats,
+				nullptr
+			
+			);
+			ASSERT_VULKAN(result);
+
+			VkSurfaceFormatKHR* surfaceFormats = new VkSurfaceFormatKHR[amountOfFormats];
+			result = vkGetPhysicalDeviceSurfaceFormatsKHR(
+			
+				device,
+				surface,
+				&amountOfFormats,
+				surfaceFormats
+						
+			);
+			ASSERT_VULKAN(result);
+
+			std::cout << "-------------------------------" << std::endl;
+			std::cout << "Amount of Formats:	" << amountOfFormats << std::endl;
+			for (unsigned int i = 0; i < amountOfFormats; i++) {
+			
+				std::cout << "Format:	" << surfaceFormats[i].format << std::endl;
+			
+			}
+
+			uint32_t amountOfPresentationModes = 0;
+			vkGetPhysicalDeviceSurfacePresentModesKHR(
+			
+				device,
+				surface,
+				&amountOfPresentationModes,
+				nullptr
+
+			);
+
+			VkPresentModeKHR* presentModes = new VkPresentModeKHR[amountOfPresentationModes];
+			vkGetPhysicalDeviceSurfacePresentModesKHR(
+
+				device,
+				surface,
+				&amountOfPresentationModes,
+				presentModes
+
+			);
+
+			std::cout << "Amount of Presentation Modes:	" << amountOfPresentationModes << std::endl;
+			for (unsigned int i = 0; i < amountOfPresentationModes; i++) {
+			
+				std::cout << "\tSupported Presentation Mode: " << presentModes[i] << std::endl;
+			
+			}
+
+			delete[] surfaceFormats;
+			delete[] presentModes;
+
+		}
+
+		/*
+		*	Function:		void vulkan::createSwapchain()
+		*	Purpose:		Creates the swapchain, or the offscreen images replacing it, and their views
+		*
+		*/
+		// SwapchainCreateInfo
+		VkSwapchainCreateInfoKHR swapchainCreateInfo;
+		void createSwapchain() {
+
+			VkImage* swapchainImages;
+			if (headless) {
+
+				swapchainExtent = { WINDOW_WIDTH, WINDOW_HEIGHT };
+				swapchainImages = createOffscreenImages();
+
+			}
+			else {
+
+				querySurface();
+				swapchainExtent = chooseSwapchainExtent();
+				swapchainImages = createSwapchainImages(VK_NULL_HANDLE);
+
+			}
+
+			createImageViews(swapchainImages);
+			if (!headless) {
+
+				delete[] swapchainImages;
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createRenderPass()
+		*	Purpose:		Creates the pipeline layout and compiles the render graph of a frame, neither depends on the swapchain
+*					The layout holds the uniform set and, with --bindless, the bindless set, so both have to exist
+		*
+		*/
+		void createRenderPass() {
+
+			// Set 0 holds the uniform blocks, bindless draws find their instances through set 1 and the push constants
+			std::vector< VkDescriptorSetLayout > setLayouts = { uniformSetLayout };
+			if (bindless) {
+
+				setLayouts.push_back(bindlessSet.layout());
+
+			}
+
+			VkPushConstantRange pushConstantRange;
+			pushConstantRange.stageFlags	= VK_SHADER_STAGE_VERTEX_BIT;
+			pushConstantRange.offset		= 0;
+			pushConstantRange.size			= sizeof(DrawConstants);
+
+			VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+			pipelineLayoutCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			pipelineLayoutCreateInfo.pNext						= nullptr;
+			pipelineLayoutCreateInfo.flags						= 0;
+			pipelineLayoutCreateInfo.setLayoutCount				= static_cast< uint32_t >(setLayouts.size());
+			pipelineLayoutCreateInfo.pSetLayouts				= setLayouts.data();
+			pipelineLayoutCreateInfo.pushConstantRangeCount		= bindless ? 1 : 0;
+			pipelineLayoutCreateInfo.pPushConstantRanges		= bindless ? &pushConstantRange : nullptr;
+
+			result = vkCreatePipelineLayout(
+			
+				logicalDevice,
+				&pipelineLayoutCreateInfo,
+				hostAllocator.callbacks(),
+				&pipelineLayout
+			
+			);
+			ASSERT_VULKAN(result);
+
+			renderGraph.init(logicalDevice, memoryAllocator, hostAllocator.callbacks(), dynamicRendering);
+
+			// Acquired images are waited for at COLOR_ATTACHMENT_OUTPUT, offscreen ones were finished by their image fence
+			targetResource = renderGraph.importImage(
+
+				"target",
+				colorAttachmentFormat,
+				VK_IMAGE_LAYOUT_UNDEFINED,
+				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+				headless ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+
+			);
+
+			// The host reads the count back once the frame fence signaled
+			if (gpuCulling) {
+
+				indirectResource	= renderGraph.importBuffer("indirect commands");
+				countResource		= renderGraph.importBuffer("visible count", VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT);
+
+				uint32_t cullPass = renderGraph.addPass("cull", RENDER_PASS_TYPE_COMPUTE, recordCull);
+				renderGraph.write(cullPass, indirectResource, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+				renderGraph.write(
+
+					cullPass,
+					countResource,
+					VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+					VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+
+				);
+
+			}
+
+			VkClearColorValue clearColor = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+			mainPass = renderGraph.addPass("main", RENDER_PASS_TYPE_GRAPHICS, recordMain, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+			if (msaaSamples == VK_SAMPLE_COUNT_1_BIT) {
+
+				renderGraph.colorAttachment(mainPass, targetResource, VK_ATTACHMENT_LOAD_OP_CLEAR, clearColor);
+
+			}
+			else {
+
+				// Never stored, tiled GPUs keep it in tile memory
+				uint32_t multisampled = renderGraph.createImage("multisampled color", colorAttachmentFormat, msaaSamples);
+				renderGraph.colorAttachment(mainPass, multisampled, VK_ATTACHMENT_LOAD_OP_CLEAR, clearColor);
+				renderGraph.resolveAttachment(mainPass, targetResource);
+
+			}
+			if (gpuCulling) {
+
+				renderGraph.read(mainPass, indirectResource, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+				if (indirectMode == INDIRECT_MODE_COUNT) {
+
+					renderGraph.read(mainPass, countResource, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+				}
+
+			}
+
+			if (headless && !captureDirectory.empty()) {
+
+				readbackResource = renderGraph.importBuffer("readback", VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT);
+
+				uint32_t readbackPass = renderGraph.addPass("readback", RENDER_PASS_TYPE_TRANSFER, recordReadback);
+				renderGraph.read(readbackPass, targetResource, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+				renderGraph.write(readbackPass, readbackResource, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+			}
+
+			result = renderGraph.compile();
+			ASSERT_VULKAN(result);
+			renderPass = renderGraph.renderPass(mainPass);
+
+			LOG_EVENT(logger, "Render graph: {}", renderGraph.describe());
+
+		}
+
+		/*
+		*	Function:		void vulkan::createCommandPool()
+		*	Purpose:		Creates the pool of the primary command buffers on the graphics queue family
+		*
+		*/
+		void createCommandPool() {
+
+			VkCommandPoolCreateInfo commandPoolCreateInfo;
+			commandPoolCreateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			commandPoolCreateInfo.pNext					= nullptr;
+			commandPoolCreateInfo.flags					= VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+			commandPoolCreateInfo.queueFamilyIndex		= graphicsQueueFamily;
+
+			result = vkCreateCommandPool(
+			
+				logicalDevice,
+				&commandPoolCreateInfo,
+				hostAllocator.callbacks(),
+				&commandPool
+			
+			);
+			ASSERT_VULKAN(result);
+
+		}
+
+		/*
+		*	Function:		void vulkan::querySurface()
+		*	Purpose:		Gets the capabilities and present modes of the surface on the selected device
+		*
+		*/
+		void querySurface() {
+
+			result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+
+				physicalDevice,
+				surface,
+				&surfaceCapabs
+
+			);
+			ASSERT_VULKAN(result);
+
+			uint32_t amountOfPresentationModes = 0;
+			result = vkGetPhysicalDeviceSurfacePresentModesKHR(
+
+				physicalDevice,
+				surface,
+				&amountOfPresentationModes,
+				nullptr
+
+			);
+			ASSERT_VULKAN(result);
+
+			presentModes.resize(amountOfPresentationModes);
+			result = vkGetPhysicalDeviceSurfacePresentModesKHR(
+
+				physicalDevice,
+				surface,
+				&amountOfPresentationModes,
+				presentModes.data()
+
+			);
+			ASSERT_VULKAN(result);
+
+		}
+
+		/*
+		*	Function:		VkPresentModeKHR vulkan::choosePresentMode()
+		*	Purpose:		Returns presentModePolicy if the surface supports it, otherwise FIFO, which every surface supports
+		*
+		*/
+		VkPresentModeKHR choosePresentMode() {
+
+			for (VkPresentModeKHR presentMode : presentModes) {
+
+				if (presentMode == presentModePolicy) {
+
+					return presentMode;
+
+				}
+
+			}
+
+			return VK_PRESENT_MODE_FIFO_KHR;
+
+		}
+
+		/*
+		*	Function:		uint32_t vulkan::chooseImageCount(VkPresentModeKHR presentMode)
+		*	Purpose:		Returns the amount of swapchain images to ask for within the surface limits
+		*					MAILBOX and FIFO get one image above the minimum so the application never waits for the
+		*					presentation engine to release one, IMMEDIATE replaces images at once and needs no spare
+		*
+		*/
+		uint32_t chooseImageCount(VkPresentModeKHR presentMode) {
+
+			uint32_t amountOfImages = surfaceCapabs.minImageCount;
+			if (presentMode != VK_PRESENT_MODE_IMMEDIATE_KHR) {
+
+				amountOfImages++;
+
+			}
+
+			// A maxImageCount of 0 means there is no upper limit
+			if (surfaceCapabs.maxImageCount > 0 && amountOfImages > surfaceCapabs.maxImageCount) {
+
+				amountOfImages = surfaceCapabs.maxImageCount;
+
+			}
+
+			return amountOfImages;
+
+		}
+
+		/*
+		*	Function:		VkExtent2D vulkan::chooseSwapchainExtent()
+		*	Purpose:		Returns the extent of the surface, or the framebuffer size clamped to the surface limits
+		*					if the surface leaves the size to the swapchain, 0 x 0 while the window is minimized
+		*
+		*/
+		VkExtent2D chooseSwapchainExtent() {
+
+			if (surfaceCapabs.currentExtent.width != std::numeric_limits< uint32_t >::max()) {
+
+				return surfaceCapabs.currentExtent;
+
+			}
+
+			int width	= 0;
+			int height	= 0;
+			glfwGetFramebufferSize(window, &width, &height);
+
+			VkExtent2D extent;
+			extent.width	= std::max(surfaceCapabs.minImageExtent.width, std::min(surfaceCapabs.maxImageExtent.width, static_cast< uint32_t >(width)));
+			extent.height	= std::max(surfaceCapabs.minImageExtent.height, std::min(surfaceCapabs.maxImageExtent.height, static_cast< uint32_t >(height)));
+
+			return extent;
+
+		}
+
+		/*
+		*	Function:		VkImage* vulkan::createSwapchainImages(VkSwapchainKHR oldSwapchain)
+		*	Purpose:		Creates the swapchain of swapchainExtent with the present mode of the policy and returns its images,
+		*					passing the swapchain being replaced as oldSwapchain lets the presentation engine reuse its images
+		*
+		*/
+		VkImage* createSwapchainImages(VkSwapchainKHR oldSwapchain) {
+
+			VkPresentModeKHR presentMode = choosePresentMode();
+			if (presentMode != presentModePolicy) {
+
+				LOG_EVENT(logger, "Present mode {} is not supported by the surface, using FIFO", presentModePolicy);
+
+			}
+
+			swapchainCreateInfo.sType						= VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+			swapchainCreateInfo.pNext						= nullptr;
+			swapchainCreateInfo.flags						= 0;
+			swapchainCreateInfo.surface						= surface;
+			swapchainCreateInfo.minImageCount				= chooseImageCount(presentMode);
+			swapchainCreateInfo.imageFormat					= colorAttachmentFormat;				// TODO: Check if valid
+			swapchainCreateInfo.imageColorSpace				= VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;	// TODO: Check if valid
+			swapchainCreateInfo.imageExtent					= swapchainExtent;
+			swapchainCreateInfo.imageArrayLayers			= 1;
+			swapchainCreateInfo.imageUsage					= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			swapchainCreateInfo.imageSharingMode			= VK_SHARING_MODE_EXCLUSIVE;			// TODO: Check if valid
+			swapchainCreateInfo.queueFamilyIndexCount		= 0;
+			swapchainCreateInfo.pQueueFamilyIndices			= nullptr;
+			swapchainCreateInfo.preTransform				= surfaceCapabs.currentTransform;
+			swapchainCreateInfo.compositeAlpha				= VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+			swapchainCreateInfo.presentMode					= presentMode;
+			swapchainCreateInfo.clipped						= VK_TRUE;
+			swapchainCreateInfo.oldSwapchain				= oldSwapchain;
+
+			result = vkCreateSwapchainKHR(
+
+				logicalDevice,
+				&swapchainCreateInfo,
+				hostAllocator.callbacks(),
+				&swapchain
+
+			);
+			ASSERT_VULKAN(result);
+
+			vkGetSwapchainImagesKHR(
+
+				logicalDevice,
+				swapchain,
+				&amountOfImagesInSwapchain,
+				nullptr
+
+			);
+			VkImage* swapchainImages = new VkImage[amountOfImagesInSwapchain];
+			result = vkGetSwapchainImagesKHR(
+
+				logicalDevice,
+				swapchain,
+				&amountOfImagesInSwapchain,
+				swapchainImages
+
+			);
+			ASSERT_VULKAN(result);
+
+			LOG_EVENT(logger, "Swapchain of {}x{} with {} images, present mode {}", swapchainExtent.width, swapchainExtent.height, amountOfImagesInSwapchain, presentMode);
+
+			return swapchainImages;
+
+		}
+
+		/*
+		*	Function:		void vulkan::createImageViews(const VkImage* images)
+		*	Purpose:		Creates one color view per swapchain or offscreen image
+		*
+		*/
+		void createImageViews(const VkImage* images) {
+
+			targetImages.assign(images, images + amountOfImagesInSwapchain);
+			imageViews = new VkImageView[amountOfImagesInSwapchain];
+			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+
+				// Image view create info
+				VkImageViewCreateInfo imageViewCreateInfo;
+
+				imageViewCreateInfo.sType								= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+				imageViewCreateInfo.pNext								= nullptr;
+				imageViewCreateInfo.flags								= 0;
+				imageViewCreateInfo.image								= images[i];
+				imageViewCreateInfo.viewType							= VK_IMAGE_VIEW_TYPE_2D;
+				imageViewCreateInfo.format								= colorAttachmentFormat;			// TODO: Check if valid
+				imageViewCreateInfo.components.r						= VK_COMPONENT_SWIZZLE_IDENTITY;
+				imageViewCreateInfo.components.g						= VK_COMPONENT_SWIZZLE_IDENTITY;
+				imageViewCreateInfo.components.b						= VK_COMPONENT_SWIZZLE_IDENTITY;
+				imageViewCreateInfo.components.a						= VK_COMPONENT_SWIZZLE_IDENTITY;
+				imageViewCreateInfo.subresourceRange.aspectMask			= VK_IMAGE_ASPECT_COLOR_BIT;
+				imageViewCreateInfo.subresourceRange.baseMipLevel		= 0;
+				imageViewCreateInfo.subresourceRange.levelCount			= 1;
+				imageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
+				imageViewCreateInfo.subresourceRange.layerCount			= 1;
+
+				result = vkCreateImageView(
+
+					logicalDevice,
+					&imageViewCreateInfo,
+					hostAllocator.callbacks(),
+					&imageViews[i]
+
+				);
+				ASSERT_VULKAN(result);
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createPipelines()
+		*	Purpose:		Compiles the pipeline and, with --pipeline-variants, its variants for swapchainExtent,
+		*					or for any extent with --dynamic-rendering
+		*
+		*/
+		void createPipelines() {
+
+			viewport.x				= 0.0f;
+			viewport.y				= 0.0f;
+			viewport.width			= static_cast< float >(swapchainExtent.width);
+			viewport.height			= static_cast< float >(swapchainExtent.height);
+			viewport.minDepth		= 0.0f;
+			viewport.maxDepth		= 1.0f;
+
+			VkRect2D scissor;
+			scissor.offset = {
+			
+				0,
+				0
+
+			};
+			scissor.extent = swapchainExtent;
+
+			PipelineDescription pipelineDescription;
+			pipelineDescription.vertexShader		= shaderModuleVert;
+			pipelineDescription.fragmentShader		= shaderModuleFrag;
+			pipelineDescription.viewport			= viewport;
+			pipelineDescription.scissor				= scissor;
+			pipelineDescription.layout				= pipelineLayout;
+			pipelineDescription.renderPass			= renderPass;
+			pipelineDescription.samples				= msaaSamples;
+			pipelineDescription.fragmentConstants.set(FRAGMENT_CONSTANT_GRAYSCALE, grayscale);
+			pipelineDescription.fragmentConstants.set(FRAGMENT_CONSTANT_POSTERIZE, static_cast< uint32_t >(posterizeLevels));
+			pipelineDescription.addVertexFormat(vertexFormat);
+			if (dynamicViewport) {
+
+				// recordDraws() sets both, the pipelines outlive resizes
+				pipelineDescription.dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+			}
+			if (renderPass == VK_NULL_HANDLE) {
+
+				pipelineDescription.colorFormats = { colorAttachmentFormat };
+
+			}
+			if (!bindless) {
+
+				// bindless.vert reads the instances from the storage buffer instead
+				pipelineDescription.addVertexFormat(instanceFormat);
+
+			}
+
+			std::vector< PipelineDescription > pipelineDescriptions(1, pipelineDescription);
+			if (pipelineVariants) {
+
+				const BlendMode blendModes[]				= { BLEND_MODE_OPAQUE, BLEND_MODE_ALPHA, BLEND_MODE_ADDITIVE };
+				const VkPrimitiveTopology topologies[]		= { VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP, VK_PRIMITIVE_TOPOLOGY_LINE_LIST, VK_PRIMITIVE_TOPOLOGY_LINE_STRIP };
+				const VkCullModeFlags cullModes[]			= { VK_CULL_MODE_NONE, VK_CULL_MODE_BACK_BIT };
+				for (BlendMode blendMode : blendModes) {
+
+					for (VkPrimitiveTopology topology : topologies) {
+
+						for (VkCullModeFlags cullMode : cullModes) {
+
+							PipelineDescription variant = pipelineDescription;
+							variant.setBlendMode(blendMode);
+							variant.topology	= topology;
+							variant.cullMode	= cullMode;
+							pipelineDescriptions.push_back(variant);
+
+						}
+
+					}
+
+				}
+
+			}
+
+			auto pipelineStart = std::chrono::high_resolution_clock::now();
+
+			// Every permutation compiles once on a worker, the main thread only waits for the futures
+			std::vector< std::shared_future< VkPipeline > > pipelineFutures = pipelineBuilder.permutations(pipelineDescriptions);
+			for (size_t i = 0; i < pipelineFutures.size(); i++) {
+
+				try {
+
+					VkPipeline compiled = pipelineFutures[i].get();
+					if (i == 0) {
+
+						pipeline = compiled;
+
+					}
+					else {
+
+						variantPipelines.push_back(compiled);
+
+					}
+
+				}
+				catch (const std::runtime_error &error) {
+
+					LOG_ERROR(logger, "Pipeline {} failed to compile: {}", i, error.what());
+					throw;
+
+				}
+
+			}
+
+			// Cold means the cache started empty, compare both runs to see what the cache saves
+			double pipelineMs = std::chrono::duration< double, std::milli >(std::chrono::high_resolution_clock::now() - pipelineStart).count();
+			double compileMs = pipelineBuilder.compileMilliseconds();
+			LOG_START_STOP(logger, "Creation of {} pipelines took {} ms ({} ms compile time on {} workers), {} start", pipelineDescriptions.size(), pipelineMs, compileMs, threadPool->size(), pipelineCache.loadedFromDisk() ? "warm" : "cold");
+			LOG_EVENT(logger, "Pipeline permutations: {} built, {} requests shared an earlier compile", pipelineBuilder.amountOfPipelines(), pipelineBuilder.amountOfPermutationHits());
+			std::cout << "Pipeline creation:	" << pipelineDescriptions.size() << " pipelines in " << pipelineMs << " ms, " << compileMs << " ms compile time on "
+				<< threadPool->size() << " workers (" << (pipelineCache.loadedFromDisk() ? "warm" : "cold") << " start)" << std::endl;
+
+		}
+
+		/*
+		*	Function:		void vulkan::createFramebuffers()
+		*	Purpose:		Creates one framebuffer per image view, the transient attachments of the render graph
+		*					are shared by all of them and have to match swapchainExtent
+		*					With dynamic rendering there is no render pass and every framebuffer is VK_NULL_HANDLE
+		*
+		*/
+		void createFramebuffers() {
+
+			framebuffers = new VkFramebuffer[amountOfImagesInSwapchain];
+			for (size_t i = 0; i < amountOfImagesInSwapchain; i++) {
+
+				renderGraph.setImage(targetResource, targetImages[i], imageViews[i]);
+				result = renderGraph.createFramebuffer(mainPass, framebuffers[i]);
+				ASSERT_VULKAN(result);
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::recreateSwapchain()
+		*	Purpose:		Replaces the swapchain after a resize, VK_ERROR_OUT_OF_DATE_KHR or VK_SUBOPTIMAL_KHR
+		*					without waiting for the device, the old swapchain, its views, framebuffers and, if the
+		*					extent changed, pipelines and transient attachments are retired and destroyed once the
+		*					frames using them finished
+		*
+		*/
+		void recreateSwapchain() {
+
+			PROFILE_SCOPE(profiler, "frame: recreate swapchain");
+
+			querySurface();
+			VkExtent2D extent = chooseSwapchainExtent();
+
+			// A minimized window has no valid extent, wait until it is restored or closed
+			while ((extent.width == 0 || extent.height == 0) && !glfwWindowShouldClose(window)) {
+
+				glfwWaitEvents();
+				querySurface();
+				extent = chooseSwapchainExtent();
+
+			}
+			if (extent.width == 0 || extent.height == 0) {
+
+				return;
+
+			}
+			framebufferResized = false;
+
+			RetiredSwapchain retired;
+			retired.swapchain		= swapchain;
+			retired.imageViews.assign(imageViews, imageViews + amountOfImagesInSwapchain);
+			retired.framebuffers.assign(framebuffers, framebuffers + amountOfImagesInSwapchain);
+			retired.frameNumber		= frameNumber;
+			delete[] imageViews;
+			delete[] framebuffers;
+			delete[] imagesInFlight;
+
+			bool extentChanged = extent.width != swapchainExtent.width || extent.height != swapchainExtent.height;
+			swapchainExtent = extent;
+
+			VkImage* swapchainImages = createSwapchainImages(retired.swapchain);
+			createImageViews(swapchainImages);
+			delete[] swapchainImages;
+
+			// The transient attachments have the extent, the pipelines only if the viewport is baked into them
+			if (extentChanged) {
+
+				result = renderGraph.resize(swapchainExtent, retired.transients);
+				ASSERT_VULKAN(result);
+
+			}
+			if (extentChanged && !dynamicViewport) {
+
+				retired.pipelines.push_back(pipeline);
+				retired.pipelines.insert(retired.pipelines.end(), variantPipelines.begin(), variantPipelines.end());
+				variantPipelines.clear();
+
+				// Returning to an earlier extent must not hand out a pipeline about to be destroyed
+				for (VkPipeline retiredPipeline : retired.pipelines) {
+
+					pipelineBuilder.evict(retiredPipeline);
+
+				}
+				createPipelines();
+
+			}
+			createFramebuffers();
+
+			// No frame rendered to the new images yet
+			imagesInFlight = new VkFence[amountOfImagesInSwapchain];
+			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+
+				imagesInFlight[i] = VK_NULL_HANDLE;
+
+			}
+
+			retiredSwapchains.push_back(retired);
+			swapchainRecreations++;
+			LOG_EVENT(logger, "Swapchain recreated at frame {}, {} retired swapchains pending", frameNumber, retiredSwapchains.size());
+
+		}
+
+		/*
+		*	Function:		void vulkan::destroyRetiredSwapchains(bool deviceIdle)
+		*	Purpose:		Destroys the retired swapchains no frame in flight uses anymore, all of them if the device is idle
+		*					Called after the fence of the current frame, every frame before frameNumber + 1 - MAX_FRAMES_IN_FLIGHT finished
+		*
+		*/
+		void destroyRetiredSwapchains(bool deviceIdle) {
+
+			auto it = retiredSwapchains.begin();
+			while (it != retiredSwapchains.end()) {
+
+				if (!deviceIdle && it->frameNumber + MAX_FRAMES_IN_FLIGHT > frameNumber + 1) {
+
+					it++;
+					continue;
+
+				}
+
+				for (VkFramebuffer framebuffer : it->framebuffers) {
+
+					vkDestroyFramebuffer(logicalDevice, framebuffer, hostAllocator.callbacks());
+
+				}
+				for (VkPipeline retiredPipeline : it->pipelines) {
+
+					pipelineBuilder.destroy(retiredPipeline);
+
+				}
+				renderGraph.destroyTransients(it->transients);
+				for (VkImageView imageView : it->imageViews) {
+
+					vkDestroyImageView(logicalDevice, imageView, hostAllocator.callbacks());
+
+				}
+				vkDestroySwapchainKHR(logicalDevice, it->swapchain, hostAllocator.callbacks());
+				it = retiredSwapchains.erase(it);
+
+			}
+
+		}
+
+		/*
+		*	Function:		VkImage* vulkan::createOffscreenImages()
+		*	Purpose:		Creates the color targets used instead of swapchain images in headless mode
+		*
+		*/
+		VkImage* createOffscreenImages() {
+
+			amountOfImagesInSwapchain	= HEADLESS_IMAGE_COUNT;
+			offscreenImages				= new VkImage[amountOfImagesInSwapchain];
+			offscreenImageMemory		= new MemoryAllocation[amountOfImagesInSwapchain];
+
+			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+
+				VkImageCreateInfo imageCreateInfo;
+				imageCreateInfo.sType					= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+				imageCreateInfo.pNext					= nullptr;
+				imageCreateInfo.flags					= 0;
+				imageCreateInfo.imageType				= VK_IMAGE_TYPE_2D;
+				imageCreateInfo.format					= colorAttachmentFormat;
+				imageCreateInfo.extent					= { WINDOW_WIDTH, WINDOW_HEIGHT, 1 };
+				imageCreateInfo.mipLevels				= 1;
+				imageCreateInfo.arrayLayers				= 1;
+				imageCreateInfo.samples					= VK_SAMPLE_COUNT_1_BIT;
+				imageCreateInfo.tiling					= VK_IMAGE_TILING_OPTIMAL;
+				imageCreateInfo.usage					= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+				imageCreateInfo.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
+				imageCreateInfo.queueFamilyIndexCount	= 0;
+				imageCreateInfo.pQueueFamilyIndices		= nullptr;
+				imageCreateInfo.initialLayout			= VK_IMAGE_LAYOUT_UNDEFINED;
+
+				result = memoryAllocator.createImage(
+
+					imageCreateInfo,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+					0,
+					offscreenImages[i],
+					offscreenImageMemory[i]
+
+				);
+				ASSERT_VULKAN(result);
+
+			}
+
+			LOG_EVENT(logger, "Created {} offscreen images of {}x{}", amountOfImagesInSwapchain, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+			return offscreenImages;
+
+		}
+
+		/*
+		*	Function:		void vulkan::createFrameResources()
+		*	Purpose:		Creates command buffers, semaphores and fences of every frame in flight
+		*
+		*/
+		void createFrameResources() {
+
+			result = commandRecorder.create(
+
+				logicalDevice,
+				graphicsQueueFamily,
+				MAX_FRAMES_IN_FLIGHT,
+				recordThreads > 0 ? recordThreads : std::max(std::thread::hardware_concurrency(), 1u),
+				hostAllocator.callbacks()
+
+			);
+			ASSERT_VULKAN(result);
+			LOG_EVENT(logger, "Command recorder: {} recording threads, {} draws per frame", commandRecorder.amountOfThreads(), drawsPerFrame);
+
+			VkCommandBuffer commandBuffers[MAX_FRAMES_IN_FLIGHT];
+
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo;
+			commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			commandBufferAllocateInfo.pNext					= nullptr;
+			commandBufferAllocateInfo.commandPool			= commandPool;
+			commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount	= MAX_FRAMES_IN_FLIGHT;
+
+			result = vkAllocateCommandBuffers(
+				
+				logicalDevice,
+				&commandBufferAllocateInfo,
+				commandBuffers
+			
+			);
+			ASSERT_VULKAN(result);
+
+			VkSemaphoreCreateInfo semaphoreCreateInfo;
+			semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphoreCreateInfo.pNext = nullptr;
+			semaphoreCreateInfo.flags = 0;
+
+			// Fences start signaled so the first wait on every frame returns immediately
+			VkFenceCreateInfo fenceCreateInfo;
+			fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+			fenceCreateInfo.pNext = nullptr;
+			fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+			for (unsigned int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+
+				frames[i].commandBuffer = commandBuffers[i];
+				frames[i].readback = -1;
+				frames[i].bindlessInstances = BINDLESS_INVALID;
+				frames[i].bindlessBuffer = VK_NULL_HANDLE;
+
+				// Host writes land directly in device local memory where the heap allows it
+				result = memoryAllocator.createLinearPool(
+
+					TRANSIENT_POOL_SIZE + instancesPerFrame * sizeof(InstanceData),
+					VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+					VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+					frames[i].transientPool
+
+				);
+				ASSERT_VULKAN(result);
+
+				result = vkCreateSemaphore(
+					
+					logicalDevice, 
+					&semaphoreCreateInfo, 
+					hostAllocator.callbacks(), 
+					&frames[i].imageAvailable
+				
+				);
+				ASSERT_VULKAN(result);
+				result = vkCreateSemaphore(
+					
+					logicalDevice, 
+					&semaphoreCreateInfo,
+					hostAllocator.callbacks(), 
+					&frames[i].renderingFinished
+				
+				);
+				ASSERT_VULKAN(result);
+				result = vkCreateFence(
+
+					logicalDevice,
+					&fenceCreateInfo,
+					hostAllocator.callbacks(),
+					&frames[i].inFlight
+
+				);
+				ASSERT_VULKAN(result);
+
+			}
+
+			imagesInFlight = new VkFence[amountOfImagesInSwapchain];
+			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+
+				imagesInFlight[i] = VK_NULL_HANDLE;
+
+			}
+
+			result = profiler.createGpuQueries(logicalDevice, physicalDevice, graphicsQueueFamily, MAX_FRAMES_IN_FLIGHT, hostAllocator.callbacks());
+			ASSERT_VULKAN(result);
+			LOG_EVENT(logger, "GPU timestamp queries supported: {}", profiler.gpuTimingSupported());
+
+			if (headless && !captureDirectory.empty()) {
+
+				createReadbackBuffers();
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createReadbackBuffers()
+		*	Purpose:		Creates the ring of mapped host buffers frames are copied to for capturing
+		*
+		*/
+		void createReadbackBuffers() {
+
+			frameWriter = FrameWriter(captureDirectory, captureFormat, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+			VkBufferCreateInfo bufferCreateInfo;
+			bufferCreateInfo.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferCreateInfo.pNext					= nullptr;
+			bufferCreateInfo.flags					= 0;
+			bufferCreateInfo.size					= static_cast< VkDeviceSize >(WINDOW_WIDTH) * WINDOW_HEIGHT * 4;
+			bufferCreateInfo.usage					= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			bufferCreateInfo.sharingMode			= VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount	= 0;
+			bufferCreateInfo.pQueueFamilyIndices	= nullptr;
+
+			for (unsigned int i = 0; i < READBACK_BUFFER_COUNT; i++) {
+
+				ReadbackBuffer &readback = readbackBuffers[i];
+
+				// The CPU reads every byte, cached memory avoids uncached reads over the bus
+				result = memoryAllocator.createBuffer(
+
+					bufferCreateInfo,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+					VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+					readback.buffer,
+					readback.allocation
+
+				);
+				ASSERT_VULKAN(result);
+				readbackCoherent = memoryAllocator.coherent(readback.allocation);
+
+				readback.frameNumber	= 0;
+				readback.state			= READBACK_FREE;
+
+			}
+
+			LOG_EVENT(
+
+				logger,
+				"Created {} readback buffers of {} bytes, coherent: {}, capturing to {}",
+				READBACK_BUFFER_COUNT,
+				bufferCreateInfo.size,
+				readbackCoherent,
+				frameWriter.fileName(0)
+
+			);
+
+		}
+
+		/*
+		*	Struct:			vulkan::ReadbackStats
+		*	Purpose:		Counts captured frames and how often the encoders held up rendering
+		*
+		*/
+		struct ReadbackStats {
+
+			uint32_t	framesCaptured;
+			uint32_t	stalls;					// Frames that found no free readback buffer
+			double		stallMs;				// CPU time spent waiting for a free readback buffer
+
+		};
+		ReadbackStats readbackStats = {};
+
+		/*
+		*	Struct:			vulkan::RecordStats
+		*	Purpose:		Accumulates the CPU time spent recording draws into secondary command buffers
+		*
+		*/
+		struct RecordStats {
+
+			uint64_t	frames;
+			uint64_t	draws;
+			double		recordMs;				// Wall time of the parallel recording, excludes the primary command buffer
+
+		};
+		RecordStats recordStats = {};
+
+		/*
+		*	Struct:			vulkan::InstanceStats
+		*	Purpose:		Accumulates the CPU time spent animating instances and copying them into the ring
+		*
+		*/
+		struct InstanceStats {
+
+			uint64_t	frames;
+			double		updateMs;
+
+		};
+		InstanceStats instanceStats = {};
+
+		/*
+		*	Struct:			vulkan::CullStats
+		*	Purpose:		Accumulates the objects that passed GPU culling, read back after each frame fence
+		*
+		*/
+		struct CullStats {
+
+			uint64_t	frames;
+			uint64_t	visible;
+
+		};
+		CullStats cullStats = {};
+
+		/*
+		*	Struct:			vulkan::HostStats
+		*	Purpose:		Counts the driver host allocations made while drawing, the frame loop should make none
+		*					once the first frames grew the command pools
+		*
+		*/
+		struct HostStats {
+
+			uint64_t	frames;
+			uint64_t	allocations;
+			uint64_t	framesAllocating;		// Frames after the first MAX_FRAMES_IN_FLIGHT that allocated at all
+
+		};
+		HostStats hostStats = {};
+
+		/*
+		*	Function:		int vulkan::acquireReadbackBuffer()
+		*	Purpose:		Returns a free readback buffer for the current frame, blocks while all are busy
+		*
+		*/
+		int acquireReadbackBuffer() {
+
+			std::unique_lock< std::mutex > lock(readbackMutex);
+			auto waitStart = std::chrono::high_resolution_clock::now();
+			bool stalled = false;
+
+			while (true) {
+
+				for (unsigned int i = 0; i < READBACK_BUFFER_COUNT; i++) {
+
+					if (readbackBuffers[i].state == READBACK_FREE) {
+
+						readbackBuffers[i].state		= READBACK_GPU;
+						readbackBuffers[i].frameNumber	= frameNumber;
+
+						if (stalled) {
+
+							readbackStats.stalls++;
+							readbackStats.stallMs += std::chrono::duration< double, std::milli >(std::chrono::high_resolution_clock::now() - waitStart).count();
+
+						}
+						return static_cast< int >(i);
+
+					}
+
+				}
+
+				stalled = true;
+				readbackCondition.wait(lock);
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::retireReadbackBuffer(int index)
+		*	Purpose:		Hands a readback buffer whose copy has completed to an encoding worker,
+		*					the fence of the frame that filled it must have been waited on
+		*
+		*/
+		void retireReadbackBuffer(int index) {
+
+			ReadbackBuffer &readback = readbackBuffers[index];
+
+			if (!readbackCoherent) {
+
+				result = memoryAllocator.invalidate(readback.allocation);
+				ASSERT_VULKAN(result);
+
+			}
+
+			{
+
+				std::lock_guard< std::mutex > lock(readbackMutex);
+				readback.state = READBACK_ENCODING;
+
+			}
+			readbackStats.framesCaptured++;
+
+			threadPool->submit([index]() {
+
+				ReadbackBuffer &readback = readbackBuffers[index];
+
+				if (!frameWriter.write(readback.frameNumber, static_cast< const uint8_t* >(readback.allocation.mapped), WINDOW_WIDTH * 4)) {
+
+					LOG_ERROR(logger, "Failed to write captured frame to {}", frameWriter.fileName(readback.frameNumber));
+
+				}
+
+				{
+
+					std::lock_guard< std::mutex > lock(readbackMutex);
+					readback.state = READBACK_FREE;
+
+				}
+				readbackCondition.notify_one();
+
+			});
+
+		}
+
+		/*
+		*	Function:		void vulkan::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, VkBuffer readbackBuffer)
+		*	Purpose:		Records the passes of the render graph into the given command buffer, culling, the draws
+		*					and, if readbackBuffer is not VK_NULL_HANDLE, the copy of the offscreen image
+		*
+		*/
+		void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, VkBuffer readbackBuffer) {
+
+			VkCommandBufferBeginInfo commandBufferBeginInfo;
+			commandBufferBeginInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			commandBufferBeginInfo.pNext				= nullptr;
+			commandBufferBeginInfo.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			commandBufferBeginInfo.pInheritanceInfo		= nullptr;
+
+			result = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			ASSERT_VULKAN(result);
+
+			profiler.cmdBeginGpuFrame(commandBuffer, currentFrame, frameNumber);
+
+			// Take over buffers uploaded on the transfer queue since the last frame
+			stagingBuffer.acquire(commandBuffer, frames[currentFrame].uploadSemaphores);
+
+			renderGraph.setImage(targetResource, targetImages[imageIndex], imageViews[imageIndex]);
+			renderGraph.setFramebuffer(mainPass, framebuffers[imageIndex]);
+			if (gpuCulling) {
+
+				renderGraph.setBuffer(indirectResource, gpuCuller.indirectBuffer(currentFrame));
+				renderGraph.setBuffer(countResource, gpuCuller.countBuffer(currentFrame));
+
+			}
+			if (readbackBuffer != VK_NULL_HANDLE) {
+
+				renderGraph.setBuffer(readbackResource, readbackBuffer);
+
+			}
+			renderGraph.execute(commandBuffer);
+
+			profiler.cmdEndGpuFrame(commandBuffer, currentFrame);
+
+			result = vkEndCommandBuffer(commandBuffer);
+			ASSERT_VULKAN(result);
+
+		}
+
+		/*
+		*	Function:		void vulkan::recordCull(const RenderPassContext &context)
+		*	Purpose:		Records the culling dispatch, the view volume of the 2D scene is the clip space square
+		*
+		*/
+		void recordCull(const RenderPassContext &context) {
+
+			CullConstants cullConstants = {
+
+				{
+
+					{ 1.0f, 0.0f, 0.0f, 1.0f },
+					{ -1.0f, 0.0f, 0.0f, 1.0f },
+					{ 0.0f, 1.0f, 0.0f, 1.0f },
+					{ 0.0f, -1.0f, 0.0f, 1.0f }
+
+				},
+				instancesPerFrame,
+				triangleGeometry.amountOfIndices(),
+				meshRadius,
+				indirectMode == INDIRECT_MODE_COUNT ? 1u : 0u
+
+			};
+			gpuCuller.cmdCull(context.commandBuffer, currentFrame, cullConstants);
+
+		}
+
+		/*
+		*	Function:		void vulkan::recordMain(const RenderPassContext &context)
+		*	Purpose:		Records the draws in parallel into secondary command buffers and executes them in the subpass,
+		*					or with dynamic rendering inside the rendering they inherit the attachment formats of
+		*
+		*/
+		void recordMain(const RenderPassContext &context) {
+
+			VkCommandBufferInheritanceInfo inheritanceInfo;
+			inheritanceInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			inheritanceInfo.pNext					= nullptr;
+#ifdef VK_KHR_dynamic_rendering
+			VkCommandBufferInheritanceRenderingInfoKHR renderingInheritanceInfo;
+			renderingInheritanceInfo.sType						= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+			renderingInheritanceInfo.pNext						= nullptr;
+			renderingInheritanceInfo.flags						= 0;
+			renderingInheritanceInfo.viewMask					= 0;
+			renderingInheritanceInfo.colorAttachmentCount		= context.colorAttachmentCount;
+			renderingInheritanceInfo.pColorAttachmentFormats	= context.colorFormats;
+			renderingInheritanceInfo.depthAttachmentFormat		= VK_FORMAT_UNDEFINED;
+			renderingInheritanceInfo.stencilAttachmentFormat	= VK_FORMAT_UNDEFINED;
+			renderingInheritanceInfo.rasterizationSamples		= context.samples;
+			if (context.renderPass == VK_NULL_HANDLE) {
+
+				inheritanceInfo.pNext = &renderingInheritanceInfo;
+
+			}
+#endif
+			inheritanceInfo.renderPass				= context.renderPass;
+			inheritanceInfo.subpass					= context.subpass;
+			inheritanceInfo.framebuffer				= context.framebuffer;
+			inheritanceInfo.occlusionQueryEnable	= VK_FALSE;
+			inheritanceInfo.queryFlags				= 0;
+			inheritanceInfo.pipelineStatistics		= 0;
+
+			auto recordStart = std::chrono::high_resolution_clock::now();
+
+			result = commandRecorder.record(
+
+				currentFrame,
+				inheritanceInfo,
+				drawsPerFrame,
+				recordDraws,
+				secondaryCommandBuffers
+
+			);
+			ASSERT_VULKAN(result);
+
+			recordStats.frames++;
+			recordStats.draws		+= drawsPerFrame;
+			recordStats.recordMs	+= std::chrono::duration< double, std::milli >(std::chrono::high_resolution_clock::now() - recordStart).count();
+
+			vkCmdExecuteCommands(
+
+				context.commandBuffer,
+				static_cast< uint32_t >(secondaryCommandBuffers.size()),
+				secondaryCommandBuffers.data()
+
+			);
+
+		}
+
+		/*
+		*	Function:		void vulkan::recordReadback(const RenderPassContext &context)
+		*	Purpose:		Copies the offscreen image into the readback buffer of the frame, tightly packed
+		*
+		*/
+		void recordReadback(const RenderPassContext &context) {
+
+			VkBufferImageCopy region;
+			region.bufferOffset						= 0;
+			region.bufferRowLength					= 0;		// Tightly packed
+			region.bufferImageHeight				= 0;
+			region.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.mipLevel		= 0;
+			region.imageSubresource.baseArrayLayer	= 0;
+			region.imageSubresource.layerCount		= 1;
+			region.imageOffset						= { 0, 0, 0 };
+			region.imageExtent						= { context.extent.width, context.extent.height, 1 };
+
+			vkCmdCopyImageToBuffer(
+
+				context.commandBuffer,
+				renderGraph.image(targetResource),
+				VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				renderGraph.buffer(readbackResource),
+				1,
+				&region
+
+			);
+
+		}
+
+		/*
+		*	Function:		void vulkan::recordDraws(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t amountOfDraws)
+		*	Purpose:		Records a range of the frame's draws into a secondary command buffer, runs on recording threads
+		*
+		*/
+		void recordDraws(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t amountOfDraws) {
+
+			vkCmdBindPipeline(
+				
+				commandBuffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS, 
+				pipeline
+			
+			);
+
+			if (dynamicViewport) {
+
+				VkRect2D scissor;
+				scissor.offset	= { 0, 0 };
+				scissor.extent	= swapchainExtent;
+
+				VkViewport frameViewport	= viewport;
+				frameViewport.width			= static_cast< float >(swapchainExtent.width);
+				frameViewport.height		= static_cast< float >(swapchainExtent.height);
+				vkCmdSetViewport(commandBuffer, 0, 1, &frameViewport);
+				vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			}
+
+			triangleGeometry.bind(commandBuffer);
+
+			const FrameResources &frame = frames[currentFrame];
+			if (bindless) {
+
+				// Binds nothing per draw, gl_InstanceIndex includes firstInstance and selects the instance
+				VkDescriptorSet descriptorSet = bindlessSet.set();
+				vkCmdBindDescriptorSets(
+
+					commandBuffer,
+					VK_PIPELINE_BIND_POINT_GRAPHICS,
+					pipelineLayout,
+					1,
+					1,
+					&descriptorSet,
+					0,
+					nullptr
+
+				);
+
+				DrawConstants drawConstants;
+				drawConstants.instanceBuffer	= frame.bindlessInstances;
+				drawConstants.instanceOffset	= static_cast< uint32_t >(frame.instances.offset / sizeof(float));
+				vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawConstants), &drawConstants);
+
+			}
+			else {
+
+				vkCmdBindVertexBuffers(
+
+					commandBuffer,
+					1,
+					1,
+					&frame.instances.buffer,
+					&frame.instances.offset
+
+				);
+
+			}
+
+			// Draw d covers instances [d * N / D, (d + 1) * N / D), a handful of draws cover every instance
+			for (uint32_t i = firstDraw; i < firstDraw + amountOfDraws; i++) {
+
+				uint32_t firstInstance	= static_cast< uint32_t >(static_cast< uint64_t >(i) * instancesPerFrame / drawsPerFrame);
+				uint32_t endInstance	= static_cast< uint32_t >(static_cast< uint64_t >(i + 1) * instancesPerFrame / drawsPerFrame);
+
+				// Every draw gets its own block, written straight into the mapped ring by the recording thread
+				uint32_t dynamicOffsets[2] = { frame.frameConstants, frame.fallbackObject };
+				UniformAllocation objectBlock;
+				if (uniformRing.allocate(sizeof(ObjectConstants), objectBlock)) {
+
+					ObjectConstants* objectConstants = static_cast< ObjectConstants* >(objectBlock.mapped);
+					for (uint32_t c = 0; c < 4; c++) {
+
+						objectConstants->tint[c] = 1.0f;
+
+					}
+					dynamicOffsets[1] = objectBlock.dynamicOffset;
+
+				}
+				vkCmdBindDescriptorSets(
+
+					commandBuffer,
+					VK_PIPELINE_BIND_POINT_GRAPHICS,
+					pipelineLayout,
+					0,
+					1,
+					&uniformSet,
+					2,
+					dynamicOffsets
+
+				);
+				if (gpuCulling) {
+
+					gpuCuller.cmdDraw(commandBuffer, currentFrame, firstInstance, endInstance - firstInstance);
+
+				}
+				else if (endInstance > firstInstance) {
+
+					triangleGeometry.draw(commandBuffer, endInstance - firstInstance, firstInstance);
+
+				}
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createGeometry()
+		*	Purpose:		Uploads the meshes to device local memory and describes their vertex format
+		*
+		*/
+		void createGeometry() {
+
+			result = stagingBuffer.create(
+
+				logicalDevice,
+				memoryAllocator,
+				transferQueue,
+				transferQueueFamily,
+				queue,
+				graphicsQueueFamily,
+				STAGING_BUFFER_SIZE,
+				hostAllocator.callbacks()
+
+			);
+			ASSERT_VULKAN(result);
+
+			const std::vector< Vertex > vertices = {
+
+				{ { 0.0f, -0.5f }, { 1.0f, 0.0f, 0.0f } },
+				{ { 0.5f, 0.5f }, { 0.0f, 1.0f, 0.0f } },
+				{ { -0.5f, 0.5f }, { 0.0f, 0.0f, 1.0f } }
+
+			};
+			const std::vector< uint16_t > indices = { 0, 1, 2 };
+
+			result = triangleGeometry.create(memoryAllocator, stagingBuffer, vertices, indices);
+			ASSERT_VULKAN(result);
+
+			for (const Vertex &vertex : vertices) {
+
+				meshRadius = std::max(meshRadius, std::sqrt(vertex.position[0] * vertex.position[0] + vertex.position[1] * vertex.position[1]));
+
+			}
+
+			vertexFormat
+				.add(0, VK_FORMAT_R32G32_SFLOAT)
+				.add(1, VK_FORMAT_R32G32B32_SFLOAT);
+
+			LOG_EVENT(logger, "Geometry uploaded: {} bytes through the staging buffer", stagingBuffer.uploadedBytes());
+
+			createInstances();
+
+		}
+
+		/*
+		*	Function:		void vulkan::createInstances()
+		*	Purpose:		Lays the instances out on a square grid covering the screen and describes their format
+		*
+		*/
+		void createInstances() {
+
+			instanceFormat
+				.add(2, VK_FORMAT_R32G32B32A32_SFLOAT)
+				.add(3, VK_FORMAT_R32G32B32_SFLOAT);
+
+			uint32_t columns = 1;
+			while (static_cast< uint64_t >(columns) * columns < instancesPerFrame) {
+
+				columns++;
+
+			}
+			float cell = 2.0f / columns;
+
+			// The mesh spans one unit, half a cell leaves a gap between neighbours, a single instance keeps the original size
+			instances.resize(instancesPerFrame);
+			for (uint32_t i = 0; i < instancesPerFrame; i++) {
+
+				float u = static_cast< float >(i % columns) / columns;
+				float v = static_cast< float >(i / columns) / columns;
+
+				InstanceData &instance = instances[i];
+				instance.transform[0]	= -1.0f + cell * (i % columns + 0.5f);
+				instance.transform[1]	= -1.0f + cell * (i / columns + 0.5f);
+				instance.transform[2]	= cell * 0.5f;
+				instance.transform[3]	= 0.0f;
+				instance.color[0]		= 1.0f - 0.5f * u;
+				instance.color[1]		= 1.0f - 0.5f * v;
+				instance.color[2]		= 1.0f - 0.5f * u * v;
+
+			}
+
+			LOG_EVENT(logger, "{} instances on a {}x{} grid, {} bytes per frame", instancesPerFrame, columns, columns, instancesPerFrame * sizeof(InstanceData));
+
+		}
+
+		/*
+		*	Function:		void vulkan::createCuller()
+		*	Purpose:		Creates the culling compute pipeline and the indirect buffers in the negotiated mode
+		*
+		*/
+		void createCuller() {
+
+			result = gpuCuller.create(
+
+				logicalDevice,
+				memoryAllocator,
+				descriptorLayoutCache,
+				descriptorAllocator,
+				pipelineCache.handle(),
+				loadShader("comp.spv"),
+				MAX_FRAMES_IN_FLIGHT,
+				instancesPerFrame,
+				indirectMode,
+				deviceSelector.capabilities().properties.limits.maxDrawIndirectCount,
+				hostAllocator.callbacks()
+
+			);
+			if (result != VK_SUCCESS) {
+
+				LOG_ERROR(logger, "GPU culler creation failed: {}", result);
+				throw std::runtime_error("GPU culler creation failed");
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::createDescriptors()
+		*	Purpose:		Prepares the layout cache and the descriptor pools, with --bindless also the bindless set
+		*					sized to the update after bind limits of the device
+		*
+		*/
+		void createDescriptors() {
+
+			descriptorLayoutCache.init(logicalDevice, hostAllocator.callbacks());
+
+			// Per set: the culler's three storage buffers, the two uniform blocks and textures of later passes
+			result = descriptorAllocator.create(
+
+				logicalDevice,
+				MAX_FRAMES_IN_FLIGHT,
+				{
+
+					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3.0f },
+					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2.0f },
+					{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f }
+
+				},
+				hostAllocator.callbacks()
+
+			);
+			ASSERT_VULKAN(result);
+
+			if (!bindless) {
+
+				return;
+
+			}
+
+			VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties = {};
+			indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+			VkPhysicalDeviceProperties2 properties2 = {};
+			properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties2.pNext = &indexingProperties;
+			vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+			// Combined image samplers count as samplers and as sampled images, both arrays share the per-stage resources
+			uint32_t maxBuffers = std::min({
+
+				BINDLESS_MAX_BUFFERS,
+				indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+				indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+				indexingProperties.maxPerStageUpdateAfterBindResources / 2
+
+			});
+			uint32_t maxImages = std::min({
+
+				BINDLESS_MAX_IMAGES,
+				indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+				indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+				indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+				indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+				indexingProperties.maxPerStageUpdateAfterBindResources - maxBuffers
+
+			});
+
+			result = bindlessSet.create(
+
+				logicalDevice,
+				descriptorLayoutCache,
+				maxBuffers,
+				maxImages,
+				VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+				hostAllocator.callbacks()
+
+			);
+			if (result != VK_SUCCESS) {
+
+				LOG_ERROR(logger, "Bindless set creation failed: {}", result);
+				throw std::runtime_error("Bindless set creation failed");
+
+			}
+			LOG_EVENT(logger, "Bindless set: {} storage buffers, {} textures", maxBuffers, maxImages);
+
+		}
+
+		/*
+		*	Function:		void vulkan::createUniforms()
+		*	Purpose:		Creates the uniform ring with room for the frame block and one block per draw and the set
+		*					addressing it, whose descriptors are written once
+		*
+		*/
+		void createUniforms() {
+
+			VkDeviceSize alignment = deviceSelector.capabilities().properties.limits.minUniformBufferOffsetAlignment;
+			VkDeviceSize blockSize = (std::max(sizeof(FrameConstants), sizeof(ObjectConstants)) + alignment - 1) / alignment * alignment;
+
+			result = uniformRing.create(
+
+				memoryAllocator,
+				MAX_FRAMES_IN_FLIGHT,
+				UNIFORM_REGION_SIZE + (drawsPerFrame + 2) * blockSize,
+				alignment
+
+			);
+			if (result != VK_SUCCESS) {
+
+				LOG_ERROR(logger, "Uniform ring creation failed: {}", result);
+				throw std::runtime_error("Uniform ring creation failed");
+
+			}
+
+			std::vector< VkDescriptorSetLayoutBinding > bindings(2);
+			for (uint32_t i = 0; i < 2; i++) {
+
+				bindings[i].binding					= i;
+				bindings[i].descriptorType			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+				bindings[i].descriptorCount			= 1;
+				bindings[i].stageFlags				= VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+				bindings[i].pImmutableSamplers		= nullptr;
+
+			}
+
+			result = descriptorLayoutCache.get(bindings, uniformSetLayout);
+			ASSERT_VULKAN(result);
+			result = descriptorAllocator.allocate(DESCRIPTOR_PERSISTENT, uniformSetLayout, uniformSet);
+			ASSERT_VULKAN(result);
+
+			VkDescriptorBufferInfo bufferInfos[2] = {
+
+				uniformRing.descriptor(sizeof(FrameConstants)),
+				uniformRing.descriptor(sizeof(ObjectConstants))
+
+			};
+
+			VkWriteDescriptorSet writes[2];
+			for (uint32_t i = 0; i < 2; i++) {
+
+				writes[i].sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writes[i].pNext					= nullptr;
+				writes[i].dstSet				= uniformSet;
+				writes[i].dstBinding			= i;
+				writes[i].dstArrayElement		= 0;
+				writes[i].descriptorCount		= 1;
+				writes[i].descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+				writes[i].pImageInfo			= nullptr;
+				writes[i].pBufferInfo			= &bufferInfos[i];
+				writes[i].pTexelBufferView		= nullptr;
+
+			}
+			vkUpdateDescriptorSets(logicalDevice, 2, writes, 0, nullptr);
+
+			LOG_EVENT(logger, "Uniform ring: {} KiB per frame in flight, {} byte blocks", uniformRing.regionSize() / 1024, blockSize);
+
+		}
+
+		/*
+		*	Function:		void vulkan::updateUniforms(FrameResources &frame)
+		*	Purpose:		Starts the frame's region of the uniform ring and writes the frame block and the block
+		*					of draws the ring has no room for, call after the frame fence
+		*
+		*/
+		void updateUniforms(FrameResources &frame) {
+
+			uniformRing.begin(currentFrame);
+
+			UniformAllocation frameBlock;
+			UniformAllocation fallbackBlock;
+			if (!uniformRing.allocate(sizeof(FrameConstants), frameBlock) || !uniformRing.allocate(sizeof(ObjectConstants), fallbackBlock)) {
+
+				LOG_ERROR(logger, "Uniform ring region of {} bytes cannot hold the frame constants", uniformRing.regionSize());
+				throw std::runtime_error("Uniform ring too small");
+
+			}
+
+			FrameConstants* frameConstants = static_cast< FrameConstants* >(frameBlock.mapped);
+			frameConstants->cameraOffset[0]	= 0.0f;
+			frameConstants->cameraOffset[1]	= 0.0f;
+			frameConstants->cameraZoom		= 1.0f;
+			frameConstants->time			= frameNumber / 60.0f;
+			frame.frameConstants			= frameBlock.dynamicOffset;
+
+			ObjectConstants* fallbackConstants = static_cast< ObjectConstants* >(fallbackBlock.mapped);
+			for (uint32_t c = 0; c < 4; c++) {
+
+				fallbackConstants->tint[c] = 1.0f;
+
+			}
+			frame.fallbackObject = fallbackBlock.dynamicOffset;
+
+		}
+
+		/*
+		*	Function:		void vulkan::updateInstances(FrameResources &frame)
+		*	Purpose:		Animates the instances and copies them into the frame's transient pool, which is persistently
+		*					mapped, so the MAX_FRAMES_IN_FLIGHT pools form a ring the GPU reads while the CPU writes the next slot
+		*
+		*/
+		void updateInstances(FrameResources &frame) {
+
+			auto updateStart = std::chrono::high_resolution_clock::now();
+
+			// Derived from the frame number, not the clock, so captured frames are reproducible
+			for (uint32_t i = 0; i < instancesPerFrame; i++) {
+
+				instances[i].transform[3] = INSTANCE_SPIN * (frameNumber + i);
+
+			}
+
+			// The culling shader reads the instances as a storage buffer
+			VkDeviceSize instanceBytes = instancesPerFrame * sizeof(InstanceData);
+			VkDeviceSize alignment = std::max(static_cast< VkDeviceSize >(sizeof(float)), deviceSelector.capabilities().properties.limits.minStorageBufferOffsetAlignment);
+			if (!memoryAllocator.allocateLinear(frame.transientPool, instanceBytes, alignment, frame.instances)) {
+
+				LOG_ERROR(logger, "Transient pool too small for {} bytes of instances", instanceBytes);
+				throw std::runtime_error("Transient pool too small for the instances");
+
+			}
+
+			// One sequential copy suits write-combined memory better than scattered writes
+			memcpy(frame.instances.mapped, instances.data(), static_cast< size_t >(instanceBytes));
+			result = memoryAllocator.flushLinear(frame.transientPool, frame.instances);
+			ASSERT_VULKAN(result);
+
+			if (gpuCulling) {
+
+				gpuCuller.setInstances(currentFrame, frame.instances.buffer, frame.instances.offset, frame.instances.size);
+
+			}
+
+			// The element covers the whole pool, it is only rewritten if the pool hands out another buffer
+			if (bindless && frame.bindlessBuffer != frame.instances.buffer) {
+
+				if (frame.bindlessInstances == BINDLESS_INVALID) {
+
+					frame.bindlessInstances = bindlessSet.addBuffer(frame.instances.buffer, 0, VK_WHOLE_SIZE);
+					if (frame.bindlessInstances == BINDLESS_INVALID) {
+
+						LOG_ERROR(logger, "Bindless set has no room for the instances of frame {}", currentFrame);
+						throw std::runtime_error("Bindless set full");
+
+					}
+
+				}
+				else {
+
+					bindlessSet.updateBuffer(frame.bindlessInstances, frame.instances.buffer, 0, VK_WHOLE_SIZE);
+
+				}
+				frame.bindlessBuffer = frame.instances.buffer;
+
+			}
+
+			instanceStats.frames++;
+			instanceStats.updateMs += std::chrono::duration< double, std::milli >(std::chrono::high_resolution_clock::now() - updateStart).count();
+
+		}
+
+		/*
+		*	Function:		VkShaderModule vulkan::loadShader(const std::string &filename)
+		*	Purpose:		Returns the shader module of a SPIR-V file, mapped and created once by the shader library
+		*
+		*/
+		VkShaderModule loadShader(const std::string &filename) {
+
+			VkShaderModule shaderModule;
+			result = shaderLibrary.load(filename, shaderModule);
+			if (result != VK_SUCCESS) {
+
+				LOG_ERROR(logger, "{}", shaderLibrary.lastError());
+				throw std::runtime_error(shaderLibrary.lastError());
+
+			}
+
+			return shaderModule;
+
+		}
+
+		/*
+		*	Function:		void vulkan::shutdownVulkan()
+		*	Purpose:		Handles main shutdown of the VULKAN API
+		*
+		*/
+		void shutdownVulkan() {
+
+			LOG_START_STOP(vulkan::logger, "Shutdown initialized...");
+
+			result = vkDeviceWaitIdle(logicalDevice);
+			ASSERT_VULKAN(result);
+
+			destroyRetiredSwapchains(true);
+			if (!headless) {
+
+				LOG_EVENT(logger, "Swapchain recreated {} times", swapchainRecreations);
+
+			}
+
+			// Workers may still read from mapped readback buffers
+			delete threadPool;
+			threadPool = nullptr;
+
+			MemoryStatistics memoryStatistics = memoryAllocator.statistics();
+			LOG_EVENT(
+
+				logger,
+				"Device memory: {} of {} allocations, {} blocks ({} idle), {} dedicated, {} resources, {} of {} bytes used, largest free range {} bytes, fragmentation {}, linear pools {} bytes (peak {})",
+				memoryStatistics.deviceMemoryAllocations,
+				memoryStatistics.maxDeviceMemoryAllocations,
+				memoryStatistics.blocks,
+				memoryStatistics.idleBlocks,
+				memoryStatistics.dedicatedAllocations,
+				memoryStatistics.allocations,
+				memoryStatistics.usedBytes,
+				memoryStatistics.reservedBytes,
+				memoryStatistics.largestFreeRange,
+				memoryStatistics.fragmentation,
+				memoryStatistics.linearBytes,
+				memoryStatistics.linearPeakBytes
+
+			);
+
+#if PROFILER_ENABLED
+			if (profiler.exportChromeTrace(PROFILE_TRACE_FILE) && profiler.exportSummary(PROFILE_SUMMARY_FILE)) {
+
+				LOG_EVENT(logger, "Profile written to {} and {}", PROFILE_TRACE_FILE, PROFILE_SUMMARY_FILE);
+
+			}
+			else {
+
+				LOG_ERROR(logger, "Failed to write profile to {} and {}", PROFILE_TRACE_FILE, PROFILE_SUMMARY_FILE);
+
+			}
+#endif
+			profiler.destroyGpuQueries();
+
+			result = pipelineCache.save();
+			if (result == VK_SUCCESS) {
+
+				LOG_EVENT(logger, "Pipeline cache: {}", pipelineCache.status());
+
+			}
+			else {
+
+				LOG_ERROR(logger, "Pipeline cache could not be saved: {}", pipelineCache.status());
+
+			}
+			pipelineCache.destroy();
+
+			if (headless && !captureDirectory.empty()) {
+
+				for (unsigned int i = 0; i < READBACK_BUFFER_COUNT; i++) {
+
+					memoryAllocator.destroyBuffer(readbackBuffers[i].buffer, readbackBuffers[i].allocation);
+
+				}
+
+			}
+
+			for (unsigned int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+
+				vkDestroySemaphore(logicalDevice, frames[i].imageAvailable, hostAllocator.callbacks());
+				vkDestroySemaphore(logicalDevice, frames[i].renderingFinished, hostAllocator.callbacks());
+				vkDestroyFence(logicalDevice, frames[i].inFlight, hostAllocator.callbacks());
+
+				vkFreeCommandBuffers(
+					
+					logicalDevice,
+					commandPool, 
+					1,
+					&frames[i].commandBuffer
+
+				);
+
+			}
+			delete[] imagesInFlight;
+
+			commandRecorder.destroy();
+
+			vkDestroyCommandPool(
+				
+				logicalDevice,
+				commandPool, 
+				hostAllocator.callbacks());
+
+			for (size_t i = 0; i < amountOfImagesInSwapchain; i++) {
+			
+				vkDestroyFramebuffer(
+				
+					logicalDevice,
+					framebuffers[i],
+					hostAllocator.callbacks()
+				
+				);
+			
+			}
+			delete[] framebuffers;
+
+			pipelineBuilder.destroy();
+			variantPipelines.clear();
+
+			triangleGeometry.destroy();
+			if (gpuCulling) {
+
+				gpuCuller.destroy();
+
+			}
+			for (unsigned int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+
+				stagingBuffer.recycle(frames[i].uploadSemaphores);
+
+			}
+			stagingBuffer.destroy();
+
+			renderGraph.destroy();
+
+			for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+			
+				vkDestroyImageView(
+				
+					logicalDevice,
+					imageViews[i],
+					hostAllocator.callbacks()
+				
+				);
+			
+			}
+			delete[] imageViews;
+
+			vkDestroyPipelineLayout(
+			
+				logicalDevice,
+				pipelineLayout,
+				hostAllocator.callbacks()
+			
+			);
+
+			LOG_EVENT(logger, "Descriptors: {} pools, {} sets allocated, {} layouts, {} layout requests served from the cache", descriptorAllocator.amountOfPools(), descriptorAllocator.amountOfSets(), descriptorLayoutCache.amountOfLayouts(), descriptorLayoutCache.amountOfHits());
+			if (bindless) {
+
+				bindlessSet.destroy();
+
+			}
+			uniformRing.destroy();
+			descriptorAllocator.destroy();
+			descriptorLayoutCache.destroy();
+
+			LOG_EVENT(logger, "Shader library: {} modules, {} loads served from the library", shaderLibrary.amountOfModules(), shaderLibrary.amountOfHits());
+			shaderLibrary.destroy();
+
+			if (headless) {
+
+				for (unsigned int i = 0; i < amountOfImagesInSwapchain; i++) {
+
+					memoryAllocator.destroyImage(offscreenImages[i], offscreenImageMemory[i]);
+
+				}
+				delete[] offscreenImages;
+				delete[] offscreenImageMemory;
+
+			}
+			else {
+
+				vkDestroySwapchainKHR(
+					
+					logicalDevice, 
+					swapchain, 
+					hostAllocator.callbacks()
+				
+				);
+
+			}
+			uint32_t leakedAllocations = memoryAllocator.destroy();
+			if (leakedAllocations > 0) {
+
+				LOG_ERROR(logger, "{} device memory allocations were never freed", leakedAllocations);
+
+			}
+			vkDestroyDevice(logicalDevice, hostAllocator.callbacks());
+			if (!headless) {
+
+				vkDestroySurfaceKHR(
+
+					instance,
+					surface,
+					hostAllocator.callbacks()
+
+				);
+
+			}
+			vkDestroyInstance(instance, hostAllocator.callbacks());
+			delete[] vulkan::physicalDevices;
+			delete[] vulkan::layers;
+			delete[] vulkan::extensions;
+
+			HostStatistics hostStatistics = hostAllocator.statistics();
+			for (uint32_t i = 0; i < HOST_ALLOCATOR_SCOPES; i++) {
+
+				const HostScopeStatistics &scope = hostStatistics.scopes[i];
+				LOG_EVENT(logger, "Host scope {}: {} allocations, {} KiB peak, {} KiB internal", HostAllocator::scopeName(i), scope.allocations, scope.peakBytes / 1024, scope.internalBytes / 1024);
+
+			}
+			LOG_EVENT(logger, "Host allocator: {} KiB peak, {} KiB pooled, {} large allocations", hostStatistics.peakBytes / 1024, hostStatistics.pooledBytes / 1024, hostStatistics.largeAllocations);
+			if (hostStatistics.liveBytes > 0) {
+
+				LOG_ERROR(logger, "{} bytes of driver host memory were never freed", hostStatistics.liveBytes);
+
+			}
+
+			LOG_START_STOP(vulkan::logger, "Shutdown complete");
+			vulkan::logger.stop();
+
+		}
+
+		/*
+		*	Struct:			vulkan::FrameStats
+		*	Purpose:		Accumulates how well CPU recording overlaps GPU execution
+		*
+		*/
+		struct FrameStats {
+
+			uint32_t	frames;
+			uint32_t	framesGpuBusy;			// Frames recorded while the previous frame was still executing
+			double		fenceWaitMs;			// CPU time blocked on frame and image fences
+			double		frameMs;				// Total CPU time spent in drawFrame
+			uint64_t	hostAllocations;		// Driver host allocations, counted by hostAllocator
+
+		};
+		FrameStats frameStats = {};
+
+		/*
+		*	Function:		vulkan::drawFrame()
+		*	Purpose:		Renders a frame to the screen, up to MAX_FRAMES_IN_FLIGHT frames are queued
+		*
+		*/
+		void drawFrame() {
+
+			auto frameStart = std::chrono::high_resolution_clock::now();
+			uint64_t hostAllocationsStart = hostAllocator.amountOfAllocations();
+			FrameResources &frame = frames[currentFrame];
+
+			profiler.beginFrame(frameNumber);
+			PROFILE_PHASE(profiler, phase, "frame: wait frame fence");
+
+			result = vkWaitForFences(
+			
+				logicalDevice,
+				1,
+				&frame.inFlight,
+				VK_TRUE,
+				std::numeric_limits< uint64_t >::max()
+			
+			);
+			ASSERT_VULKAN(result);
+
+			// The timestamps and the copy recorded MAX_FRAMES_IN_FLIGHT frames ago are complete
+			profiler.collectGpuFrame(currentFrame);
+			uint32_t visibleObjects = 0;
+			if (gpuCulling && gpuCuller.visibleObjects(currentFrame, visibleObjects)) {
+
+				cullStats.frames++;
+				cullStats.visible += visibleObjects;
+
+			}
+			memoryAllocator.resetLinearPool(frame.transientPool);
+			result = descriptorAllocator.reset(currentFrame);
+			ASSERT_VULKAN(result);
+			stagingBuffer.recycle(frame.uploadSemaphores);
+			destroyRetiredSwapchains(false);
+
+			// Encode the copied frame while this frame renders
+			if (frame.readback >= 0) {
+
+				retireReadbackBuffer(frame.readback);
+				frame.readback = -1;
+
+			}
+		
+			// Headless mode owns one offscreen image per frame in flight
+			uint32_t imageIndex = currentFrame % amountOfImagesInSwapchain;
+			bool recreate = false;
+			if (!headless) {
+
+				PROFILE_NEXT(phase, "frame: acquire");
+				result = vkAcquireNextImageKHR(
+				
+					logicalDevice,
+					swapchain,
+					std::numeric_limits< uint64_t >::max(),
+					frame.imageAvailable,
+					VK_NULL_HANDLE,
+					&imageIndex
+				
+				);
+
+				// Nothing was acquired and the frame fence is still signaled, the frame is retried on the new swapchain
+				if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+
+					recreateSwapchain();
+					return;
+
+				}
+
+				// A suboptimal swapchain still signals imageAvailable, the image is presented before recreating
+				if (result == VK_SUBOPTIMAL_KHR) {
+
+					recreate = true;
+
+				}
+				else {
+
+					ASSERT_VULKAN(result);
+
+				}
+
+			}
+
+			// The image may still be rendered to by an older frame if the swapchain hands images out of order
+			PROFILE_NEXT(phase, "frame: wait image fence");
+			if (imagesInFlight[imageIndex] != VK_NULL_HANDLE) {
+
+				result = vkWaitForFences(
+				
+					logicalDevice,
+					1,
+					&imagesInFlight[imageIndex],
+					VK_TRUE,
+					std::numeric_limits< uint64_t >::max()
+				
+				);
+				ASSERT_VULKAN(result);
+
+			}
+			imagesInFlight[imageIndex] = frame.inFlight;
+
+			auto waitEnd = std::chrono::high_resolution_clock::now();
+
+			const FrameResources &previousFrame = frames[(currentFrame + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT];
+			if (vkGetFenceStatus(logicalDevice, previousFrame.inFlight) == VK_NOT_READY) {
+
+				frameStats.framesGpuBusy++;
+
+			}
+
+			result = vkResetFences(logicalDevice, 1, &frame.inFlight);
+			ASSERT_VULKAN(result);
+
+			PROFILE_NEXT(phase, "frame: update instances");
+			updateInstances(frame);
+			updateUniforms(frame);
+
+			PROFILE_NEXT(phase, "frame: record");
+
+			VkBuffer readbackBuffer = VK_NULL_HANDLE;
+			if (headless && !captureDirectory.empty()) {
+
+				frame.readback = acquireReadbackBuffer();
+				readbackBuffer = readbackBuffers[frame.readback].buffer;
+
+			}
+
+			result = vkResetCommandBuffer(frame.commandBuffer, 0);
+			ASSERT_VULKAN(result);
+			result = commandRecorder.reset(currentFrame);
+			ASSERT_VULKAN(result);
+			recordCommandBuffer(frame.commandBuffer, imageIndex, readbackBuffer);
+
+			// The recording threads wrote the per-draw blocks
+			result = uniformRing.flush();
+			ASSERT_VULKAN(result);
+
+			PROFILE_NEXT(phase, "frame: submit");
+
+			std::vector< VkSemaphore > waitSemaphores;
+			std::vector< VkPipelineStageFlags > waitStageMask;
+			if (!headless) {
+
+				waitSemaphores.push_back(frame.imageAvailable);
+				waitStageMask.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+			}
+			waitSemaphores.insert(waitSemaphores.end(), frame.uploadSemaphores.begin(), frame.uploadSemaphores.end());
+			waitStageMask.resize(waitSemaphores.size(), STAGING_CONSUMER_STAGES);
+
+			VkSubmitInfo submitInfo;
+			submitInfo.sType						= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.pNext						= nullptr;
+			submitInfo.waitSemaphoreCount			= static_cast< uint32_t >(waitSemaphores.size());
+			submitInfo.pWaitSemaphores				= waitSemaphores.data();
+			submitInfo.pWaitDstStageMask			= waitStageMask.data();
+			submitInfo.commandBufferCount			= 1;
+			submitInfo.pCommandBuffers				= &frame.commandBuffer;
+			submitInfo.signalSemaphoreCount			= headless ? 0 : 1;
+			submitInfo.pSignalSemaphores			= &frame.renderingFinished;
+
+			result = vkQueueSubmit(
+			
+				queue, 
+				1,
+				&submitInfo, 
+				frame.inFlight
+			
+			);
+			ASSERT_VULKAN(result);
+
+			if (!headless) {
+
+				PROFILE_NEXT(phase, "frame: present");
+
+				VkPresentInfoKHR presentInfo;
+				presentInfo.sType					= VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+				presentInfo.pNext					= nullptr;
+				presentInfo.waitSemaphoreCount		= 1;
+				presentInfo.pWaitSemaphores			= &frame.renderingFinished;
+				presentInfo.swapchainCount			= 1;
+				presentInfo.pSwapchains				= &swapchain;
+				presentInfo.pImageIndices			= &imageIndex;
+				presentInfo.pResults				= nullptr;
+
+				result = vkQueuePresentKHR(
+				
+					queue,
+					&presentInfo
+				
+				);
+				if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
+
+					recreate = true;
+
+				}
+				else {
+
+					ASSERT_VULKAN(result);
+
+				}
+
+			}
+
+			profiler.endFrame();
+			currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+			frameNumber++;
+
+			auto frameEnd = std::chrono::high_resolution_clock::now();
+			frameStats.frames++;
+			frameStats.fenceWaitMs	+= std::chrono::duration< double, std::milli >(waitEnd - frameStart).count();
+			frameStats.frameMs		+= std::chrono::duration< double, std::milli >(frameEnd - frameStart).count();
+
+			// Recording workers allocate through the same callbacks, their allocations count towards this frame
+			uint64_t hostAllocations = hostAllocator.amountOfAllocations() - hostAllocationsStart;
+			frameStats.hostAllocations	+= hostAllocations;
+			hostStats.frames++;
+			hostStats.allocations		+= hostAllocations;
+			if (hostAllocations > 0 && frameNumber > MAX_FRAMES_IN_FLIGHT) {
+
+				hostStats.framesAllocating++;
+
+			}
+
+			if (frameStats.frames == FRAME_STATS_INTERVAL) {
+
+				LOG_EVENT(
+
+					logger,
+					"Frames in flight: {}, GPU busy while recording: {}%, avg CPU frame: {} ms, avg fence wait: {} ms, host allocations per frame: {}",
+					MAX_FRAMES_IN_FLIGHT,
+					100.0 * frameStats.framesGpuBusy / frameStats.frames,
+					frameStats.frameMs / frameStats.frames,
+					frameStats.fenceWaitMs / frameStats.frames,
+					static_cast< double >(frameStats.hostAllocations) / frameStats.frames
+
+				);
+				frameStats = {};
+
+			}
+
+			if (frameNumber == 1) {
+
+				LOG_START_STOP(logger, "Time to first frame: {} ms", std::chrono::duration< double, std::milli >(frameEnd - startupTime).count());
+
+			}
+
+			// After frameNumber++ so the retired swapchain counts the frame just presented as one of its users
+			if (recreate) {
+
+				recreateSwapchain();
+
+			}
+
+		}
+
+		/*
+		*	Function:		void vulkan::headlessLoop()
+		*	Purpose:		Frame loop without window, renders headlessFrames frames and reports the throughput
+		*
+		*/
+		void headlessLoop() {
+
+			LOG_START_STOP(logger, "Headless rendering of {} frames started", headlessFrames);
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			for (unsigned int i = 0; i < headlessFrames; i++) {
+
+				drawFrame();
+
+			}
+
+			result = vkDeviceWaitIdle(logicalDevice);
+			ASSERT_VULKAN(result);
+
+			// The last frames in flight still hold their copies, the time includes writing every captured frame
+			for (unsigned int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+
+				if (frames[i].readback >= 0) {
+
+					retireReadbackBuffer(frames[i].readback);
+					frames[i].readback = -1;
+
+				}
+
+			}
+			threadPool->waitIdle();
+
+			double seconds = std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - start).count();
+
+			LOG_START_STOP(
+
+				logger,
+				"Headless rendering finished: {} frames in {} s, {} frames/s at {}x{}",
+				headlessFrames,
+				seconds,
+				seconds > 0.0 ? headlessFrames / seconds : 0.0,
+				WINDOW_WIDTH,
+				WINDOW_HEIGHT
+
+			);
+			std::cout << "Headless: " << headlessFrames << " frames in " << seconds << " s ("
+				<< (seconds > 0.0 ? headlessFrames / seconds : 0.0) << " frames/s)" << std::endl;
+
+			double recordMsPerFrame = recordStats.frames > 0 ? recordStats.recordMs / recordStats.frames : 0.0;
+			double drawsPerSecond = recordStats.recordMs > 0.0 ? recordStats.draws / (recordStats.recordMs / 1000.0) : 0.0;
+			LOG_START_STOP(
+
+				logger,
+				"Recording: {} draws per frame on {} threads, {} ms per frame, {} draws/s",
+				drawsPerFrame,
+				commandRecorder.amountOfThreads(),
+				recordMsPerFrame,
+				drawsPerSecond
+
+			);
+			std::cout << "Recording: " << drawsPerFrame << " draws per frame on " << commandRecorder.amountOfThreads() << " threads, "
+				<< recordMsPerFrame << " ms per frame (" << drawsPerSecond << " draws/s)" << std::endl;
+
+			double instancesPerSecond = seconds > 0.0 ? static_cast< double >(instancesPerFrame) * headlessFrames / seconds : 0.0;
+			double updateMsPerFrame = instanceStats.frames > 0 ? instanceStats.updateMs / instanceStats.frames : 0.0;
+			LOG_START_STOP(
+
+				logger,
+				"Instancing: {} instances per frame in {} draws, {} instances/s, {} ms per frame updating the ring",
+				instancesPerFrame,
+				drawsPerFrame,
+				instancesPerSecond,
+				updateMsPerFrame
+
+			);
+			std::cout << "Instancing: " << instancesPerFrame << " instances per frame in " << drawsPerFrame << " draws, "
+				<< instancesPerSecond << " instances/s, " << updateMsPerFrame << " ms per frame updating the ring" << std::endl;
+
+			double blocksPerFrame = headlessFrames > 0 ? static_cast< double >(uniformRing.amountOfAllocations()) / headlessFrames : 0.0;
+			LOG_START_STOP(
+
+				logger,
+				"Uniforms: {} blocks per frame, {} of {} KiB peak per frame, {} blocks fell back to the shared one",
+				blocksPerFrame,
+				uniformRing.peakBytes() / 1024,
+				uniformRing.regionSize() / 1024,
+				uniformRing.amountOfOverflows()
+
+			);
+			std::cout << "Uniforms: " << blocksPerFrame << " blocks per frame, " << uniformRing.peakBytes() / 1024 << " of "
+				<< uniformRing.regionSize() / 1024 << " KiB peak per frame, " << uniformRing.amountOfOverflows() << " overflows" << std::endl;
+
+			if (gpuCulling) {
+
+				double visiblePerFrame = cullStats.frames > 0 ? static_cast< double >(cullStats.visible) / cullStats.frames : 0.0;
+				LOG_START_STOP(
+
+					logger,
+					"GPU culling: {} of {} objects visible on average, {}",
+					visiblePerFrame,
+					instancesPerFrame,
+					indirectMode == INDIRECT_MODE_COUNT ? "count draw" : "multi draw"
+
+				);
+				std::cout << "GPU culling: " << visiblePerFrame << " of " << instancesPerFrame << " objects visible on average ("
+					<< (indirectMode == INDIRECT_MODE_COUNT ? "count draw" : "multi draw") << ")" << std::endl;
+
+			}
+
+			HostStatistics hostStatistics = hostAllocator.statistics();
+			double hostAllocationsPerFrame = hostStats.frames > 0 ? static_cast< double >(hostStats.allocations) / hostStats.frames : 0.0;
+			LOG_START_STOP(
+
+				logger,
+				"Host memory: {} KiB after startup, {} KiB after the frame loop, {} KiB peak, {} allocations per frame, {} frames allocated after the first {}",
+				hostBytesAfterStartup / 1024,
+				hostStatistics.liveBytes / 1024,
+				hostStatistics.peakBytes / 1024,
+				hostAllocationsPerFrame,
+				hostStats.framesAllocating,
+				MAX_FRAMES_IN_FLIGHT
+
+			);
+			std::cout << "Host memory: " << hostBytesAfterStartup / 1024 << " KiB after startup, " << hostStatistics.liveBytes / 1024 << " KiB after the frame loop, "
+				<< hostStatistics.peakBytes / 1024 << " KiB peak, " << hostAllocationsPerFrame << " allocations per frame, "
+				<< hostStats.framesAllocating << " frames allocating after the first " << MAX_FRAMES_IN_FLIGHT << std::endl;
+
+			if (!captureDirectory.empty()) {
+
+				LOG_START_STOP(
+
+					logger,
+					"Captured {} frames with {} encoding workers, {} stalls waiting for a readback buffer ({} ms)",
+					readbackStats.framesCaptured,
+					threadPool->size(),
+					readbackStats.stalls,
+					readbackStats.stallMs
+
+				);
+
+			}
+
+		}
+
+	}
+
+	/*
+	*	Namespace:		glfw
+	*	Purpose:		Differenciate GLFW from VULKAN
+	*
+	*/
+	namespace glfw {
+
+		/*
+		*	Function:		void glfw::init()
+		*	Purpose:		Handles GLFW-Initialization
+		*
+		*/
+		void init() {
+
+			glfwInit();
+			glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+			glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+		}
+
+		/*
+		*	Function:		void glfw::createWindow()
+		*	Purpose:		Creates the window and registers its callbacks
+		*
+		*/
+		void createWindow() {
+
+			window = glfwCreateWindow(
+				
+				WINDOW_WIDTH,
+				WINDOW_HEIGHT, 
+				TITLE, 
+				nullptr, 
+				nullptr
+			
+			);
+			glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+
+		}
+
+		/*
+		*	Function:		void glfw::framebufferSizeCallback(GLFWwindow* window, int width, int height)
+		*	Purpose:		Flags the swapchain for recreation, some platforms resize without VK_ERROR_OUT_OF_DATE_KHR
+		*
+		*/
+		void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+
+			framebufferResized = true;
+
+		}
+
+		/*
+		*	Function:		void glfw::gameLoop()
+		*	Purpose:		Contains the main game loop
+		*
+		*/
+		void gameLoop() {
+
+			while (!glfwWindowShouldClose(window)) {
+
+				{
+
+					PROFILE_SCOPE(vulkan::profiler, "frame: glfwPollEvents");
+					glfwPollEvents();
+
+				}
+				vulkan::drawFrame();
+
+			}
+
+		}
+
+		/*
+		*	Function:		void glfw::shutdownGLFW()
+		*	Purpose:		Handles main shutdown of GLFW
+		*
+		*/
+		void shutdownGLFW() {
+
+			glfwDestroyWindow(window);
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		int main(int argc, char** argv)
+*	Purpose:		Entry point for the application
+*					--headless renders offscreen without window, --frames N sets the headless frame count
+*					--capture DIR writes every headless frame to DIR, --capture-format raw|png
+*					--pipeline-variants compiles a matrix of pipeline variants at startup
+*					--draws N records N draws per frame on --record-threads N threads, a recording benchmark
+*					--present-mode fifo|relaxed|mailbox|immediate trades tearing and power for latency
+*					--instances N spreads N instances over the draws, an instancing benchmark with --headless
+*					--gpu-culling culls the instances in a compute shader and draws them indirectly
+*					--bindless reads the instances through one VK_EXT_descriptor_indexing set instead of a vertex buffer
+*					--msaa N renders N samples per pixel into a transient attachment resolved into the target
+*					--grayscale and --posterize N select fragment shader permutations through specialization constants
+*					--dynamic-rendering sets viewport and scissor per frame and renders with VK_KHR_dynamic_rendering
+*					where the device supports it, so resizes rebuild neither pipelines nor framebuffers
+*
+*/
+int main(int argc, char** argv) {
+
+	game::startupTime = std::chrono::high_resolution_clock::now();
+
+	for (int i = 1; i < argc; i++) {
+
+		if (strcmp(argv[i], "--headless") == 0) {
+
+			game::headless = true;
+
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+
+			game::headlessFrames = static_cast< unsigned int >(strtoul(argv[++i], nullptr, 10));
+
+		}
+		else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+
+			game::captureDirectory = argv[++i];
+
+		}
+		else if (strcmp(argv[i], "--capture-format") == 0 && i + 1 < argc) {
+
+			game::captureFormat = strcmp(argv[++i], "raw") == 0 ? FRAME_FORMAT_RAW : FRAME_FORMAT_PNG;
+
+		}
+		else if (strcmp(argv[i], "--pipeline-variants") == 0) {
+
+			game::pipelineVariants = true;
+
+		}
+		else if (strcmp(argv[i], "--draws") == 0 && i + 1 < argc) {
+
+			game::drawsPerFrame = static_cast< unsigned int >(strtoul(argv[++i], nullptr, 10));
+
+		}
+		else if (strcmp(argv[i], "--record-threads") == 0 && i + 1 < argc) {
+
+			game::recordThreads = static_cast< unsigned int >(strtoul(argv[++i], nullptr, 10));
+
+		}
+		else if (strcmp(argv[i], "--instances") == 0 && i + 1 < argc) {
+
+			game::instancesPerFrame = static_cast< unsigned int >(strtoul(argv[++i], nullptr, 10));
+
+		}
+		else if (strcmp(argv[i], "--gpu-culling") == 0) {
+
+			game::gpuCulling = true;
+
+		}
+		else if (strcmp(argv[i], "--bindless") == 0) {
+
+			game::bindless = true;
+
+		}
+		else if (strcmp(argv[i], "--msaa") == 0 && i + 1 < argc) {
+
+			// A power of two up to 64, deviceCreateInfo lowers it to what the device supports
+			unsigned long samples = strtoul(argv[++i], nullptr, 10);
+			game::msaaSamples = samples > 0 && samples <= 64 && (samples & (samples - 1)) == 0 ? static_cast< VkSampleCountFlagBits >(samples) : VK_SAMPLE_COUNT_1_BIT;
+
+		}
+		else if (strcmp(argv[i], "--grayscale") == 0) {
+
+			game::grayscale = true;
+
+		}
+		else if (strcmp(argv[i], "--posterize") == 0 && i + 1 < argc) {
+
+			game::posterizeLevels = strtoul(argv[++i], nullptr, 10);
+
+		}
+		else if (strcmp(argv[i], "--dynamic-rendering") == 0) {
+
+			game::dynamicViewport	= true;
+			game::dynamicRendering	= true;
+
+		}
+		else if (strcmp(argv[i], "--present-mode") == 0 && i + 1 < argc) {
+
+			const char* mode = argv[++i];
+			if (strcmp(mode, "mailbox") == 0) {
+
+				game::presentModePolicy = VK_PRESENT_MODE_MAILBOX_KHR;
+
+			}
+			else if (strcmp(mode, "immediate") == 0) {
+
+				game::presentModePolicy = VK_PRESENT_MODE_IMMEDIATE_KHR;
+
+			}
+			else if (strcmp(mode, "relaxed") == 0) {
+
+				game::presentModePolicy = VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+
+			}
+			else {
+
+				game::presentModePolicy = VK_PRESENT_MODE_FIFO_KHR;
+
+			}
+
+		}
+
+	}
+
+	if (game::headless) {
+
+		game::vulkan::init();
+		game::vulkan::headlessLoop();
+		game::vulkan::shutdownVulkan();
+
+		return 0;
+
+	}
+
+	game::vulkan::init();
+	game::glfw::gameLoop();
+	game::vulkan::shutdownVulkan();
+	game::glfw::shutdownGLFW();
+
+	return 0;
+
 }
\ No newline at end of file
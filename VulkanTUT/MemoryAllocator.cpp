@@ -0,0 +1,906 @@
+/*
+*	File:			MemoryAllocator.cpp
+*	Purpose:		Contains functions for class MemoryAllocator
+*
+*/
+#include "MemoryAllocator.hpp"
+#include <algorithm>
+
+/*
+*	Function:		static uint32_t countBits(uint32_t value)
+*	Purpose:		Returns the amount of set bits
+*
+*/
+static uint32_t countBits(uint32_t value) {
+
+	uint32_t bits = 0;
+	for (; value != 0; value &= value - 1) {
+
+		bits++;
+
+	}
+
+	return bits;
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+MemoryAllocator::MemoryAllocator() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	memoryProperties(),
+	atomSize(1),
+	maxAllocations(0),
+	deviceAllocations(0) {
+
+
+
+}
+
+/*
+*	Function:		void MemoryAllocator::create(VkDevice device, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator)
+*	Purpose:		Reads the memory types and heaps and sizes the blocks of every memory type
+*					allocator is passed to every memory allocation and every buffer and image create and destroy
+*
+*/
+void MemoryAllocator::create(VkDevice device_, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	atomSize		= properties.limits.nonCoherentAtomSize;
+	maxAllocations	= properties.limits.maxMemoryAllocationCount;
+
+	pools.resize(memoryProperties.memoryTypeCount * 2);
+	for (uint32_t i = 0; i < pools.size(); i++) {
+
+		Pool &pool = pools[i];
+		pool.memoryType = i / 2;
+
+		// Small heaps, e.g. the host visible window of device memory, must not be taken by a single block
+		VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[pool.memoryType].heapIndex].size;
+		pool.blockSize = MEMORY_BLOCK_SIZE;
+		while (pool.blockSize > MEMORY_MIN_ALLOCATION * 16 && pool.blockSize > heapSize / 8) {
+
+			pool.blockSize >>= 1;
+
+		}
+
+		pool.maxLevel = 0;
+		for (VkDeviceSize size = pool.blockSize; size > MEMORY_MIN_ALLOCATION; size >>= 1) {
+
+			pool.maxLevel++;
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		uint32_t MemoryAllocator::findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred)
+*	Purpose:		Returns the allowed memory type with all required properties that has the most preferred
+*					and the fewest unrequested properties, UINT32_MAX if no type has the required ones
+*
+*/
+uint32_t MemoryAllocator::findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) const {
+
+	uint32_t best		= UINT32_MAX;
+	int bestScore		= 0;
+	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+
+		VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[i].propertyFlags;
+		if (!(memoryTypeBits & (1u << i)) || (flags & required) != required) {
+
+			continue;
+
+		}
+
+		int score = 4 * static_cast< int >(countBits(flags & preferred)) - static_cast< int >(countBits(flags & ~(required | preferred)));
+		if (best == UINT32_MAX || score > bestScore) {
+
+			best		= i;
+			bestScore	= score;
+
+		}
+
+	}
+
+	return best;
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, bool optimalTiling, MemoryAllocation &allocation)
+*	Purpose:		Reserves memory for a resource, a buddy of a block or a dedicated allocation if the
+*					resource exceeds half a block, a new block is only allocated if no block has room
+*
+*/
+VkResult MemoryAllocator::allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, bool optimalTiling, MemoryAllocation &allocation) {
+
+	uint32_t memoryType = findMemoryType(memoryRequirements.memoryTypeBits, required, preferred);
+	if (memoryType == UINT32_MAX) {
+
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+	}
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	allocation.memoryType	= memoryType;
+	allocation.userData		= nullptr;
+
+	int32_t poolIndex = static_cast< int32_t >(memoryType * 2 + (optimalTiling ? 1 : 0));
+	Pool &pool = pools[poolIndex];
+
+	VkDeviceSize needed = MEMORY_MIN_ALLOCATION;
+	while (needed < memoryRequirements.size || needed < memoryRequirements.alignment) {
+
+		needed <<= 1;
+
+	}
+
+	if (needed > pool.blockSize / 2) {
+
+		VkResult result = allocateDeviceMemory(memoryType, memoryRequirements.size, allocation.memory, allocation.mapped);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		allocation.offset		= 0;
+		allocation.size			= memoryRequirements.size;
+		allocation.pool			= MEMORY_POOL_DEDICATED;
+		allocation.block		= -1;
+		dedicated[allocation.memory] = memoryRequirements.size;
+
+		return VK_SUCCESS;
+
+	}
+
+	uint32_t level = 0;
+	for (VkDeviceSize size = pool.blockSize; size > needed; size >>= 1) {
+
+		level++;
+
+	}
+
+	// Buddies are aligned to their own size, which covers the alignment requirement
+	VkDeviceSize offset = 0;
+	int32_t blockIndex = -1;
+	for (size_t i = 0; i < pool.blocks.size() && blockIndex < 0; i++) {
+
+		if (pool.blocks[i] != nullptr && takeBuddy(pool, *pool.blocks[i], level, offset)) {
+
+			blockIndex = static_cast< int32_t >(i);
+
+		}
+
+	}
+
+	if (blockIndex < 0) {
+
+		Block* block = new Block();
+		VkResult result = allocateDeviceMemory(memoryType, pool.blockSize, block->memory, block->mapped);
+		if (result != VK_SUCCESS) {
+
+			delete block;
+			return result;
+
+		}
+		block->used = 0;
+		block->freeLists.resize(pool.maxLevel + 1);
+		block->freeLists[0].insert(0);
+
+		auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+		if (slot == pool.blocks.end()) {
+
+			slot = pool.blocks.insert(pool.blocks.end(), block);
+
+		}
+		*slot = block;
+		blockIndex = static_cast< int32_t >(slot - pool.blocks.begin());
+
+		takeBuddy(pool, *block, level, offset);
+
+	}
+
+	Block &block = *pool.blocks[blockIndex];
+	allocation.memory	= block.memory;
+	allocation.offset	= offset;
+	allocation.size		= pool.blockSize >> level;
+	allocation.mapped	= block.mapped != nullptr ? static_cast< uint8_t* >(block.mapped) + offset : nullptr;
+	allocation.pool		= poolIndex;
+	allocation.block	= blockIndex;
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void MemoryAllocator::free(const MemoryAllocation &allocation)
+*	Purpose:		Returns the memory, one empty block per pool is kept to absorb allocate/free cycles
+*
+*/
+void MemoryAllocator::free(const MemoryAllocation &allocation) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	if (allocation.pool == MEMORY_POOL_DEDICATED) {
+
+		dedicated.erase(allocation.memory);
+		freeDeviceMemory(allocation.memory, allocation.mapped != nullptr);
+		return;
+
+	}
+
+	Pool &pool = pools[allocation.pool];
+	Block* block = pool.blocks[allocation.block];
+	releaseBuddy(pool, *block, allocation.offset);
+
+	if (block->used == 0) {
+
+		for (size_t i = 0; i < pool.blocks.size(); i++) {
+
+			if (pool.blocks[i] != nullptr && pool.blocks[i] != block && pool.blocks[i]->used == 0) {
+
+				freeDeviceMemory(block->memory, block->mapped != nullptr);
+				delete block;
+				pool.blocks[allocation.block] = nullptr;
+				break;
+
+			}
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		void MemoryAllocator::setUserData(MemoryAllocation &allocation, void* userData)
+*	Purpose:		Stores the owner of an allocation, defragment() passes it back in the moved allocations
+*
+*/
+void MemoryAllocator::setUserData(MemoryAllocation &allocation, void* userData) {
+
+	allocation.userData = userData;
+	if (allocation.pool == MEMORY_POOL_DEDICATED) {
+
+		return;
+
+	}
+
+	std::lock_guard< std::mutex > lock(mutex);
+	pools[allocation.pool].blocks[allocation.block]->owners[allocation.offset] = userData;
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::createBuffer(const VkBufferCreateInfo &bufferCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkBuffer &buffer, MemoryAllocation &allocation)
+*	Purpose:		Creates a buffer and binds it to freshly allocated memory
+*
+*/
+VkResult MemoryAllocator::createBuffer(const VkBufferCreateInfo &bufferCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkBuffer &buffer, MemoryAllocation &allocation) {
+
+	VkResult result = vkCreateBuffer(device, &bufferCreateInfo, allocationCallbacks, &buffer);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+	result = allocate(memoryRequirements, required, preferred, false, allocation);
+	if (result != VK_SUCCESS) {
+
+		vkDestroyBuffer(device, buffer, allocationCallbacks);
+		return result;
+
+	}
+
+	result = vkBindBufferMemory(device, buffer, allocation.memory, allocation.offset);
+	if (result != VK_SUCCESS) {
+
+		destroyBuffer(buffer, allocation);
+
+	}
+
+	return result;
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::createImage(const VkImageCreateInfo &imageCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkImage &image, MemoryAllocation &allocation)
+*	Purpose:		Creates an image and binds it to freshly allocated memory
+*
+*/
+VkResult MemoryAllocator::createImage(const VkImageCreateInfo &imageCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkImage &image, MemoryAllocation &allocation) {
+
+	VkResult result = vkCreateImage(device, &imageCreateInfo, allocationCallbacks, &image);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkMemoryRequirements memoryRequirements;
+	vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+	result = allocate(memoryRequirements, required, preferred, imageCreateInfo.tiling == VK_IMAGE_TILING_OPTIMAL, allocation);
+	if (result != VK_SUCCESS) {
+
+		vkDestroyImage(device, image, allocationCallbacks);
+		return result;
+
+	}
+
+	result = vkBindImageMemory(device, image, allocation.memory, allocation.offset);
+	if (result != VK_SUCCESS) {
+
+		destroyImage(image, allocation);
+
+	}
+
+	return result;
+
+}
+
+void MemoryAllocator::destroyBuffer(VkBuffer buffer, const MemoryAllocation &allocation) {
+
+	vkDestroyBuffer(device, buffer, allocationCallbacks);
+	free(allocation);
+
+}
+
+void MemoryAllocator::destroyImage(VkImage image, const MemoryAllocation &allocation) {
+
+	vkDestroyImage(device, image, allocationCallbacks);
+	free(allocation);
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::flush(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Makes host writes to a range of the allocation visible to the device, no-op for coherent memory
+*
+*/
+VkResult MemoryAllocator::flush(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size) const {
+
+	if (allocation.mapped == nullptr || coherent(allocation)) {
+
+		return VK_SUCCESS;
+
+	}
+
+	VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+	return vkFlushMappedMemoryRanges(device, 1, &range);
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::invalidate(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Makes device writes to a range of the allocation visible to the host, no-op for coherent memory
+*
+*/
+VkResult MemoryAllocator::invalidate(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size) const {
+
+	if (allocation.mapped == nullptr || coherent(allocation)) {
+
+		return VK_SUCCESS;
+
+	}
+
+	VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+	return vkInvalidateMappedMemoryRanges(device, 1, &range);
+
+}
+
+bool MemoryAllocator::coherent(const MemoryAllocation &allocation) const {
+
+	return (memoryProperties.memoryTypes[allocation.memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::createLinearPool(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, uint32_t &linearPool)
+*	Purpose:		Creates a buffer for transient data that is handed out front to back until reset
+*
+*/
+VkResult MemoryAllocator::createLinearPool(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, uint32_t &linearPool) {
+
+	VkBufferCreateInfo bufferCreateInfo;
+	bufferCreateInfo.sType					= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.pNext					= nullptr;
+	bufferCreateInfo.flags					= 0;
+	bufferCreateInfo.size					= size;
+	bufferCreateInfo.usage					= usage;
+	bufferCreateInfo.sharingMode			= VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount	= 0;
+	bufferCreateInfo.pQueueFamilyIndices	= nullptr;
+
+	LinearPool pool;
+	VkResult result = createBuffer(bufferCreateInfo, required, preferred, pool.buffer, pool.allocation);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+	pool.capacity	= size;
+	pool.head		= 0;
+	pool.peak		= 0;
+
+	std::lock_guard< std::mutex > lock(mutex);
+	linearPool = static_cast< uint32_t >(linearPools.size());
+	linearPools.push_back(pool);
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		bool MemoryAllocator::allocateLinear(uint32_t linearPool, VkDeviceSize size, VkDeviceSize alignment, LinearAllocation &allocation)
+*	Purpose:		Takes the next aligned range of the pool, returns false if the pool is full
+*
+*/
+bool MemoryAllocator::allocateLinear(uint32_t linearPool, VkDeviceSize size, VkDeviceSize alignment, LinearAllocation &allocation) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	LinearPool &pool = linearPools[linearPool];
+	VkDeviceSize start = (pool.head + alignment - 1) / alignment * alignment;
+	if (start + size > pool.capacity) {
+
+		return false;
+
+	}
+
+	pool.head	= start + size;
+	pool.peak	= std::max(pool.peak, pool.head);
+
+	allocation.buffer	= pool.buffer;
+	allocation.offset	= start;
+	allocation.size		= size;
+	allocation.mapped	= pool.allocation.mapped != nullptr ? static_cast< uint8_t* >(pool.allocation.mapped) + start : nullptr;
+
+	return true;
+
+}
+
+VkResult MemoryAllocator::flushLinear(uint32_t linearPool, const LinearAllocation &allocation) const {
+
+	return flush(linearPools[linearPool].allocation, allocation.offset, allocation.size);
+
+}
+
+/*
+*	Function:		void MemoryAllocator::resetLinearPool(uint32_t linearPool)
+*	Purpose:		Makes the whole pool available again, the GPU must be done with its previous contents
+*
+*/
+void MemoryAllocator::resetLinearPool(uint32_t linearPool) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	linearPools[linearPool].head = 0;
+
+}
+
+/*
+*	Function:		uint32_t MemoryAllocator::defragment(const MoveFunction &move)
+*	Purpose:		Moves allocations out of sparsely used blocks into fuller blocks of the same pool and
+*					releases the blocks that end up empty, returns the amount of moved allocations
+*					move copies the contents and rebinds the owner (from.userData) to to.memory + to.offset,
+*					it runs under the allocator lock and must not call the allocator, returning false
+*					keeps the allocation where it is, the resources must not be in use by the GPU
+*
+*/
+uint32_t MemoryAllocator::defragment(const MoveFunction &move) {
+
+	uint32_t moved = 0;
+
+	{
+
+		std::lock_guard< std::mutex > lock(mutex);
+
+		for (uint32_t p = 0; p < pools.size(); p++) {
+
+			Pool &pool = pools[p];
+
+			std::vector< int32_t > order;
+			for (size_t i = 0; i < pool.blocks.size(); i++) {
+
+				if (pool.blocks[i] != nullptr && pool.blocks[i]->used > 0) {
+
+					order.push_back(static_cast< int32_t >(i));
+
+				}
+
+			}
+			std::sort(order.begin(), order.end(), [&pool](int32_t a, int32_t b) { return pool.blocks[a]->used < pool.blocks[b]->used; });
+
+			// Empty the sparsest blocks, blocks over half full are not worth the copies
+			for (size_t k = 0; k + 1 < order.size(); k++) {
+
+				Block &source = *pool.blocks[order[k]];
+				if (source.used > pool.blockSize / 2) {
+
+					break;
+
+				}
+
+				std::vector< std::pair< VkDeviceSize, uint32_t > > live(source.levels.begin(), source.levels.end());
+				for (const std::pair< VkDeviceSize, uint32_t > &entry : live) {
+
+					// Densest blocks first, the sparse ones are emptied next
+					VkDeviceSize offset = 0;
+					size_t target = order.size() - 1;
+					while (target > k && !takeBuddy(pool, *pool.blocks[order[target]], entry.second, offset)) {
+
+						target--;
+
+					}
+					if (target == k) {
+
+						break;
+
+					}
+					Block &destination = *pool.blocks[order[target]];
+
+					MemoryAllocation from;
+					from.memory			= source.memory;
+					from.offset			= entry.first;
+					from.size			= pool.blockSize >> entry.second;
+					from.mapped			= source.mapped != nullptr ? static_cast< uint8_t* >(source.mapped) + entry.first : nullptr;
+					from.memoryType		= pool.memoryType;
+					from.pool			= static_cast< int32_t >(p);
+					from.block			= order[k];
+					from.userData		= source.owners[entry.first];
+
+					MemoryAllocation to	= from;
+					to.memory			= destination.memory;
+					to.offset			= offset;
+					to.mapped			= destination.mapped != nullptr ? static_cast< uint8_t* >(destination.mapped) + offset : nullptr;
+					to.block			= order[target];
+
+					if (!move(from, to)) {
+
+						releaseBuddy(pool, destination, offset);
+						break;
+
+					}
+
+					destination.owners[offset] = from.userData;
+					releaseBuddy(pool, source, entry.first);
+					moved++;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	releaseIdleBlocks();
+
+	return moved;
+
+}
+
+/*
+*	Function:		uint32_t MemoryAllocator::releaseIdleBlocks()
+*	Purpose:		Frees every block without allocations, returns the amount of released blocks
+*
+*/
+uint32_t MemoryAllocator::releaseIdleBlocks() {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	uint32_t released = 0;
+	for (Pool &pool : pools) {
+
+		for (Block* &block : pool.blocks) {
+
+			if (block != nullptr && block->used == 0) {
+
+				freeDeviceMemory(block->memory, block->mapped != nullptr);
+				delete block;
+				block = nullptr;
+				released++;
+
+			}
+
+		}
+
+	}
+
+	return released;
+
+}
+
+/*
+*	Function:		MemoryStatistics MemoryAllocator::statistics()
+*	Purpose:		Sums up blocks, allocations and free ranges of all pools
+*
+*/
+MemoryStatistics MemoryAllocator::statistics() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	MemoryStatistics stats = {};
+	stats.deviceMemoryAllocations		= deviceAllocations;
+	stats.maxDeviceMemoryAllocations	= maxAllocations;
+	stats.dedicatedAllocations			= static_cast< uint32_t >(dedicated.size());
+	stats.allocations					= stats.dedicatedAllocations;
+
+	VkDeviceSize freeBytes = 0;
+	VkDeviceSize contiguousBytes = 0;
+	for (const Pool &pool : pools) {
+
+		for (const Block* block : pool.blocks) {
+
+			if (block == nullptr) {
+
+				continue;
+
+			}
+
+			stats.blocks++;
+			stats.idleBlocks		+= block->used == 0 ? 1 : 0;
+			stats.allocations		+= static_cast< uint32_t >(block->levels.size());
+			stats.reservedBytes		+= pool.blockSize;
+			stats.usedBytes			+= block->used;
+
+			// The lowest level with a free buddy holds the largest free range of the block
+			VkDeviceSize largest = 0;
+			for (uint32_t level = 0; level <= pool.maxLevel; level++) {
+
+				if (!block->freeLists[level].empty()) {
+
+					largest = pool.blockSize >> level;
+					break;
+
+				}
+
+			}
+			stats.largestFreeRange	= std::max(stats.largestFreeRange, largest);
+			freeBytes				+= pool.blockSize - block->used;
+			contiguousBytes			+= largest;
+
+		}
+
+	}
+
+	for (const std::pair< const VkDeviceMemory, VkDeviceSize > &entry : dedicated) {
+
+		stats.reservedBytes		+= entry.second;
+		stats.usedBytes			+= entry.second;
+
+	}
+
+	for (const LinearPool &pool : linearPools) {
+
+		stats.linearBytes		+= pool.capacity;
+		stats.linearPeakBytes	= std::max(stats.linearPeakBytes, pool.peak);
+
+	}
+
+	// Weighted per block, free memory split across blocks is not fragmentation
+	stats.fragmentation = freeBytes > 0 ? 1.0 - static_cast< double >(contiguousBytes) / static_cast< double >(freeBytes) : 0.0;
+
+	return stats;
+
+}
+
+/*
+*	Function:		uint32_t MemoryAllocator::destroy()
+*	Purpose:		Frees all device memory, returns the amount of allocations that were never freed
+*
+*/
+uint32_t MemoryAllocator::destroy() {
+
+	for (const LinearPool &pool : linearPools) {
+
+		destroyBuffer(pool.buffer, pool.allocation);
+
+	}
+	linearPools.clear();
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	uint32_t leaked = static_cast< uint32_t >(dedicated.size());
+	for (Pool &pool : pools) {
+
+		for (Block* &block : pool.blocks) {
+
+			if (block != nullptr) {
+
+				leaked += static_cast< uint32_t >(block->levels.size());
+				freeDeviceMemory(block->memory, block->mapped != nullptr);
+				delete block;
+
+			}
+
+		}
+		pool.blocks.clear();
+
+	}
+
+	for (const std::pair< const VkDeviceMemory, VkDeviceSize > &entry : dedicated) {
+
+		vkFreeMemory(device, entry.first, allocationCallbacks);
+
+	}
+	dedicated.clear();
+
+	return leaked;
+
+}
+
+/*
+*	Function:		VkResult MemoryAllocator::allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, VkDeviceMemory &memory, void* &mapped)
+*	Purpose:		Allocates device memory and maps host visible memory persistently
+*
+*/
+VkResult MemoryAllocator::allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, VkDeviceMemory &memory, void* &mapped) {
+
+	if (deviceAllocations >= maxAllocations) {
+
+		return VK_ERROR_TOO_MANY_OBJECTS;
+
+	}
+
+	VkMemoryAllocateInfo memoryAllocateInfo;
+	memoryAllocateInfo.sType				= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.pNext				= nullptr;
+	memoryAllocateInfo.allocationSize		= size;
+	memoryAllocateInfo.memoryTypeIndex		= memoryType;
+
+	VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, allocationCallbacks, &memory);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+	deviceAllocations++;
+
+	mapped = nullptr;
+	if (memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+
+		result = vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+		if (result != VK_SUCCESS) {
+
+			freeDeviceMemory(memory, false);
+
+		}
+
+	}
+
+	return result;
+
+}
+
+void MemoryAllocator::freeDeviceMemory(VkDeviceMemory memory, bool mapped) {
+
+	if (mapped) {
+
+		vkUnmapMemory(device, memory);
+
+	}
+	vkFreeMemory(device, memory, allocationCallbacks);
+	deviceAllocations--;
+
+}
+
+/*
+*	Function:		bool MemoryAllocator::takeBuddy(Pool &pool, Block &block, uint32_t level, VkDeviceSize &offset)
+*	Purpose:		Takes a free buddy of the level, splitting the smallest larger one if there is none
+*
+*/
+bool MemoryAllocator::takeBuddy(Pool &pool, Block &block, uint32_t level, VkDeviceSize &offset) {
+
+	uint32_t current = level;
+	while (block.freeLists[current].empty()) {
+
+		if (current == 0) {
+
+			return false;
+
+		}
+		current--;
+
+	}
+
+	offset = *block.freeLists[current].begin();
+	block.freeLists[current].erase(block.freeLists[current].begin());
+
+	// Every split keeps the lower half and frees the upper half one level down
+	while (current < level) {
+
+		current++;
+		block.freeLists[current].insert(offset + (pool.blockSize >> current));
+
+	}
+
+	block.levels[offset]	= level;
+	block.owners[offset]	= nullptr;
+	block.used				+= pool.blockSize >> level;
+
+	return true;
+
+}
+
+/*
+*	Function:		void MemoryAllocator::releaseBuddy(Pool &pool, Block &block, VkDeviceSize offset)
+*	Purpose:		Frees a buddy and merges it with its free buddies up the levels
+*
+*/
+void MemoryAllocator::releaseBuddy(Pool &pool, Block &block, VkDeviceSize offset) {
+
+	uint32_t level = block.levels[offset];
+	block.levels.erase(offset);
+	block.owners.erase(offset);
+	block.used -= pool.blockSize >> level;
+
+	while (level > 0) {
+
+		VkDeviceSize buddy = offset ^ (pool.blockSize >> level);
+		if (block.freeLists[level].erase(buddy) == 0) {
+
+			break;
+
+		}
+		offset = std::min(offset, buddy);
+		level--;
+
+	}
+	block.freeLists[level].insert(offset);
+
+}
+
+/*
+*	Function:		VkMappedMemoryRange MemoryAllocator::mappedRange(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size)
+*	Purpose:		Widens a range of the allocation to whole atoms, buddies are atom aligned as
+*					MEMORY_MIN_ALLOCATION is the largest nonCoherentAtomSize the specification allows
+*
+*/
+VkMappedMemoryRange MemoryAllocator::mappedRange(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size) const {
+
+	VkDeviceSize end = allocation.offset + allocation.size;
+	if (size != VK_WHOLE_SIZE) {
+
+		end = std::min(end, (allocation.offset + offset + size + atomSize - 1) / atomSize * atomSize);
+
+	}
+
+	VkMappedMemoryRange range;
+	range.sType			= VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	range.pNext			= nullptr;
+	range.memory		= allocation.memory;
+	range.offset		= (allocation.offset + offset) / atomSize * atomSize;
+	range.size			= allocation.pool == MEMORY_POOL_DEDICATED && end == allocation.offset + allocation.size ? VK_WHOLE_SIZE : end - range.offset;
+
+	return range;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+MemoryAllocator::~MemoryAllocator() {
+
+
+
+}
+
@@ -0,0 +1,171 @@
+/*
+*	File:			MemoryAllocator.hpp
+*	Purpose:		Contains class MemoryAllocator
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+#define MEMORY_BLOCK_SIZE				(64ull * 1024 * 1024)	// Largest device memory block, smaller heaps get an eighth of their size
+#define MEMORY_MIN_ALLOCATION			256						// Smallest buddy, also the upper bound of nonCoherentAtomSize
+#define MEMORY_POOL_DEDICATED			-1						// MemoryAllocation::pool of resources larger than half a block
+
+/*
+*	Struct:			MemoryAllocation
+*	Purpose:		Range of device memory handed out by MemoryAllocator, bind resources at memory + offset
+*
+*/
+struct MemoryAllocation {
+
+	VkDeviceMemory		memory;
+	VkDeviceSize		offset;
+	VkDeviceSize		size;					// Reserved size, a power of two unless dedicated
+	void*				mapped;					// Host address of offset, nullptr unless host visible
+	uint32_t			memoryType;
+	int32_t				pool;					// Buddy pool or MEMORY_POOL_DEDICATED
+	int32_t				block;
+	void*				userData;				// Owner of the allocation, passed back by defragment()
+
+};
+
+/*
+*	Struct:			LinearAllocation
+*	Purpose:		Range of a linear pool's buffer, valid until the pool is reset
+*
+*/
+struct LinearAllocation {
+
+	VkBuffer			buffer;
+	VkDeviceSize		offset;
+	VkDeviceSize		size;
+	void*				mapped;
+
+};
+
+/*
+*	Struct:			MemoryStatistics
+*	Purpose:		Snapshot of the allocator for logging
+*
+*/
+struct MemoryStatistics {
+
+	uint32_t			deviceMemoryAllocations;	// Live vkAllocateMemory allocations, limited by maxMemoryAllocationCount
+	uint32_t			maxDeviceMemoryAllocations;
+	uint32_t			blocks;
+	uint32_t			idleBlocks;					// Blocks without allocations, released by releaseIdleBlocks()
+	uint32_t			dedicatedAllocations;
+	uint32_t			allocations;				// Buddy and dedicated allocations
+	VkDeviceSize		reservedBytes;				// Device memory allocated from the driver
+	VkDeviceSize		usedBytes;					// Handed out, including power of two rounding
+	VkDeviceSize		largestFreeRange;
+	double				fragmentation;				// 1 - largest free range / free bytes, 0 when free memory is contiguous
+	VkDeviceSize		linearBytes;				// Capacity of all linear pools
+	VkDeviceSize		linearPeakBytes;			// Highest fill of any linear pool since creation
+
+};
+
+/*
+*	Class:			MemoryAllocator
+*	Purpose:		Sub-allocates buffers and images from large device memory blocks with a buddy
+*					allocator per memory type, linear and optimal resources never share a block
+*					so bufferImageGranularity needs no padding, per-frame transient data comes
+*					from separate linear pools that are reset as a whole
+*
+*/
+class MemoryAllocator
+{
+public:
+	typedef std::function< bool(const MemoryAllocation &from, const MemoryAllocation &to) > MoveFunction;
+
+	MemoryAllocator();
+	void create(VkDevice device, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator = nullptr);
+	uint32_t findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) const;
+	VkResult allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, bool optimalTiling, MemoryAllocation &allocation);
+	void free(const MemoryAllocation &allocation);
+	void setUserData(MemoryAllocation &allocation, void* userData);
+	VkResult createBuffer(const VkBufferCreateInfo &bufferCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkBuffer &buffer, MemoryAllocation &allocation);
+	VkResult createImage(const VkImageCreateInfo &imageCreateInfo, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, VkImage &image, MemoryAllocation &allocation);
+	void destroyBuffer(VkBuffer buffer, const MemoryAllocation &allocation);
+	void destroyImage(VkImage image, const MemoryAllocation &allocation);
+	VkResult flush(const MemoryAllocation &allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const;
+	VkResult invalidate(const MemoryAllocation &allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const;
+	bool coherent(const MemoryAllocation &allocation) const;
+	VkResult createLinearPool(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, uint32_t &linearPool);
+	bool allocateLinear(uint32_t linearPool, VkDeviceSize size, VkDeviceSize alignment, LinearAllocation &allocation);
+	VkResult flushLinear(uint32_t linearPool, const LinearAllocation &allocation) const;
+	void resetLinearPool(uint32_t linearPool);
+	uint32_t defragment(const MoveFunction &move);
+	uint32_t releaseIdleBlocks(void);
+	MemoryStatistics statistics(void) const;
+	uint32_t destroy(void);
+	~MemoryAllocator();
+private:
+	/*
+	*	Struct:			Block
+	*	Purpose:		One device memory allocation split into buddies, level l holds buddies of size >> l
+	*
+	*/
+	struct Block {
+
+		VkDeviceMemory									memory;
+		void*											mapped;
+		VkDeviceSize									used;
+		std::vector< std::set< VkDeviceSize > >			freeLists;		// Free offsets per level, lowest offset is taken first
+		std::unordered_map< VkDeviceSize, uint32_t >	levels;			// Level of every live allocation by offset
+		std::unordered_map< VkDeviceSize, void* >		owners;			// userData of every live allocation by offset
+
+	};
+
+	/*
+	*	Struct:			Pool
+	*	Purpose:		Blocks of one memory type and tiling class, empty slots are nullptr to keep indices stable
+	*
+	*/
+	struct Pool {
+
+		uint32_t						memoryType;
+		VkDeviceSize					blockSize;
+		uint32_t						maxLevel;
+		std::vector< Block* >			blocks;
+
+	};
+
+	/*
+	*	Struct:			LinearPool
+	*	Purpose:		Buffer handed out front to back, reset instead of freed
+	*
+	*/
+	struct LinearPool {
+
+		VkBuffer						buffer;
+		MemoryAllocation				allocation;
+		VkDeviceSize					capacity;
+		VkDeviceSize					head;
+		VkDeviceSize					peak;
+
+	};
+
+	VkResult allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, VkDeviceMemory &memory, void* &mapped);
+	void freeDeviceMemory(VkDeviceMemory memory, bool mapped);
+	bool takeBuddy(Pool &pool, Block &block, uint32_t level, VkDeviceSize &offset);
+	void releaseBuddy(Pool &pool, Block &block, VkDeviceSize offset);
+	VkMappedMemoryRange mappedRange(const MemoryAllocation &allocation, VkDeviceSize offset, VkDeviceSize size) const;
+
+	VkDevice								device;
+	const VkAllocationCallbacks*			allocationCallbacks;		// Blocks, buffers and images are also created at runtime
+	VkPhysicalDeviceMemoryProperties		memoryProperties;
+	VkDeviceSize							atomSize;
+	uint32_t								maxAllocations;				// maxMemoryAllocationCount
+	uint32_t								deviceAllocations;
+	std::vector< Pool >						pools;						// memoryTypeCount * 2, odd pools hold optimal tiling images
+	std::unordered_map< VkDeviceMemory, VkDeviceSize >	dedicated;			// Size of every dedicated allocation
+	std::vector< LinearPool >				linearPools;
+	mutable std::mutex						mutex;
+};
+
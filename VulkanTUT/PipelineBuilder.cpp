@@ -0,0 +1,575 @@
+/*
+*	File:			PipelineBuilder.cpp
+*	Purpose:		Contains functions for struct PipelineDescription and class PipelineBuilder
+*
+*/
+#include "PipelineBuilder.hpp"
+#include "ShaderLibrary.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/*
+*	Default constructor
+*
+*
+*/
+PipelineDescription::PipelineDescription() :
+	vertexShader(VK_NULL_HANDLE),
+	fragmentShader(VK_NULL_HANDLE),
+	topology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST),
+	viewport(),
+	scissor(),
+	polygonMode(VK_POLYGON_MODE_FILL),
+	cullMode(VK_CULL_MODE_BACK_BIT),
+	frontFace(VK_FRONT_FACE_CLOCKWISE),
+	samples(VK_SAMPLE_COUNT_1_BIT),
+	blendAttachment(),
+	layout(VK_NULL_HANDLE),
+	renderPass(VK_NULL_HANDLE),
+	subpass(0) {
+
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	setBlendMode(BLEND_MODE_ALPHA);
+
+}
+
+/*
+*	Function:		void PipelineDescription::setBlendMode(BlendMode mode)
+*	Purpose:		Sets the color blend state of the single color attachment
+*
+*/
+void PipelineDescription::setBlendMode(BlendMode mode) {
+
+	blendAttachment.blendEnable				= mode == BLEND_MODE_OPAQUE ? VK_FALSE : VK_TRUE;
+	blendAttachment.srcColorBlendFactor		= mode == BLEND_MODE_OPAQUE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_SRC_ALPHA;
+	blendAttachment.dstColorBlendFactor		= mode == BLEND_MODE_ALPHA ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : (mode == BLEND_MODE_ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ZERO);
+	blendAttachment.colorBlendOp			= VK_BLEND_OP_ADD;
+	blendAttachment.srcAlphaBlendFactor		= VK_BLEND_FACTOR_ONE;
+	blendAttachment.dstAlphaBlendFactor		= VK_BLEND_FACTOR_ZERO;
+	blendAttachment.alphaBlendOp			= VK_BLEND_OP_ADD;
+	blendAttachment.colorWriteMask			= VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+}
+
+/*
+*	Function:		void PipelineDescription::addVertexFormat(const VertexFormat &format)
+*	Purpose:		Adds the binding and attributes of a vertex buffer to the vertex input state
+*
+*/
+void PipelineDescription::addVertexFormat(const VertexFormat &format) {
+
+	vertexBindings.push_back(format.bindingDescription());
+	vertexAttributes.insert(vertexAttributes.end(), format.attributeDescriptions().begin(), format.attributeDescriptions().end());
+
+}
+
+/*
+*	Function:		uint64_t PipelineDescription::key() const
+*	Purpose:		Hashes every field that ends up in the pipeline, equal keys build the same permutation
+*
+*/
+uint64_t PipelineDescription::key() const {
+
+	std::vector< uint32_t > words;
+	auto append = [&words](const void* data, size_t size) {
+
+		// Every field is a multiple of four bytes without padding
+		const uint32_t* begin = static_cast< const uint32_t* >(data);
+		words.insert(words.end(), begin, begin + size / sizeof(uint32_t));
+
+	};
+
+	uint64_t handles[] = {
+
+		reinterpret_cast< uint64_t >(vertexShader),
+		reinterpret_cast< uint64_t >(fragmentShader),
+		reinterpret_cast< uint64_t >(layout),
+		reinterpret_cast< uint64_t >(renderPass),
+		vertexConstants.hash(),
+		fragmentConstants.hash()
+
+	};
+	append(handles, sizeof(handles));
+	append(vertexBindings.data(), vertexBindings.size() * sizeof(VkVertexInputBindingDescription));
+	append(vertexAttributes.data(), vertexAttributes.size() * sizeof(VkVertexInputAttributeDescription));
+	append(&topology, sizeof(topology));
+	append(&viewport, sizeof(viewport));
+	append(&scissor, sizeof(scissor));
+	append(&polygonMode, sizeof(polygonMode));
+	append(&cullMode, sizeof(cullMode));
+	append(&frontFace, sizeof(frontFace));
+	append(&samples, sizeof(samples));
+	append(&blendAttachment, sizeof(blendAttachment));
+	append(dynamicStates.data(), dynamicStates.size() * sizeof(VkDynamicState));
+	append(&subpass, sizeof(subpass));
+	append(colorFormats.data(), colorFormats.size() * sizeof(VkFormat));
+
+	return ShaderLibrary::hash(words.data(), words.size());
+
+}
+
+/*
+*	Function:		template< typename T > static bool equalWords(const std::vector< T > &a, const std::vector< T > &b)
+*	Purpose:		Compares two vectors of plain Vulkan structs byte by byte, like key() they have no padding
+*
+*/
+template< typename T >
+static bool equalWords(const std::vector< T > &a, const std::vector< T > &b) {
+
+	return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+
+}
+
+/*
+*	Function:		bool PipelineDescription::operator==(const PipelineDescription &other) const
+*	Purpose:		Compares every field key() hashes, tells apart descriptions whose keys collide
+*
+*/
+bool PipelineDescription::operator==(const PipelineDescription &other) const {
+
+	return vertexShader == other.vertexShader &&
+		fragmentShader == other.fragmentShader &&
+		vertexConstants == other.vertexConstants &&
+		fragmentConstants == other.fragmentConstants &&
+		equalWords(vertexBindings, other.vertexBindings) &&
+		equalWords(vertexAttributes, other.vertexAttributes) &&
+		topology == other.topology &&
+		memcmp(&viewport, &other.viewport, sizeof(viewport)) == 0 &&
+		memcmp(&scissor, &other.scissor, sizeof(scissor)) == 0 &&
+		polygonMode == other.polygonMode &&
+		cullMode == other.cullMode &&
+		frontFace == other.frontFace &&
+		samples == other.samples &&
+		memcmp(&blendAttachment, &other.blendAttachment, sizeof(blendAttachment)) == 0 &&
+		dynamicStates == other.dynamicStates &&
+		layout == other.layout &&
+		renderPass == other.renderPass &&
+		subpass == other.subpass &&
+		colorFormats == other.colorFormats;
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+PipelineBuilder::PipelineBuilder() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	cache(VK_NULL_HANDLE),
+	threadPool(nullptr),
+	milliseconds(0.0),
+	permutationHits(0) {
+
+
+
+}
+
+/*
+*	Function:		void PipelineBuilder::init(VkDevice device, VkPipelineCache cache, ThreadPool* threadPool, const VkAllocationCallbacks* allocator)
+*	Purpose:		Sets the device, the shared cache, the workers compiling submitted pipelines and the
+*					callbacks every pipeline is created and destroyed with
+*
+*/
+void PipelineBuilder::init(VkDevice device_, VkPipelineCache cache_, ThreadPool* threadPool_, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	cache				= cache_;
+	threadPool			= threadPool_;
+	allocationCallbacks	= allocator;
+
+}
+
+/*
+*	Function:		VkResult PipelineBuilder::build(const PipelineDescription &description, VkPipeline &pipeline)
+*	Purpose:		Compiles one pipeline on the calling thread, safe to call from several threads at once
+*					Without a render pass the pipeline renders to colorFormats inside vkCmdBeginRenderingKHR
+*
+*/
+VkResult PipelineBuilder::build(const PipelineDescription &description, VkPipeline &pipeline) {
+
+	VkPipelineShaderStageCreateInfo shaderStages[2];
+	shaderStages[0].sType						= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStages[0].pNext						= nullptr;
+	shaderStages[0].flags						= 0;
+	shaderStages[0].stage						= VK_SHADER_STAGE_VERTEX_BIT;
+	shaderStages[0].module						= description.vertexShader;
+	shaderStages[0].pName						= "main";
+	shaderStages[0].pSpecializationInfo			= nullptr;
+
+	shaderStages[1]								= shaderStages[0];
+	shaderStages[1].stage						= VK_SHADER_STAGE_FRAGMENT_BIT;
+	shaderStages[1].module						= description.fragmentShader;
+
+	VkSpecializationInfo vertexSpecialization	= description.vertexConstants.info();
+	VkSpecializationInfo fragmentSpecialization	= description.fragmentConstants.info();
+	if (!description.vertexConstants.empty()) {
+
+		shaderStages[0].pSpecializationInfo		= &vertexSpecialization;
+
+	}
+	if (!description.fragmentConstants.empty()) {
+
+		shaderStages[1].pSpecializationInfo		= &fragmentSpecialization;
+
+	}
+
+	VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo;
+	vertexInputCreateInfo.sType								= VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInputCreateInfo.pNext								= nullptr;
+	vertexInputCreateInfo.flags								= 0;
+	vertexInputCreateInfo.vertexBindingDescriptionCount		= static_cast< uint32_t >(description.vertexBindings.size());
+	vertexInputCreateInfo.pVertexBindingDescriptions		= description.vertexBindings.data();
+	vertexInputCreateInfo.vertexAttributeDescriptionCount	= static_cast< uint32_t >(description.vertexAttributes.size());
+	vertexInputCreateInfo.pVertexAttributeDescriptions		= description.vertexAttributes.data();
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo;
+	inputAssemblyCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssemblyCreateInfo.pNext						= nullptr;
+	inputAssemblyCreateInfo.flags						= 0;
+	inputAssemblyCreateInfo.topology					= description.topology;
+	inputAssemblyCreateInfo.primitiveRestartEnable		= VK_FALSE;
+
+	VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
+	viewportStateCreateInfo.sType				= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportStateCreateInfo.pNext				= nullptr;
+	viewportStateCreateInfo.flags				= 0;
+	viewportStateCreateInfo.viewportCount		= 1;
+	viewportStateCreateInfo.pViewports			= &description.viewport;
+	viewportStateCreateInfo.scissorCount		= 1;
+	viewportStateCreateInfo.pScissors			= &description.scissor;
+
+	VkPipelineRasterizationStateCreateInfo rasterizationCreateInfo;
+	rasterizationCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterizationCreateInfo.pNext						= nullptr;
+	rasterizationCreateInfo.flags						= 0;
+	rasterizationCreateInfo.depthClampEnable			= VK_FALSE;
+	rasterizationCreateInfo.rasterizerDiscardEnable		= VK_FALSE;
+	rasterizationCreateInfo.polygonMode					= description.polygonMode;
+	rasterizationCreateInfo.cullMode					= description.cullMode;
+	rasterizationCreateInfo.frontFace					= description.frontFace;
+	rasterizationCreateInfo.depthBiasEnable				= VK_FALSE;
+	rasterizationCreateInfo.depthBiasConstantFactor		= 0.0f;
+	rasterizationCreateInfo.depthBiasClamp				= 0.0f;
+	rasterizationCreateInfo.depthBiasSlopeFactor		= 0.0f;
+	rasterizationCreateInfo.lineWidth					= 1.0f;
+
+	VkPipelineMultisampleStateCreateInfo multisampleCreateInfo;
+	multisampleCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisampleCreateInfo.pNext						= nullptr;
+	multisampleCreateInfo.flags						= 0;
+	multisampleCreateInfo.rasterizationSamples		= description.samples;
+	multisampleCreateInfo.sampleShadingEnable		= VK_FALSE;
+	multisampleCreateInfo.minSampleShading			= 1.0f;
+	multisampleCreateInfo.pSampleMask				= nullptr;
+	multisampleCreateInfo.alphaToCoverageEnable		= VK_FALSE;
+	multisampleCreateInfo.alphaToOneEnable			= VK_FALSE;
+
+	VkPipelineColorBlendStateCreateInfo colorBlendCreateInfo;
+	colorBlendCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlendCreateInfo.pNext					= nullptr;
+	colorBlendCreateInfo.flags					= 0;
+	colorBlendCreateInfo.logicOpEnable			= VK_FALSE;
+	colorBlendCreateInfo.logicOp				= VK_LOGIC_OP_NO_OP;
+	colorBlendCreateInfo.attachmentCount		= 1;
+	colorBlendCreateInfo.pAttachments			= &description.blendAttachment;
+	colorBlendCreateInfo.blendConstants[0]		= 0.0f;
+	colorBlendCreateInfo.blendConstants[1]		= 0.0f;
+	colorBlendCreateInfo.blendConstants[2]		= 0.0f;
+	colorBlendCreateInfo.blendConstants[3]		= 0.0f;
+
+	VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
+	dynamicStateCreateInfo.sType				= VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicStateCreateInfo.pNext				= nullptr;
+	dynamicStateCreateInfo.flags				= 0;
+	dynamicStateCreateInfo.dynamicStateCount	= static_cast< uint32_t >(description.dynamicStates.size());
+	dynamicStateCreateInfo.pDynamicStates		= description.dynamicStates.data();
+
+	VkGraphicsPipelineCreateInfo pipelineCreateInfo;
+	pipelineCreateInfo.sType					= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipelineCreateInfo.pNext					= nullptr;
+
+#ifdef VK_KHR_dynamic_rendering
+	VkPipelineRenderingCreateInfoKHR renderingCreateInfo;
+	renderingCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+	renderingCreateInfo.pNext						= nullptr;
+	renderingCreateInfo.viewMask					= 0;
+	renderingCreateInfo.colorAttachmentCount		= static_cast< uint32_t >(description.colorFormats.size());
+	renderingCreateInfo.pColorAttachmentFormats		= description.colorFormats.data();
+	renderingCreateInfo.depthAttachmentFormat		= VK_FORMAT_UNDEFINED;
+	renderingCreateInfo.stencilAttachmentFormat		= VK_FORMAT_UNDEFINED;
+	if (description.renderPass == VK_NULL_HANDLE) {
+
+		pipelineCreateInfo.pNext = &renderingCreateInfo;
+
+	}
+#endif
+
+	pipelineCreateInfo.flags					= 0;
+	pipelineCreateInfo.stageCount				= 2;
+	pipelineCreateInfo.pStages					= shaderStages;
+	pipelineCreateInfo.pVertexInputState		= &vertexInputCreateInfo;
+	pipelineCreateInfo.pInputAssemblyState		= &inputAssemblyCreateInfo;
+	pipelineCreateInfo.pTessellationState		= nullptr;
+	pipelineCreateInfo.pViewportState			= &viewportStateCreateInfo;
+	pipelineCreateInfo.pRasterizationState		= &rasterizationCreateInfo;
+	pipelineCreateInfo.pMultisampleState		= &multisampleCreateInfo;
+	pipelineCreateInfo.pDepthStencilState		= nullptr;
+	pipelineCreateInfo.pColorBlendState			= &colorBlendCreateInfo;
+	pipelineCreateInfo.pDynamicState			= description.dynamicStates.empty() ? nullptr : &dynamicStateCreateInfo;
+	pipelineCreateInfo.layout					= description.layout;
+	pipelineCreateInfo.renderPass				= description.renderPass;
+	pipelineCreateInfo.subpass					= description.subpass;
+	pipelineCreateInfo.basePipelineHandle		= VK_NULL_HANDLE;
+	pipelineCreateInfo.basePipelineIndex		= -1;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	VkResult result = vkCreateGraphicsPipelines(
+
+		device,
+		cache,
+		1,
+		&pipelineCreateInfo,
+		allocationCallbacks,
+		&pipeline
+
+	);
+
+	double elapsed = std::chrono::duration< double, std::milli >(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::lock_guard< std::mutex > lock(mutex);
+	milliseconds += elapsed;
+	if (result == VK_SUCCESS) {
+
+		pipelines.push_back(pipeline);
+
+	}
+
+	return result;
+
+}
+
+/*
+*	Function:		std::future< VkPipeline > PipelineBuilder::submit(const PipelineDescription &description)
+*	Purpose:		Compiles a copy of the description on a worker, the future throws if compilation failed
+*
+*/
+std::future< VkPipeline > PipelineBuilder::submit(const PipelineDescription &description) {
+
+	return threadPool->submit([this, description]() {
+
+		VkPipeline pipeline;
+		VkResult result = build(description, pipeline);
+		if (result != VK_SUCCESS) {
+
+			throw std::runtime_error("vkCreateGraphicsPipelines failed with VkResult " + std::to_string(result));
+
+		}
+
+		return pipeline;
+
+	});
+
+}
+
+/*
+*	Function:		std::vector< std::future< VkPipeline > > PipelineBuilder::submit(const std::vector< PipelineDescription > &descriptions)
+*	Purpose:		Submits every description, the futures are in the same order
+*
+*/
+std::vector< std::future< VkPipeline > > PipelineBuilder::submit(const std::vector< PipelineDescription > &descriptions) {
+
+	std::vector< std::future< VkPipeline > > futures;
+	futures.reserve(descriptions.size());
+	for (const PipelineDescription &description : descriptions) {
+
+		futures.push_back(submit(description));
+
+	}
+
+	return futures;
+
+}
+
+/*
+*	Function:		std::shared_future< VkPipeline > PipelineBuilder::permutation(const PipelineDescription &description)
+*	Purpose:		Returns the pipeline of the description, compiled on a worker the first time its key is
+*					requested and shared by every later request of an equal description
+*					The future throws if compilation failed, the next request then compiles again
+*
+*/
+std::shared_future< VkPipeline > PipelineBuilder::permutation(const PipelineDescription &description) {
+
+	uint64_t key = description.key();
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	auto it = permutationsByKey.find(key);
+	if (it != permutationsByKey.end()) {
+
+		if (it->second.description == description) {
+
+			permutationHits++;
+			return it->second.pipeline;
+
+		}
+
+		// Another description owns the key, compiling without caching keeps both correct
+		return submit(description).share();
+
+	}
+
+	std::shared_future< VkPipeline > future = threadPool->submit([this, description, key]() {
+
+		VkPipeline pipeline;
+		VkResult result = build(description, pipeline);
+		if (result != VK_SUCCESS) {
+
+			// Failures are not cached, so a request after fixing the cause compiles again
+			std::lock_guard< std::mutex > lock(mutex);
+			permutationsByKey.erase(key);
+			throw std::runtime_error("vkCreateGraphicsPipelines failed with VkResult " + std::to_string(result));
+
+		}
+
+		std::lock_guard< std::mutex > lock(mutex);
+		keysByPipeline[pipeline] = key;
+
+		return pipeline;
+
+	}).share();
+	Permutation &entry	= permutationsByKey[key];
+	entry.description	= description;
+	entry.pipeline		= future;
+
+	return future;
+
+}
+
+/*
+*	Function:		std::vector< std::shared_future< VkPipeline > > PipelineBuilder::permutations(const std::vector< PipelineDescription > &descriptions)
+*	Purpose:		Requests every permutation, the futures are in the same order
+*
+*/
+std::vector< std::shared_future< VkPipeline > > PipelineBuilder::permutations(const std::vector< PipelineDescription > &descriptions) {
+
+	std::vector< std::shared_future< VkPipeline > > futures;
+	futures.reserve(descriptions.size());
+	for (const PipelineDescription &description : descriptions) {
+
+		futures.push_back(permutation(description));
+
+	}
+
+	return futures;
+
+}
+
+/*
+*	Function:		void PipelineBuilder::evict(VkPipeline pipeline)
+*	Purpose:		Stops handing out a permutation about to be retired, the next request for its key compiles anew
+*
+*/
+void PipelineBuilder::evict(VkPipeline pipeline) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	forget(pipeline);
+
+}
+
+/*
+*	Function:		void PipelineBuilder::destroy(VkPipeline pipeline)
+*	Purpose:		Destroys one pipeline built earlier, the GPU must be done with it
+*
+*/
+void PipelineBuilder::destroy(VkPipeline pipeline) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	auto it = std::find(pipelines.begin(), pipelines.end(), pipeline);
+	if (it != pipelines.end()) {
+
+		vkDestroyPipeline(device, pipeline, allocationCallbacks);
+		pipelines.erase(it);
+		forget(pipeline);
+
+	}
+
+}
+
+/*
+*	Function:		void PipelineBuilder::forget(VkPipeline pipeline)
+*	Purpose:		Removes a pipeline from the permutations, called with the mutex held
+*
+*/
+void PipelineBuilder::forget(VkPipeline pipeline) {
+
+	auto it = keysByPipeline.find(pipeline);
+	if (it != keysByPipeline.end()) {
+
+		permutationsByKey.erase(it->second);
+		keysByPipeline.erase(it);
+
+	}
+
+}
+
+/*
+*	Function:		void PipelineBuilder::destroy()
+*	Purpose:		Destroys every pipeline built and forgets the permutations, no compilation may be pending
+*
+*/
+void PipelineBuilder::destroy() {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	for (VkPipeline pipeline : pipelines) {
+
+		vkDestroyPipeline(device, pipeline, allocationCallbacks);
+
+	}
+	pipelines.clear();
+	permutationsByKey.clear();
+	keysByPipeline.clear();
+	milliseconds = 0.0;
+
+}
+
+uint32_t PipelineBuilder::amountOfPipelines() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return static_cast< uint32_t >(pipelines.size());
+
+}
+
+double PipelineBuilder::compileMilliseconds() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return milliseconds;
+
+}
+
+uint32_t PipelineBuilder::amountOfPermutationHits() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return permutationHits;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+PipelineBuilder::~PipelineBuilder() {
+
+
+
+}
+
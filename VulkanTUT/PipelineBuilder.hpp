@@ -0,0 +1,112 @@
+/*
+*	File:			PipelineBuilder.hpp
+*	Purpose:		Contains struct PipelineDescription and class PipelineBuilder
+*
+*/
+#pragma once
+#include "ThreadPool.hpp"
+#include "VertexFormat.hpp"
+#include "SpecializationConstants.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <unordered_map>
+#include <future>
+#include <mutex>
+#include <cstdint>
+
+enum BlendMode {
+
+	BLEND_MODE_OPAQUE,
+	BLEND_MODE_ALPHA,
+	BLEND_MODE_ADDITIVE
+
+};
+
+/*
+*	Struct:			PipelineDescription
+*	Purpose:		Complete graphics pipeline state as a plain value, copied into the compile task so the
+*					caller may change or discard it right after submitting
+*
+*/
+struct PipelineDescription {
+
+	PipelineDescription();
+	void setBlendMode(BlendMode mode);
+	void addVertexFormat(const VertexFormat &format);
+	uint64_t key(void) const;
+	bool operator==(const PipelineDescription &other) const;
+
+	VkShaderModule											vertexShader;
+	VkShaderModule											fragmentShader;
+	SpecializationConstants									vertexConstants;		// Shader variant knobs, folded in by the driver
+	SpecializationConstants									fragmentConstants;
+	std::vector< VkVertexInputBindingDescription >			vertexBindings;
+	std::vector< VkVertexInputAttributeDescription >		vertexAttributes;
+	VkPrimitiveTopology										topology;
+	VkViewport												viewport;
+	VkRect2D												scissor;
+	VkPolygonMode											polygonMode;
+	VkCullModeFlags											cullMode;
+	VkFrontFace												frontFace;
+	VkSampleCountFlagBits									samples;
+	VkPipelineColorBlendAttachmentState						blendAttachment;
+	std::vector< VkDynamicState >							dynamicStates;
+	VkPipelineLayout										layout;
+	VkRenderPass											renderPass;				// VK_NULL_HANDLE renders with dynamic rendering to colorFormats
+	uint32_t												subpass;
+	std::vector< VkFormat >									colorFormats;
+
+};
+
+/*
+*	Class:			PipelineBuilder
+*	Purpose:		Compiles graphics pipelines on the thread pool, every worker creates into the one
+*					pipeline cache, which Vulkan synchronizes internally
+*					Permutations are keyed by their description, requesting one again shares the first compile
+*					A key shared by a different description is a hash collision and compiles without caching
+*
+*/
+class PipelineBuilder
+{
+public:
+	PipelineBuilder();
+	void init(VkDevice device, VkPipelineCache cache, ThreadPool* threadPool, const VkAllocationCallbacks* allocator = nullptr);
+	VkResult build(const PipelineDescription &description, VkPipeline &pipeline);
+	std::future< VkPipeline > submit(const PipelineDescription &description);
+	std::vector< std::future< VkPipeline > > submit(const std::vector< PipelineDescription > &descriptions);
+	std::shared_future< VkPipeline > permutation(const PipelineDescription &description);
+	std::vector< std::shared_future< VkPipeline > > permutations(const std::vector< PipelineDescription > &descriptions);
+	void evict(VkPipeline pipeline);
+	void destroy(VkPipeline pipeline);
+	void destroy(void);
+	uint32_t amountOfPipelines(void) const;
+	double compileMilliseconds(void) const;
+	uint32_t amountOfPermutationHits(void) const;
+	~PipelineBuilder();
+private:
+	/*
+	*	Struct:			Permutation
+	*	Purpose:		A requested permutation, the description tells hash collisions apart
+	*
+	*/
+	struct Permutation {
+
+		PipelineDescription					description;
+		std::shared_future< VkPipeline >	pipeline;
+
+	};
+
+	void forget(VkPipeline pipeline);
+
+	VkDevice						device;
+	const VkAllocationCallbacks*	allocationCallbacks;	// Pipelines are also rebuilt at runtime, on swapchain recreation
+	VkPipelineCache					cache;
+	ThreadPool*						threadPool;
+	std::vector< VkPipeline >		pipelines;				// Every pipeline built, destroyed together
+	double							milliseconds;			// Compile time summed over all threads
+	std::unordered_map< uint64_t, Permutation >							permutationsByKey;	// Failed compiles are removed to be retried
+	std::unordered_map< VkPipeline, uint64_t >							keysByPipeline;		// Of finished permutations, to evict them
+	uint32_t						permutationHits;		// Requests served by an earlier compile
+	mutable std::mutex				mutex;
+};
+
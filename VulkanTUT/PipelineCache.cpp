@@ -0,0 +1,308 @@
+/*
+*	File:			PipelineCache.cpp
+*	Purpose:		Contains functions for class PipelineCache
+*
+*/
+#include "PipelineCache.hpp"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+/*
+*	Default constructor
+*
+*
+*/
+PipelineCache::PipelineCache(std::string fileName_) :
+	fileName(fileName_),
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	cache(VK_NULL_HANDLE),
+	properties(),
+	loaded(false) {
+
+
+
+}
+
+/*
+*	Function:		VkResult PipelineCache::create(VkDevice device, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator)
+*	Purpose:		Creates the cache, seeded with the blob on disk if it was written by this device and driver
+*
+*/
+VkResult PipelineCache::create(VkDevice device_, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	std::vector< char > blob;
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (file) {
+
+		blob.resize(static_cast< size_t >(file.tellg()));
+		file.seekg(0);
+		file.read(blob.data(), blob.size());
+		if (!file) {
+
+			blob.clear();
+
+		}
+
+	}
+
+	std::string reason;
+	if (!file) {
+
+		statusText = "no cache file " + fileName;
+
+	}
+	else if (!validate(blob, properties, reason)) {
+
+		statusText = "discarded " + fileName + ": " + reason;
+		blob.clear();
+
+	}
+	else {
+
+		statusText = "loaded " + std::to_string(blob.size()) + " bytes from " + fileName;
+		loaded = true;
+
+	}
+
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+	pipelineCacheCreateInfo.sType				= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	pipelineCacheCreateInfo.pNext				= nullptr;
+	pipelineCacheCreateInfo.flags				= 0;
+	pipelineCacheCreateInfo.initialDataSize		= blob.size();
+	pipelineCacheCreateInfo.pInitialData		= blob.empty() ? nullptr : blob.data();
+
+	VkResult result = vkCreatePipelineCache(device, &pipelineCacheCreateInfo, allocationCallbacks, &cache);
+	if (result != VK_SUCCESS && loaded) {
+
+		// Drivers may still reject a blob whose header matches, start empty instead of failing
+		statusText	= "driver rejected " + fileName;
+		loaded		= false;
+		pipelineCacheCreateInfo.initialDataSize		= 0;
+		pipelineCacheCreateInfo.pInitialData		= nullptr;
+		result = vkCreatePipelineCache(device, &pipelineCacheCreateInfo, allocationCallbacks, &cache);
+
+	}
+
+	return result;
+
+}
+
+/*
+*	Function:		VkResult PipelineCache::merge(uint32_t amountOfCaches, const VkPipelineCache* caches)
+*	Purpose:		Merges caches filled elsewhere, e.g. by worker threads, into this cache
+*
+*/
+VkResult PipelineCache::merge(uint32_t amountOfCaches, const VkPipelineCache* caches) {
+
+	if (amountOfCaches == 0) {
+
+		return VK_SUCCESS;
+
+	}
+
+	return vkMergePipelineCaches(device, cache, amountOfCaches, caches);
+
+}
+
+/*
+*	Function:		VkResult PipelineCache::save()
+*	Purpose:		Writes the cache to disk, a crash while saving leaves the previous file intact
+*
+*/
+VkResult PipelineCache::save() {
+
+	if (cache == VK_NULL_HANDLE) {
+
+		return VK_SUCCESS;
+
+	}
+
+	size_t size = 0;
+	VkResult result = vkGetPipelineCacheData(device, cache, &size, nullptr);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	std::vector< char > data(size);
+	result = vkGetPipelineCacheData(device, cache, &size, data.data());
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+	data.resize(size);
+
+	if (!writeAtomically(fileName, data)) {
+
+		statusText = "failed to write " + fileName;
+		return VK_ERROR_INITIALIZATION_FAILED;
+
+	}
+
+	statusText = "saved " + std::to_string(size) + " bytes to " + fileName;
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void PipelineCache::destroy()
+*	Purpose:		Destroys the cache, has to be called before the device is destroyed
+*
+*/
+void PipelineCache::destroy() {
+
+	if (cache != VK_NULL_HANDLE) {
+
+		vkDestroyPipelineCache(device, cache, allocationCallbacks);
+		cache = VK_NULL_HANDLE;
+
+	}
+
+}
+
+/*
+*	Function:		VkPipelineCache PipelineCache::handle()
+*	Purpose:		Returns the cache to pass to pipeline creation
+*
+*/
+VkPipelineCache PipelineCache::handle() const {
+
+	return cache;
+
+}
+
+/*
+*	Function:		bool PipelineCache::loadedFromDisk()
+*	Purpose:		Returns whether pipeline creation starts warm
+*
+*/
+bool PipelineCache::loadedFromDisk() const {
+
+	return loaded;
+
+}
+
+/*
+*	Function:		const std::string &PipelineCache::status()
+*	Purpose:		Describes the outcome of the last load or save
+*
+*/
+const std::string &PipelineCache::status() const {
+
+	return statusText;
+
+}
+
+/*
+*	Function:		bool PipelineCache::validate(const std::vector< char > &blob, const VkPhysicalDeviceProperties &properties, std::string &reason)
+*	Purpose:		Checks the header of a cache blob against the device, sets reason if it does not match
+*
+*/
+bool PipelineCache::validate(const std::vector< char > &blob, const VkPhysicalDeviceProperties &properties, std::string &reason) {
+
+	PipelineCacheHeader header;
+	if (blob.size() < sizeof(header)) {
+
+		reason = "file too small for a header";
+		return false;
+
+	}
+	memcpy(&header, blob.data(), sizeof(header));
+
+	if (header.headerLength < sizeof(header) || header.headerLength > blob.size()) {
+
+		reason = "invalid header length " + std::to_string(header.headerLength);
+		return false;
+
+	}
+	if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+
+		reason = "unknown header version " + std::to_string(header.headerVersion);
+		return false;
+
+	}
+	if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID) {
+
+		reason = "written by vendor " + std::to_string(header.vendorID) + " device " + std::to_string(header.deviceID);
+		return false;
+
+	}
+	if (memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+
+		reason = "pipeline cache UUID differs, the driver changed";
+		return false;
+
+	}
+
+	return true;
+
+}
+
+/*
+*	Function:		bool PipelineCache::writeAtomically(const std::string &fileName, const std::vector< char > &data)
+*	Purpose:		Writes data to a temporary file and replaces fileName with it in one step
+*
+*/
+bool PipelineCache::writeAtomically(const std::string &fileName, const std::vector< char > &data) {
+
+	std::string temporaryName = fileName + ".tmp";
+
+	{
+
+		std::ofstream file(temporaryName, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file) {
+
+			return false;
+
+		}
+		file.write(data.data(), data.size());
+		file.flush();
+		if (!file) {
+
+			file.close();
+			remove(temporaryName.c_str());
+			return false;
+
+		}
+
+	}
+
+#ifdef _WIN32
+	if (!MoveFileExA(temporaryName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+	if (rename(temporaryName.c_str(), fileName.c_str()) != 0) {
+#endif
+
+		remove(temporaryName.c_str());
+		return false;
+
+	}
+
+	return true;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+PipelineCache::~PipelineCache() {
+
+	destroy();
+
+}
+
@@ -0,0 +1,57 @@
+/*
+*	File:			PipelineCache.hpp
+*	Purpose:		Contains class PipelineCache
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+*	Struct:			PipelineCacheHeader
+*	Purpose:		Header version one every VkPipelineCache blob starts with, see the Vulkan specification
+*
+*/
+struct PipelineCacheHeader {
+
+	uint32_t	headerLength;
+	uint32_t	headerVersion;
+	uint32_t	vendorID;
+	uint32_t	deviceID;
+	uint8_t		pipelineCacheUUID[VK_UUID_SIZE];
+
+};
+
+/*
+*	Class:			PipelineCache
+*	Purpose:		VkPipelineCache that is loaded from and saved to disk, a blob written by a
+*					different device or driver is discarded instead of handed to the driver
+*
+*/
+class PipelineCache
+{
+public:
+	PipelineCache(std::string fileName = "pipeline.cache");
+	VkResult create(VkDevice device, VkPhysicalDevice physicalDevice, const VkAllocationCallbacks* allocator = nullptr);
+	VkResult merge(uint32_t amountOfCaches, const VkPipelineCache* caches);
+	VkResult save(void);
+	void destroy(void);
+	VkPipelineCache handle(void) const;
+	bool loadedFromDisk(void) const;
+	const std::string &status(void) const;
+	static bool validate(const std::vector< char > &blob, const VkPhysicalDeviceProperties &properties, std::string &reason);
+	~PipelineCache();
+private:
+	static bool writeAtomically(const std::string &fileName, const std::vector< char > &data);
+
+	std::string					fileName;
+	VkDevice					device;
+	const VkAllocationCallbacks*	allocationCallbacks;
+	VkPipelineCache				cache;
+	VkPhysicalDeviceProperties	properties;
+	bool						loaded;
+	std::string					statusText;			// Why the blob was used or discarded, for the log
+};
+
@@ -0,0 +1,560 @@
+/*
+*	File:			Profiler.cpp
+*	Purpose:		Contains functions for class Profiler
+*
+*/
+#include "Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+
+namespace {
+
+	/*
+	*	Struct:			Summary
+	*	Purpose:		Distribution of one metric in the CSV summary
+	*
+	*/
+	struct Summary {
+
+		size_t	count;
+		double	minMs;
+		double	avgMs;
+		double	p50Ms;
+		double	p99Ms;
+		double	maxMs;
+
+	};
+
+	/*
+	*	Function:		Summary summarize(std::vector< uint64_t > &durationsNs)
+	*	Purpose:		Sorts the durations and returns their nearest-rank percentiles in milliseconds
+	*
+	*/
+	Summary summarize(std::vector< uint64_t > &durationsNs) {
+
+		Summary summary = {};
+		if (durationsNs.empty()) {
+
+			return summary;
+
+		}
+
+		std::sort(durationsNs.begin(), durationsNs.end());
+
+		double total = 0.0;
+		for (uint64_t duration : durationsNs) {
+
+			total += static_cast< double >(duration);
+
+		}
+
+		auto percentile = [&](double p) {
+
+			size_t rank = static_cast< size_t >(std::ceil(p * durationsNs.size()));
+			return durationsNs[rank > 0 ? rank - 1 : 0] / 1e6;
+
+		};
+
+		summary.count	= durationsNs.size();
+		summary.minMs	= durationsNs.front() / 1e6;
+		summary.avgMs	= total / durationsNs.size() / 1e6;
+		summary.p50Ms	= percentile(0.50);
+		summary.p99Ms	= percentile(0.99);
+		summary.maxMs	= durationsNs.back() / 1e6;
+
+		return summary;
+
+	}
+
+	void writeSummaryRow(std::ofstream &file, const std::string &metric, std::vector< uint64_t > &durationsNs) {
+
+		Summary summary = summarize(durationsNs);
+		file << metric << "," << summary.count << "," << summary.minMs << "," << summary.avgMs << ","
+			<< summary.p50Ms << "," << summary.p99Ms << "," << summary.maxMs << "\n";
+
+	}
+
+	/*
+	*	Function:		std::string escapeJson(const char* text)
+	*	Purpose:		Escapes quotes, backslashes and control characters of event names
+	*
+	*/
+	std::string escapeJson(const char* text) {
+
+		std::string escaped;
+		for (const char* c = text; *c != '\0'; c++) {
+
+			if (*c == '"' || *c == '\\') {
+
+				escaped += '\\';
+				escaped += *c;
+
+			}
+			else if (static_cast< unsigned char >(*c) < 0x20) {
+
+				escaped += ' ';
+
+			}
+			else {
+
+				escaped += *c;
+
+			}
+
+		}
+		return escaped;
+
+	}
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+Profiler::Profiler() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	queryPool(VK_NULL_HANDLE),
+	frameSlots(0),
+	timestampPeriod(1.0),
+	timestampMask(~0ULL),
+	gpuOffsetKnown(false),
+	gpuOffsetNs(0),
+	frames(PROFILER_FRAME_CAPACITY),
+	currentFrameNumber(0),
+	currentFrameStartNs(0),
+	previousFrameStartNs(0),
+	events(PROFILER_EVENT_CAPACITY),
+	eventCount(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult Profiler::createGpuQueries(VkDevice device, VkPhysicalDevice physicalDevice, ...)
+*	Purpose:		Creates a timestamp pair per frame slot, leaves GPU timing disabled
+*					if the queue family does not support timestamps
+*
+*/
+VkResult Profiler::createGpuQueries(VkDevice device_, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameSlots_, const VkAllocationCallbacks* allocator) {
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	uint32_t amountOfQueueFamilies = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &amountOfQueueFamilies, nullptr);
+	std::vector< VkQueueFamilyProperties > familyProperties(amountOfQueueFamilies);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &amountOfQueueFamilies, familyProperties.data());
+
+	uint32_t validBits = queueFamilyIndex < amountOfQueueFamilies ? familyProperties[queueFamilyIndex].timestampValidBits : 0;
+	if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+
+		return VK_SUCCESS;
+
+	}
+
+	timestampPeriod		= properties.limits.timestampPeriod;
+	timestampMask		= validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1;
+
+	VkQueryPoolCreateInfo queryPoolCreateInfo;
+	queryPoolCreateInfo.sType					= VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolCreateInfo.pNext					= nullptr;
+	queryPoolCreateInfo.flags					= 0;
+	queryPoolCreateInfo.queryType				= VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolCreateInfo.queryCount				= frameSlots_ * 2;
+	queryPoolCreateInfo.pipelineStatistics		= 0;
+
+	VkResult result = vkCreateQueryPool(device_, &queryPoolCreateInfo, allocator, &queryPool);
+	if (result != VK_SUCCESS) {
+
+		queryPool = VK_NULL_HANDLE;
+		return result;
+
+	}
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+	frameSlots			= frameSlots_;
+	slotFrameNumbers.assign(frameSlots, UINT64_MAX);
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void Profiler::destroyGpuQueries()
+*	Purpose:		Destroys the query pool, has to be called before the device is destroyed
+*
+*/
+void Profiler::destroyGpuQueries() {
+
+	if (queryPool != VK_NULL_HANDLE) {
+
+		vkDestroyQueryPool(device, queryPool, allocationCallbacks);
+		queryPool = VK_NULL_HANDLE;
+
+	}
+
+}
+
+/*
+*	Function:		bool Profiler::gpuTimingSupported()
+*	Purpose:		Returns whether render pass durations are measured
+*
+*/
+bool Profiler::gpuTimingSupported() const {
+
+	return queryPool != VK_NULL_HANDLE;
+
+}
+
+/*
+*	Function:		void Profiler::cmdBeginGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot, uint64_t frameNumber)
+*	Purpose:		Records the start timestamp of a frame, must be recorded outside of a render pass
+*
+*/
+void Profiler::cmdBeginGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot, uint64_t frameNumber) {
+
+	if (queryPool == VK_NULL_HANDLE) {
+
+		return;
+
+	}
+
+	vkCmdResetQueryPool(commandBuffer, queryPool, slot * 2, 2);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, slot * 2);
+	slotFrameNumbers[slot] = frameNumber;
+
+}
+
+/*
+*	Function:		void Profiler::cmdEndGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot)
+*	Purpose:		Records the end timestamp of a frame
+*
+*/
+void Profiler::cmdEndGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot) {
+
+	if (queryPool == VK_NULL_HANDLE) {
+
+		return;
+
+	}
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, slot * 2 + 1);
+
+}
+
+/*
+*	Function:		void Profiler::collectGpuFrame(uint32_t slot)
+*	Purpose:		Reads the timestamps of a slot whose fence has been waited on
+*					and stores them with the frame that wrote them
+*
+*/
+void Profiler::collectGpuFrame(uint32_t slot) {
+
+	if (queryPool == VK_NULL_HANDLE || slotFrameNumbers[slot] == UINT64_MAX) {
+
+		return;
+
+	}
+
+	uint64_t timestamps[2];
+	VkResult result = vkGetQueryPoolResults(
+
+		device,
+		queryPool,
+		slot * 2,
+		2,
+		sizeof(timestamps),
+		timestamps,
+		sizeof(uint64_t),
+		VK_QUERY_RESULT_64_BIT
+
+	);
+
+	uint64_t frameNumber = slotFrameNumbers[slot];
+	slotFrameNumbers[slot] = UINT64_MAX;
+	if (result != VK_SUCCESS) {
+
+		return;
+
+	}
+
+	Frame &frame = frames[frameNumber % PROFILER_FRAME_CAPACITY];
+	if (!frame.valid || frame.frameNumber != frameNumber) {
+
+		return;
+
+	}
+
+	uint64_t begin	= static_cast< uint64_t >((timestamps[0] & timestampMask) * timestampPeriod);
+	uint64_t end	= static_cast< uint64_t >((timestamps[1] & timestampMask) * timestampPeriod);
+
+	// Without calibrated timestamps the GPU clock is anchored once, assuming the first
+	// measured frame started executing when it began recording, later drift is not corrected
+	if (!gpuOffsetKnown) {
+
+		gpuOffsetNs		= static_cast< int64_t >(frame.startNs) - static_cast< int64_t >(begin);
+		gpuOffsetKnown	= true;
+
+	}
+
+	frame.gpuStartNs	= static_cast< uint64_t >(static_cast< int64_t >(begin) + gpuOffsetNs);
+	frame.gpuNs			= end > begin ? end - begin : 0;
+
+}
+
+/*
+*	Function:		void Profiler::beginFrame(uint64_t frameNumber)
+*	Purpose:		Starts the CPU timing of a frame
+*
+*/
+void Profiler::beginFrame(uint64_t frameNumber) {
+
+	previousFrameStartNs	= currentFrameStartNs;
+	currentFrameNumber		= frameNumber;
+	currentFrameStartNs		= nowNanoseconds();
+
+}
+
+/*
+*	Function:		void Profiler::endFrame()
+*	Purpose:		Stores the CPU timing of the frame started by beginFrame
+*
+*/
+void Profiler::endFrame() {
+
+	Frame &frame = frames[currentFrameNumber % PROFILER_FRAME_CAPACITY];
+	frame.frameNumber	= currentFrameNumber;
+	frame.startNs		= currentFrameStartNs;
+	frame.cpuNs			= nowNanoseconds() - currentFrameStartNs;
+	frame.intervalNs	= previousFrameStartNs != 0 ? currentFrameStartNs - previousFrameStartNs : 0;
+	frame.gpuStartNs	= 0;
+	frame.gpuNs			= 0;
+	frame.valid			= true;
+
+}
+
+/*
+*	Function:		void Profiler::addEvent(const char* name, uint64_t startNs, uint64_t endNs)
+*	Purpose:		Stores a finished CPU scope, may be called from any thread
+*
+*/
+void Profiler::addEvent(const char* name, uint64_t startNs, uint64_t endNs) {
+
+	uint32_t thread = threadIndex();
+
+	std::lock_guard< std::mutex > lock(eventMutex);
+	Event &event = events[eventCount % PROFILER_EVENT_CAPACITY];
+	event.name			= name;
+	event.startNs		= startNs;
+	event.durationNs	= endNs - startNs;
+	event.thread		= thread;
+	eventCount++;
+
+}
+
+/*
+*	Function:		bool Profiler::exportChromeTrace(const std::string &fileName)
+*	Purpose:		Writes the stored events and frames in Chrome trace_event format,
+*					open the file in chrome://tracing or ui.perfetto.dev
+*
+*/
+bool Profiler::exportChromeTrace(const std::string &fileName) {
+
+	std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+	if (!file) {
+
+		return false;
+
+	}
+
+	// Timestamps are written relative to the oldest stored entry, in microseconds
+	std::lock_guard< std::mutex > lock(eventMutex);
+	size_t storedEvents = static_cast< size_t >(std::min< uint64_t >(eventCount, PROFILER_EVENT_CAPACITY));
+	uint64_t firstEvent = eventCount - storedEvents;
+
+	uint64_t originNs = UINT64_MAX;
+	for (size_t i = 0; i < storedEvents; i++) {
+
+		originNs = std::min(originNs, events[(firstEvent + i) % PROFILER_EVENT_CAPACITY].startNs);
+
+	}
+	for (const Frame &frame : frames) {
+
+		if (frame.valid) {
+
+			originNs = std::min(originNs, frame.startNs);
+			if (frame.gpuNs != 0) {
+
+				originNs = std::min(originNs, frame.gpuStartNs);
+
+			}
+
+		}
+
+	}
+	if (originNs == UINT64_MAX) {
+
+		originNs = 0;
+
+	}
+
+	auto microseconds = [originNs](uint64_t ns) { return (static_cast< double >(ns) - static_cast< double >(originNs)) / 1000.0; };
+
+	file.precision(3);
+	file << std::fixed;
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}},\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Frames\"}}";
+
+	for (size_t i = 0; i < storedEvents; i++) {
+
+		const Event &event = events[(firstEvent + i) % PROFILER_EVENT_CAPACITY];
+		file << ",\n{\"name\":\"" << escapeJson(event.name) << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread + 2
+			<< ",\"ts\":" << microseconds(event.startNs) << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+
+	}
+
+	for (const Frame &frame : frames) {
+
+		if (!frame.valid) {
+
+			continue;
+
+		}
+
+		file << ",\n{\"name\":\"frame " << frame.frameNumber << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+			<< microseconds(frame.startNs) << ",\"dur\":" << frame.cpuNs / 1000.0 << "}";
+
+		if (frame.gpuNs != 0) {
+
+			file << ",\n{\"name\":\"render pass " << frame.frameNumber << "\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":"
+				<< microseconds(frame.gpuStartNs) << ",\"dur\":" << frame.gpuNs / 1000.0 << "}";
+
+		}
+
+	}
+
+	file << "\n]}\n";
+
+	return static_cast< bool >(file);
+
+}
+
+/*
+*	Function:		bool Profiler::exportSummary(const std::string &fileName)
+*	Purpose:		Writes count, min, average, p50, p99 and max of the frame times and of every CPU scope as CSV
+*
+*/
+bool Profiler::exportSummary(const std::string &fileName) {
+
+	std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+	if (!file) {
+
+		return false;
+
+	}
+
+	std::vector< uint64_t > intervals;
+	std::vector< uint64_t > cpuTimes;
+	std::vector< uint64_t > gpuTimes;
+	for (const Frame &frame : frames) {
+
+		if (!frame.valid) {
+
+			continue;
+
+		}
+
+		if (frame.intervalNs != 0) {
+
+			intervals.push_back(frame.intervalNs);
+
+		}
+		cpuTimes.push_back(frame.cpuNs);
+		if (frame.gpuNs != 0) {
+
+			gpuTimes.push_back(frame.gpuNs);
+
+		}
+
+	}
+
+	// Grouped by name, string literals of different call sites may share a name
+	std::map< std::string, std::vector< uint64_t > > scopes;
+	{
+
+		std::lock_guard< std::mutex > lock(eventMutex);
+		size_t storedEvents = static_cast< size_t >(std::min< uint64_t >(eventCount, PROFILER_EVENT_CAPACITY));
+		uint64_t firstEvent = eventCount - storedEvents;
+		for (size_t i = 0; i < storedEvents; i++) {
+
+			const Event &event = events[(firstEvent + i) % PROFILER_EVENT_CAPACITY];
+			scopes[event.name].push_back(event.durationNs);
+
+		}
+
+	}
+
+	file << "metric,count,min_ms,avg_ms,p50_ms,p99_ms,max_ms\n";
+	writeSummaryRow(file, "frame_interval", intervals);
+	writeSummaryRow(file, "frame_cpu", cpuTimes);
+	writeSummaryRow(file, "frame_gpu", gpuTimes);
+	for (auto &scope : scopes) {
+
+		writeSummaryRow(file, scope.first, scope.second);
+
+	}
+
+	return static_cast< bool >(file);
+
+}
+
+/*
+*	Function:		uint64_t Profiler::nowNanoseconds()
+*	Purpose:		Monotonic CPU clock of all profiler timestamps
+*
+*/
+uint64_t Profiler::nowNanoseconds() {
+
+	return static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+
+		std::chrono::steady_clock::now().time_since_epoch()
+
+	).count());
+
+}
+
+/*
+*	Function:		uint32_t Profiler::threadIndex()
+*	Purpose:		Returns a small, stable number of the calling thread for the trace
+*
+*/
+uint32_t Profiler::threadIndex() {
+
+	static std::atomic< uint32_t > nextIndex(0);
+	thread_local uint32_t index = nextIndex.fetch_add(1);
+
+	return index;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+Profiler::~Profiler() {
+
+	destroyGpuQueries();
+
+}
+
@@ -0,0 +1,141 @@
+/*
+*	File:			Profiler.hpp
+*	Purpose:		Contains class Profiler
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+#define PROFILER_EVENT_CAPACITY		65536		// CPU scopes kept for export, older ones are overwritten
+#define PROFILER_FRAME_CAPACITY		4096		// Frames kept for export, older ones are overwritten
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED			1			// 0 compiles every PROFILE_ macro out, override per build configuration
+#endif
+
+#define PROFILER_CONCAT_(a, b)		a##b
+#define PROFILER_CONCAT(a, b)		PROFILER_CONCAT_(a, b)
+
+/*
+*	Makro:			PROFILE_SCOPE(profiler, name)
+*					PROFILE_PHASE(profiler, phase, name) / PROFILE_NEXT(phase, name)
+*	Purpose:		PROFILE_SCOPE times the enclosing block, PROFILE_PHASE starts a named timer
+*					that PROFILE_NEXT closes and restarts under a new name, so consecutive
+*					phases of one function can be timed without adding blocks
+*
+*/
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(profiler, name)			ProfileScope PROFILER_CONCAT(profileScope, __LINE__)(profiler, name)
+#define PROFILE_PHASE(profiler, phase, name)	ProfileScope phase(profiler, name)
+#define PROFILE_NEXT(phase, name)				phase.next(name)
+#else
+#define PROFILE_SCOPE(profiler, name)			((void)0)
+#define PROFILE_PHASE(profiler, phase, name)	((void)0)
+#define PROFILE_NEXT(phase, name)				((void)0)
+#endif
+
+class Profiler
+{
+public:
+	Profiler();
+	VkResult createGpuQueries(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameSlots, const VkAllocationCallbacks* allocator = nullptr);
+	void destroyGpuQueries(void);
+	bool gpuTimingSupported(void) const;
+	void cmdBeginGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot, uint64_t frameNumber);
+	void cmdEndGpuFrame(VkCommandBuffer commandBuffer, uint32_t slot);
+	void collectGpuFrame(uint32_t slot);
+	void beginFrame(uint64_t frameNumber);
+	void endFrame(void);
+	void addEvent(const char* name, uint64_t startNs, uint64_t endNs);
+	bool exportChromeTrace(const std::string &fileName);
+	bool exportSummary(const std::string &fileName);
+	static uint64_t nowNanoseconds(void);
+	~Profiler();
+private:
+	/*
+	*	Struct:			Profiler::Event
+	*	Purpose:		One finished CPU scope, name has to be a string literal
+	*
+	*/
+	struct Event {
+
+		const char*		name;
+		uint64_t		startNs;
+		uint64_t		durationNs;
+		uint32_t		thread;
+
+	};
+
+	/*
+	*	Struct:			Profiler::Frame
+	*	Purpose:		Timings of one frame, GPU values arrive MAX_FRAMES_IN_FLIGHT frames later
+	*
+	*/
+	struct Frame {
+
+		uint64_t		frameNumber;
+		uint64_t		startNs;
+		uint64_t		cpuNs;					// Time spent between beginFrame and endFrame
+		uint64_t		intervalNs;				// Time since the previous beginFrame, 0 for the first frame
+		uint64_t		gpuStartNs;				// Mapped to the CPU clock, see collectGpuFrame
+		uint64_t		gpuNs;					// Render pass duration, 0 if not measured
+		bool			valid;
+
+	};
+
+	static uint32_t threadIndex(void);
+
+	VkDevice					device;
+	const VkAllocationCallbacks*	allocationCallbacks;
+	VkQueryPool					queryPool;
+	uint32_t					frameSlots;
+	std::vector< uint64_t >		slotFrameNumbers;		// Frame whose timestamps a slot holds, UINT64_MAX if none
+	double						timestampPeriod;		// Nanoseconds per timestamp tick
+	uint64_t					timestampMask;
+	bool						gpuOffsetKnown;
+	int64_t						gpuOffsetNs;			// CPU clock minus GPU clock
+
+	std::vector< Frame >		frames;
+	uint64_t					currentFrameNumber;
+	uint64_t					currentFrameStartNs;
+	uint64_t					previousFrameStartNs;
+
+	std::vector< Event >		events;
+	uint64_t					eventCount;				// Events ever added, the ring holds the newest
+	std::mutex					eventMutex;
+};
+
+/*
+*	Class:			ProfileScope
+*	Purpose:		Adds the time between construction (or next()) and destruction as event
+*
+*/
+class ProfileScope
+{
+public:
+	ProfileScope(Profiler &profiler_, const char* name_) : profiler(profiler_), name(name_), startNs(Profiler::nowNanoseconds()) {}
+
+	void next(const char* name_) {
+
+		uint64_t now = Profiler::nowNanoseconds();
+		profiler.addEvent(name, startNs, now);
+		name	= name_;
+		startNs	= now;
+
+	}
+
+	~ProfileScope() {
+
+		profiler.addEvent(name, startNs, Profiler::nowNanoseconds());
+
+	}
+private:
+	Profiler		&profiler;
+	const char*		name;
+	uint64_t		startNs;
+};
+
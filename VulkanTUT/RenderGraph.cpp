@@ -0,0 +1,1611 @@
+/*
+*	File:			RenderGraph.cpp
+*	Purpose:		Contains functions for class RenderGraph
+*
+*/
+#include "RenderGraph.hpp"
+#include <algorithm>
+
+/*
+*	Function:		static VkAccessFlags writeAccessOf(VkAccessFlags access)
+*	Purpose:		Keeps the write bits of an access mask, only writes have to be made available
+*
+*/
+static VkAccessFlags writeAccessOf(VkAccessFlags access) {
+
+	return access & (
+
+		VK_ACCESS_SHADER_WRITE_BIT |
+		VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+		VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+		VK_ACCESS_TRANSFER_WRITE_BIT |
+		VK_ACCESS_HOST_WRITE_BIT |
+		VK_ACCESS_MEMORY_WRITE_BIT
+
+	);
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+RenderGraph::RenderGraph() :
+	device(VK_NULL_HANDLE),
+	memoryAllocator(nullptr),
+	allocationCallbacks(nullptr),
+	dynamicRendering(false),
+#ifdef VK_KHR_dynamic_rendering
+	cmdBeginRendering(nullptr),
+	cmdEndRendering(nullptr),
+#endif
+	extent({ 0, 0 }),
+	aliasedBytes(0),
+	separateBytes(0) {
+
+
+
+}
+
+/*
+*	Function:		void RenderGraph::init(VkDevice device, MemoryAllocator &allocator, const VkAllocationCallbacks* allocationCallbacks, bool dynamicRendering)
+*	Purpose:		Sets the device and the allocator the render passes and transient images are created with
+*					dynamicRendering needs the VK_KHR_dynamic_rendering feature enabled on the device,
+*					render passes are used if the headers or the device lack it
+*
+*/
+void RenderGraph::init(VkDevice device_, MemoryAllocator &allocator, const VkAllocationCallbacks* allocationCallbacks_, bool dynamicRendering_) {
+
+	device				= device_;
+	memoryAllocator		= &allocator;
+	allocationCallbacks	= allocationCallbacks_;
+	dynamicRendering	= false;
+
+#ifdef VK_KHR_dynamic_rendering
+	if (dynamicRendering_) {
+
+		cmdBeginRendering	= reinterpret_cast< PFN_vkCmdBeginRenderingKHR >(vkGetDeviceProcAddr(device, "vkCmdBeginRenderingKHR"));
+		cmdEndRendering		= reinterpret_cast< PFN_vkCmdEndRenderingKHR >(vkGetDeviceProcAddr(device, "vkCmdEndRenderingKHR"));
+		dynamicRendering	= cmdBeginRendering != nullptr && cmdEndRendering != nullptr;
+
+	}
+#endif
+
+}
+
+/*
+*	Function:		uint32_t RenderGraph::importImage(const char* name, VkFormat format, VkImageLayout initialLayout, VkPipelineStageFlags initialStage, VkImageLayout finalLayout)
+*	Purpose:		Adds a color image owned by the caller, in initialLayout once initialStage finished at the start of every frame
+*					and left in finalLayout, set its handles with setImage() before creating framebuffers and executing
+*
+*/
+uint32_t RenderGraph::importImage(const char* name, VkFormat format, VkImageLayout initialLayout, VkPipelineStageFlags initialStage, VkImageLayout finalLayout) {
+
+	Resource resource	= {};
+	resource.name			= name;
+	resource.isImage		= true;
+	resource.imported		= true;
+	resource.format			= format;
+	resource.samples		= VK_SAMPLE_COUNT_1_BIT;
+	resource.initialLayout	= initialLayout;
+	resource.initialStage	= initialStage;
+	resource.finalLayout	= finalLayout;
+	resource.firstPass		= RENDER_GRAPH_INVALID;
+	resource.lastPass		= RENDER_GRAPH_INVALID;
+	resource.slot			= RENDER_GRAPH_INVALID;
+	resources.push_back(resource);
+
+	return static_cast< uint32_t >(resources.size() - 1);
+
+}
+
+/*
+*	Function:		uint32_t RenderGraph::importBuffer(const char* name, VkPipelineStageFlags finalStage, VkAccessFlags finalAccess)
+*	Purpose:		Adds a buffer owned by the caller, its writes are made visible to finalAccess of finalStage
+*					at the end of the frame, VK_PIPELINE_STAGE_HOST_BIT for buffers read back after the fence
+*
+*/
+uint32_t RenderGraph::importBuffer(const char* name, VkPipelineStageFlags finalStage, VkAccessFlags finalAccess) {
+
+	Resource resource	= {};
+	resource.name			= name;
+	resource.isImage		= false;
+	resource.imported		= true;
+	resource.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+	resource.finalLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+	resource.finalStage		= finalStage;
+	resource.finalAccess	= finalAccess;
+	resource.firstPass		= RENDER_GRAPH_INVALID;
+	resource.lastPass		= RENDER_GRAPH_INVALID;
+	resource.slot			= RENDER_GRAPH_INVALID;
+	resources.push_back(resource);
+
+	return static_cast< uint32_t >(resources.size() - 1);
+
+}
+
+/*
+*	Function:		uint32_t RenderGraph::createImage(const char* name, VkFormat format, VkSampleCountFlagBits samples)
+*	Purpose:		Adds a transient color image of the graph extent, its contents do not survive the frame
+*					resize() creates it with the usage its passes need
+*
+*/
+uint32_t RenderGraph::createImage(const char* name, VkFormat format, VkSampleCountFlagBits samples) {
+
+	Resource resource	= {};
+	resource.name			= name;
+	resource.isImage		= true;
+	resource.imported		= false;
+	resource.format			= format;
+	resource.samples		= samples;
+	resource.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+	resource.finalLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+	resource.firstPass		= RENDER_GRAPH_INVALID;
+	resource.lastPass		= RENDER_GRAPH_INVALID;
+	resource.slot			= RENDER_GRAPH_INVALID;
+	resources.push_back(resource);
+
+	return static_cast< uint32_t >(resources.size() - 1);
+
+}
+
+/*
+*	Function:		uint32_t RenderGraph::addPass(const char* name, RenderPassType type, RenderPassFunction record, VkSubpassContents contents)
+*	Purpose:		Appends a pass, passes execute in the order they were added
+*					Graphics passes recording secondary command buffers pass VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+*
+*/
+uint32_t RenderGraph::addPass(const char* name, RenderPassType type, RenderPassFunction record, VkSubpassContents contents) {
+
+	Pass pass;
+	pass.name		= name;
+	pass.type		= type;
+	pass.record		= record;
+	pass.contents	= contents;
+	pass.step		= RENDER_GRAPH_INVALID;
+	pass.subpass	= 0;
+	passes.push_back(pass);
+
+	return static_cast< uint32_t >(passes.size() - 1);
+
+}
+
+/*
+*	Function:		void RenderGraph::colorAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor)
+*	Purpose:		Renders a graphics pass to the image, color attachments are numbered in the order they are declared
+*
+*/
+void RenderGraph::colorAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor) {
+
+	VkAccessFlags access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	if (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD) {
+
+		access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+
+	}
+
+	uint32_t use = addUse(
+
+		pass,
+		image,
+		VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+		access,
+		VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+		true,
+		ATTACHMENT_TYPE_COLOR
+
+	);
+	passes[pass].uses[use].loadOp		= loadOp;
+	passes[pass].uses[use].clearColor	= clearColor;
+
+}
+
+/*
+*	Function:		void RenderGraph::resolveAttachment(uint32_t pass, uint32_t image)
+*	Purpose:		Resolves a multisampled color attachment of the pass into the image at the end of the subpass,
+*					the n-th resolve attachment resolves the n-th color attachment
+*
+*/
+void RenderGraph::resolveAttachment(uint32_t pass, uint32_t image) {
+
+	addUse(
+
+		pass,
+		image,
+		VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+		VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+		VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+		true,
+		ATTACHMENT_TYPE_RESOLVE
+
+	);
+
+}
+
+/*
+*	Function:		void RenderGraph::inputAttachment(uint32_t pass, uint32_t image)
+*	Purpose:		Reads the image at the current pixel with subpassLoad(), lets the writing pass become an earlier subpass
+*
+*/
+void RenderGraph::inputAttachment(uint32_t pass, uint32_t image) {
+
+	addUse(
+
+		pass,
+		image,
+		VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		false,
+		ATTACHMENT_TYPE_INPUT
+
+	);
+
+}
+
+/*
+*	Function:		void RenderGraph::read(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout)
+*	Purpose:		Declares a read outside of attachments, images have to be in layout while the pass runs
+*
+*/
+void RenderGraph::read(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout) {
+
+	addUse(pass, resource, stage, access, layout, false, ATTACHMENT_TYPE_NONE);
+
+}
+
+/*
+*	Function:		void RenderGraph::write(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout)
+*	Purpose:		Declares a write outside of attachments, access includes the reads of the same stages
+*
+*/
+void RenderGraph::write(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout) {
+
+	addUse(pass, resource, stage, access, layout, true, ATTACHMENT_TYPE_NONE);
+
+}
+
+/*
+*	Function:		uint32_t RenderGraph::addUse(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout, bool write, AttachmentType attachment)
+*	Purpose:		Adds a use to a pass and returns its index, barriers cannot order accesses of one pass,
+*					so reads and writes of a resource outside of attachments become one use
+*
+*/
+uint32_t RenderGraph::addUse(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout, bool write, AttachmentType attachment) {
+
+	std::vector< Use > &uses = passes[pass].uses;
+	if (attachment == ATTACHMENT_TYPE_NONE) {
+
+		for (size_t i = 0; i < uses.size(); i++) {
+
+			if (uses[i].resource == resource && uses[i].attachment == ATTACHMENT_TYPE_NONE) {
+
+				uses[i].stage	|= stage;
+				uses[i].access	|= access;
+				uses[i].write	= uses[i].write || write;
+				return static_cast< uint32_t >(i);
+
+			}
+
+		}
+
+	}
+
+	Use use				= {};
+	use.resource		= resource;
+	use.stage			= stage;
+	use.access			= access;
+	use.layout			= resources[resource].isImage ? layout : VK_IMAGE_LAYOUT_UNDEFINED;
+	use.write			= write;
+	use.attachment		= attachment;
+	use.loadOp			= VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	use.synchronized	= false;
+	uses.push_back(use);
+
+	return static_cast< uint32_t >(uses.size() - 1);
+
+}
+
+/*
+*	Function:		VkResult RenderGraph::compile()
+*	Purpose:		Merges the passes into steps, creates their render passes and plans every barrier and the
+*					memory slots of the transient images, call once after declaring everything and before resize()
+*
+*/
+VkResult RenderGraph::compile() {
+
+	for (Step &step : steps) {
+
+		if (step.renderPass != VK_NULL_HANDLE) {
+
+			vkDestroyRenderPass(device, step.renderPass, allocationCallbacks);
+
+		}
+
+	}
+	steps.clear();
+	finalBarriers.clear();
+
+	for (Resource &resource : resources) {
+
+		resource.firstPass	= RENDER_GRAPH_INVALID;
+		resource.lastPass	= RENDER_GRAPH_INVALID;
+		resource.usage		= 0;
+
+	}
+	for (uint32_t p = 0; p < passes.size(); p++) {
+
+		for (Use &use : passes[p].uses) {
+
+			// Reading attachments in the fragment shader takes subpasses
+			if (use.attachment == ATTACHMENT_TYPE_INPUT) {
+
+				dynamicRendering = false;
+
+			}
+
+			Resource &resource = resources[use.resource];
+			if (resource.firstPass == RENDER_GRAPH_INVALID) {
+
+				resource.firstPass = p;
+
+			}
+			resource.lastPass	= p;
+			use.synchronized	= false;
+
+		}
+
+	}
+
+	mergePasses();
+	planTransients();
+
+	std::vector< State > states;
+	for (const Resource &resource : resources) {
+
+		states.push_back(initialState(resource));
+
+	}
+
+	for (Step &step : steps) {
+
+		if (passes[step.firstPass].type == RENDER_PASS_TYPE_GRAPHICS && dynamicRendering) {
+
+			planRendering(step, states);
+			continue;
+
+		}
+		if (passes[step.firstPass].type == RENDER_PASS_TYPE_GRAPHICS) {
+
+			VkResult result = createRenderPass(step, states);
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+			continue;
+
+		}
+
+		for (const Use &use : passes[step.firstPass].uses) {
+
+			Barrier barrier;
+			if (!use.synchronized && synchronize(states[use.resource], use, barrier)) {
+
+				step.barriers.push_back(barrier);
+
+			}
+
+		}
+
+	}
+
+	// Hand imported resources over in the state the next frame or the host expects
+	for (uint32_t r = 0; r < resources.size(); r++) {
+
+		const Resource &resource = resources[r];
+		if (!resource.imported || resource.firstPass == RENDER_GRAPH_INVALID) {
+
+			continue;
+
+		}
+
+		Use use				= {};
+		use.resource		= r;
+		use.write			= false;
+		use.attachment		= ATTACHMENT_TYPE_NONE;
+		if (resource.isImage) {
+
+			if (resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.finalLayout == states[r].layout) {
+
+				continue;
+
+			}
+			use.stage	= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			use.access	= 0;
+			use.layout	= resource.finalLayout;
+
+		}
+		else {
+
+			if (resource.finalStage == 0) {
+
+				continue;
+
+			}
+			use.stage	= resource.finalStage;
+			use.access	= resource.finalAccess;
+			use.layout	= VK_IMAGE_LAYOUT_UNDEFINED;
+
+		}
+
+		Barrier barrier;
+		if (synchronize(states[r], use, barrier)) {
+
+			finalBarriers.push_back(barrier);
+
+		}
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void RenderGraph::mergePasses()
+*	Purpose:		Groups the passes into steps, a graphics pass joins the render pass of the graphics passes
+*					before it unless it shares a resource with them outside of attachments, which would need a
+*					barrier inside the render pass, with dynamic rendering every pass is a step of its own
+*
+*/
+void RenderGraph::mergePasses() {
+
+	for (uint32_t p = 0; p < passes.size(); p++) {
+
+		Pass &pass = passes[p];
+		bool merge = !dynamicRendering && !steps.empty() && pass.type == RENDER_PASS_TYPE_GRAPHICS && passes[steps.back().firstPass].type == RENDER_PASS_TYPE_GRAPHICS;
+
+		for (uint32_t q = merge ? steps.back().firstPass : p; merge && q < p; q++) {
+
+			for (const Use &earlier : passes[q].uses) {
+
+				for (const Use &use : pass.uses) {
+
+					if (earlier.resource == use.resource && (earlier.attachment == ATTACHMENT_TYPE_NONE || use.attachment == ATTACHMENT_TYPE_NONE)) {
+
+						merge = false;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		if (merge) {
+
+			pass.step		= static_cast< uint32_t >(steps.size() - 1);
+			pass.subpass	= steps.back().amountOfPasses++;
+
+		}
+		else {
+
+			Step step;
+			step.firstPass		= p;
+			step.amountOfPasses	= 1;
+			step.renderPass		= VK_NULL_HANDLE;
+			step.framebuffer	= VK_NULL_HANDLE;
+			step.samples		= VK_SAMPLE_COUNT_1_BIT;
+			steps.push_back(step);
+
+			pass.step		= static_cast< uint32_t >(steps.size() - 1);
+			pass.subpass	= 0;
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		void RenderGraph::planTransients()
+*	Purpose:		Derives the usage of the transient images and assigns them to memory slots, an image joins
+*					a slot whose images are done before its first pass, every image then waits for the last
+*					uses of all images of its slot, those of the previous frame included
+*
+*/
+void RenderGraph::planTransients() {
+
+	slots.clear();
+
+	std::vector< uint32_t > order;
+	for (uint32_t r = 0; r < resources.size(); r++) {
+
+		Resource &resource = resources[r];
+		resource.slot = RENDER_GRAPH_INVALID;
+		if (resource.imported || resource.firstPass == RENDER_GRAPH_INVALID) {
+
+			continue;
+
+		}
+
+		bool attachmentsOnly = true;
+		for (uint32_t p = resource.firstPass; p <= resource.lastPass; p++) {
+
+			for (const Use &use : passes[p].uses) {
+
+				if (use.resource != r) {
+
+					continue;
+
+				}
+
+				switch (use.attachment) {
+
+				case ATTACHMENT_TYPE_COLOR:
+				case ATTACHMENT_TYPE_RESOLVE:
+					resource.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+					attachmentsOnly = attachmentsOnly && use.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD;
+					break;
+				case ATTACHMENT_TYPE_INPUT:
+					resource.usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+					break;
+				default:
+					attachmentsOnly = false;
+					resource.usage |= (use.access & VK_ACCESS_SHADER_READ_BIT) ? VK_IMAGE_USAGE_SAMPLED_BIT : 0;
+					resource.usage |= (use.access & VK_ACCESS_SHADER_WRITE_BIT) ? VK_IMAGE_USAGE_STORAGE_BIT : 0;
+					resource.usage |= (use.access & VK_ACCESS_TRANSFER_READ_BIT) ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0;
+					resource.usage |= (use.access & VK_ACCESS_TRANSFER_WRITE_BIT) ? VK_IMAGE_USAGE_TRANSFER_DST_BIT : 0;
+					break;
+
+				}
+
+			}
+
+		}
+
+		// Never leaving one render pass, tiled GPUs keep it in tile memory and back it with nothing
+		if (attachmentsOnly && passes[resource.firstPass].step == passes[resource.lastPass].step) {
+
+			resource.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
+		}
+		order.push_back(r);
+
+	}
+
+	std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+
+		return resources[a].firstPass < resources[b].firstPass;
+
+	});
+
+	std::vector< uint32_t > slotEnd;
+	for (uint32_t r : order) {
+
+		Resource &resource	= resources[r];
+		bool lazy			= (resource.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0;
+
+		for (uint32_t s = 0; s < slots.size(); s++) {
+
+			if (slots[s].lazy == lazy && slotEnd[s] < resource.firstPass) {
+
+				resource.slot = s;
+				break;
+
+			}
+
+		}
+		if (resource.slot == RENDER_GRAPH_INVALID) {
+
+			Slot slot			= {};
+			slot.lazy			= lazy;
+			resource.slot		= static_cast< uint32_t >(slots.size());
+			slots.push_back(slot);
+			slotEnd.push_back(0);
+
+		}
+		slots[resource.slot].images.push_back(r);
+		slotEnd[resource.slot] = resource.lastPass;
+
+	}
+
+	for (const Slot &slot : slots) {
+
+		VkPipelineStageFlags stage	= 0;
+		VkAccessFlags access		= 0;
+		for (uint32_t r : slot.images) {
+
+			for (const Use &use : passes[resources[r].lastPass].uses) {
+
+				if (use.resource == r) {
+
+					stage	|= use.stage;
+					access	|= use.write ? writeAccessOf(use.access) : 0;
+
+				}
+
+			}
+
+		}
+		for (uint32_t r : slot.images) {
+
+			resources[r].aliasStage		= stage;
+			resources[r].aliasAccess	= access;
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		RenderGraph::State RenderGraph::initialState(const Resource &resource) const
+*	Purpose:		State of a resource when the frame starts
+*
+*/
+RenderGraph::State RenderGraph::initialState(const Resource &resource) const {
+
+	State state = {};
+	if (resource.imported) {
+
+		state.layout		= resource.initialLayout;
+		state.writeStage	= resource.initialStage;
+
+	}
+	else {
+
+		state.layout		= VK_IMAGE_LAYOUT_UNDEFINED;
+		state.writeStage	= resource.aliasStage;
+		state.writeAccess	= resource.aliasAccess;
+
+	}
+
+	return state;
+
+}
+
+/*
+*	Function:		bool RenderGraph::synchronize(State &state, const Use &use, Barrier &barrier) const
+*	Purpose:		Fills the barrier a use needs and moves the state past the use, returns false if it needs none
+*					Writes wait for the last write and every read since, reads wait for the last write unless
+*					it is already visible to their stage and access, layout changes always need a barrier
+*
+*/
+bool RenderGraph::synchronize(State &state, const Use &use, Barrier &barrier) const {
+
+	bool transition = resources[use.resource].isImage && use.layout != state.layout;
+
+	barrier.resource	= use.resource;
+	barrier.dstStage	= use.stage;
+	barrier.dstAccess	= use.access;
+	barrier.oldLayout	= state.layout;
+	barrier.newLayout	= transition ? use.layout : state.layout;
+	barrier.srcAccess	= state.writeAccess;
+
+	bool needed;
+	if (use.write) {
+
+		needed				= transition || state.writeStage != 0 || state.readStages != 0;
+		barrier.srcStage	= state.writeStage | state.readStages;
+
+		state.writeStage	= use.stage;
+		state.writeAccess	= writeAccessOf(use.access);
+		state.readStages	= 0;
+		state.visibleStages	= 0;
+		state.visibleAccess	= 0;
+
+	}
+	else {
+
+		bool visible		= (use.stage & ~state.visibleStages) == 0 && (use.access & ~state.visibleAccess) == 0;
+		needed				= transition || (state.writeStage != 0 && !visible);
+		barrier.srcStage	= state.writeStage | (transition ? state.readStages : 0);
+
+		if (transition) {
+
+			// The transition is a write of the barrier, later stages chain onto its destination
+			state.writeStage	= use.stage;
+			state.writeAccess	= 0;
+			state.readStages	= use.stage;
+			state.visibleStages	= use.stage;
+			state.visibleAccess	= use.access;
+
+		}
+		else {
+
+			state.readStages		|= use.stage;
+			if (needed) {
+
+				state.visibleStages	|= use.stage;
+				state.visibleAccess	|= use.access;
+
+			}
+
+		}
+
+	}
+	state.layout = barrier.newLayout;
+
+	if (barrier.srcStage == 0) {
+
+		barrier.srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+	}
+
+	return needed;
+
+}
+
+/*
+*	Function:		VkResult RenderGraph::createRenderPass(Step &step, std::vector< State > &states)
+*	Purpose:		Creates the render pass of a graphics step, barriers of its other uses are recorded before it
+*					Load ops, store ops and layouts of every attachment follow from its uses before and after the
+*					step, the hazards between them become subpass dependencies, the one to the next use outside
+*					the step makes a barrier there unnecessary
+*
+*/
+VkResult RenderGraph::createRenderPass(Step &step, std::vector< State > &states) {
+
+	/*
+	*	Struct:			Access
+	*	Purpose:		Attachment use inside the step
+	*
+	*/
+	struct Access {
+
+		uint32_t					subpass;
+		const Use*					use;
+
+	};
+
+	uint32_t lastPass = step.firstPass + step.amountOfPasses - 1;
+	std::vector< uint32_t > attachmentIndex(resources.size(), RENDER_GRAPH_INVALID);
+	std::vector< std::vector< Access > > accesses;
+
+	for (uint32_t p = step.firstPass; p <= lastPass; p++) {
+
+		for (const Use &use : passes[p].uses) {
+
+			if (use.attachment == ATTACHMENT_TYPE_NONE) {
+
+				Barrier barrier;
+				if (!use.synchronized && synchronize(states[use.resource], use, barrier)) {
+
+					step.barriers.push_back(barrier);
+
+				}
+				continue;
+
+			}
+
+			if (attachmentIndex[use.resource] == RENDER_GRAPH_INVALID) {
+
+				attachmentIndex[use.resource] = static_cast< uint32_t >(step.attachments.size());
+				step.attachments.push_back(use.resource);
+				accesses.push_back({});
+
+			}
+			accesses[attachmentIndex[use.resource]].push_back({ passes[p].subpass, &use });
+
+		}
+
+	}
+
+	std::vector< VkSubpassDependency > dependencies;
+	auto depend = [&dependencies](uint32_t src, uint32_t dst, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+
+		if (src == dst) {
+
+			return;
+
+		}
+
+		VkDependencyFlags flags = (src == VK_SUBPASS_EXTERNAL || dst == VK_SUBPASS_EXTERNAL) ? 0 : VK_DEPENDENCY_BY_REGION_BIT;
+		for (VkSubpassDependency &dependency : dependencies) {
+
+			if (dependency.srcSubpass == src && dependency.dstSubpass == dst) {
+
+				dependency.srcStageMask		|= srcStage;
+				dependency.dstStageMask		|= dstStage;
+				dependency.srcAccessMask	|= srcAccess;
+				dependency.dstAccessMask	|= dstAccess;
+				return;
+
+			}
+
+		}
+
+		VkSubpassDependency dependency;
+		dependency.srcSubpass			= src;
+		dependency.dstSubpass			= dst;
+		dependency.srcStageMask			= srcStage;
+		dependency.dstStageMask			= dstStage;
+		dependency.srcAccessMask		= srcAccess;
+		dependency.dstAccessMask		= dstAccess;
+		dependency.dependencyFlags		= flags;
+		dependencies.push_back(dependency);
+
+	};
+
+	std::vector< VkAttachmentDescription > descriptions(step.attachments.size());
+	step.clearValues.assign(step.attachments.size(), VkClearValue());
+
+	for (uint32_t a = 0; a < step.attachments.size(); a++) {
+
+		uint32_t r						= step.attachments[a];
+		const Resource &resource		= resources[r];
+		State &state					= states[r];
+		const std::vector< Access > &uses	= accesses[a];
+		const Use &first				= *uses.front().use;
+
+		VkAttachmentDescription &description = descriptions[a];
+		description.flags				= 0;
+		description.format				= resource.format;
+		description.samples				= resource.samples;
+		description.stencilLoadOp		= VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		description.stencilStoreOp		= VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		description.initialLayout		= state.layout;
+		description.loadOp				= first.attachment == ATTACHMENT_TYPE_INPUT ? VK_ATTACHMENT_LOAD_OP_LOAD :
+										  first.attachment == ATTACHMENT_TYPE_COLOR ? first.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		step.clearValues[a].color		= first.clearColor;
+
+		// Uses before the step, the render pass does the layout transition
+		Barrier barrier;
+		if (!first.synchronized && synchronize(state, first, barrier)) {
+
+			depend(VK_SUBPASS_EXTERNAL, uses.front().subpass, barrier.srcStage, barrier.srcAccess, barrier.dstStage, barrier.dstAccess);
+
+		}
+
+		// Writes wait for the subpasses since the last write, reads for the last write only
+		uint32_t lastWrite = first.write ? 0 : RENDER_GRAPH_INVALID;
+		for (uint32_t u = 1; u < uses.size(); u++) {
+
+			const Use &use = *uses[u].use;
+			for (uint32_t earlier = lastWrite == RENDER_GRAPH_INVALID ? 0 : lastWrite; earlier < u; earlier++) {
+
+				const Use &before = *uses[earlier].use;
+				if (before.write || use.write) {
+
+					depend(uses[earlier].subpass, uses[u].subpass, before.stage, before.write ? writeAccessOf(before.access) : 0, use.stage, use.access);
+
+				}
+
+			}
+			synchronize(state, use, barrier);
+			if (use.write) {
+
+				lastWrite = u;
+
+			}
+
+		}
+
+		// The next use outside the step waits through the render pass
+		Use* next = nullptr;
+		for (uint32_t p = lastPass + 1; p < passes.size() && next == nullptr; p++) {
+
+			for (Use &use : passes[p].uses) {
+
+				if (use.resource == r) {
+
+					next = &use;
+					break;
+
+				}
+
+			}
+
+		}
+
+		const Use &last = *uses.back().use;
+		if (next != nullptr) {
+
+			description.finalLayout	= next->layout;
+			description.storeOp		= VK_ATTACHMENT_STORE_OP_STORE;
+
+			if (lastWrite != RENDER_GRAPH_INVALID || next->write || next->layout != last.layout) {
+
+				for (uint32_t earlier = lastWrite == RENDER_GRAPH_INVALID ? 0 : lastWrite; earlier < uses.size(); earlier++) {
+
+					const Use &before = *uses[earlier].use;
+					if (before.write || next->write || next->layout != last.layout) {
+
+						depend(uses[earlier].subpass, VK_SUBPASS_EXTERNAL, before.stage, before.write ? writeAccessOf(before.access) : 0, next->stage, next->access);
+
+					}
+
+				}
+
+				next->synchronized	= true;
+				state.layout		= next->layout;
+				state.writeStage	= next->stage;
+				state.writeAccess	= next->write ? writeAccessOf(next->access) : 0;
+				state.readStages	= next->write ? 0 : next->stage;
+				state.visibleStages	= next->stage;
+				state.visibleAccess	= next->access;
+
+			}
+
+		}
+		else {
+
+			description.finalLayout	= resource.imported && resource.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED ? resource.finalLayout : last.layout;
+			description.storeOp		= resource.imported ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			state.layout			= description.finalLayout;
+
+		}
+
+	}
+
+	std::vector< VkSubpassDescription > subpasses(step.amountOfPasses);
+	std::vector< std::vector< VkAttachmentReference > > colorReferences(step.amountOfPasses);
+	std::vector< std::vector< VkAttachmentReference > > resolveReferences(step.amountOfPasses);
+	std::vector< std::vector< VkAttachmentReference > > inputReferences(step.amountOfPasses);
+
+	for (uint32_t s = 0; s < step.amountOfPasses; s++) {
+
+		for (const Use &use : passes[step.firstPass + s].uses) {
+
+			VkAttachmentReference reference;
+			reference.attachment	= attachmentIndex[use.resource];
+			reference.layout		= use.layout;
+
+			switch (use.attachment) {
+
+			case ATTACHMENT_TYPE_COLOR:
+				colorReferences[s].push_back(reference);
+				break;
+			case ATTACHMENT_TYPE_RESOLVE:
+				resolveReferences[s].push_back(reference);
+				break;
+			case ATTACHMENT_TYPE_INPUT:
+				inputReferences[s].push_back(reference);
+				break;
+			default:
+				break;
+
+			}
+
+		}
+
+		// Color attachments declared after the last resolve attachment are not resolved
+		if (!resolveReferences[s].empty()) {
+
+			resolveReferences[s].resize(colorReferences[s].size(), { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED });
+
+		}
+
+		VkSubpassDescription &subpassDescription = subpasses[s];
+		subpassDescription.flags						= 0;
+		subpassDescription.pipelineBindPoint			= VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpassDescription.inputAttachmentCount			= static_cast< uint32_t >(inputReferences[s].size());
+		subpassDescription.pInputAttachments			= inputReferences[s].empty() ? nullptr : inputReferences[s].data();
+		subpassDescription.colorAttachmentCount			= static_cast< uint32_t >(colorReferences[s].size());
+		subpassDescription.pColorAttachments			= colorReferences[s].empty() ? nullptr : colorReferences[s].data();
+		subpassDescription.pResolveAttachments			= resolveReferences[s].empty() ? nullptr : resolveReferences[s].data();
+		subpassDescription.pDepthStencilAttachment		= nullptr;
+		subpassDescription.preserveAttachmentCount		= 0;
+		subpassDescription.pPreserveAttachments			= nullptr;
+
+	}
+
+	VkRenderPassCreateInfo renderPassCreateInfo;
+	renderPassCreateInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassCreateInfo.pNext				= nullptr;
+	renderPassCreateInfo.flags				= 0;
+	renderPassCreateInfo.attachmentCount	= static_cast< uint32_t >(descriptions.size());
+	renderPassCreateInfo.pAttachments		= descriptions.empty() ? nullptr : descriptions.data();
+	renderPassCreateInfo.subpassCount		= static_cast< uint32_t >(subpasses.size());
+	renderPassCreateInfo.pSubpasses			= subpasses.data();
+	renderPassCreateInfo.dependencyCount	= static_cast< uint32_t >(dependencies.size());
+	renderPassCreateInfo.pDependencies		= dependencies.empty() ? nullptr : dependencies.data();
+
+	return vkCreateRenderPass(device, &renderPassCreateInfo, allocationCallbacks, &step.renderPass);
+
+}
+
+/*
+*	Function:		void RenderGraph::planRendering(Step &step, std::vector< State > &states)
+*	Purpose:		Plans a graphics pass rendered with vkCmdBeginRenderingKHR, its attachments are transitioned
+*					by the barriers before it like every other use, multisampled ones are resolved by averaging
+*
+*/
+void RenderGraph::planRendering(Step &step, std::vector< State > &states) {
+
+	const Pass &pass = passes[step.firstPass];
+	for (const Use &use : pass.uses) {
+
+		Barrier barrier;
+		if (!use.synchronized && synchronize(states[use.resource], use, barrier)) {
+
+			step.barriers.push_back(barrier);
+
+		}
+
+	}
+
+	uint32_t resolved = 0;
+	for (const Use &use : pass.uses) {
+
+		const Resource &resource = resources[use.resource];
+		if (use.attachment == ATTACHMENT_TYPE_COLOR) {
+
+			RenderTarget target;
+			target.color				= use.resource;
+			target.resolve				= RENDER_GRAPH_INVALID;
+			target.loadOp				= use.loadOp;
+			target.storeOp				= resource.imported || resource.lastPass > step.firstPass ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			target.clearValue.color		= use.clearColor;
+			step.renderTargets.push_back(target);
+			step.colorFormats.push_back(resource.format);
+			step.samples = resource.samples;
+
+		}
+
+	}
+	for (const Use &use : pass.uses) {
+
+		if (use.attachment == ATTACHMENT_TYPE_RESOLVE && resolved < step.renderTargets.size()) {
+
+			step.renderTargets[resolved++].resolve = use.resource;
+
+		}
+
+	}
+
+}
+
+/*
+*	Function:		VkResult RenderGraph::resize(VkExtent2D extent, RenderGraphTransients &retired)
+*	Purpose:		Creates the transient images of a new extent, one memory allocation per slot, and hands the
+*					previous ones to retired, destroy them with destroyTransients() once no frame uses them
+*					Framebuffers of the graph have to be created again
+*
+*/
+VkResult RenderGraph::resize(VkExtent2D extent_, RenderGraphTransients &retired) {
+
+	retired = std::move(transients);
+	transients		= RenderGraphTransients();
+	extent			= extent_;
+	aliasedBytes	= 0;
+	separateBytes	= 0;
+
+	for (Slot &slot : slots) {
+
+		slot.requirements					= {};
+		slot.requirements.alignment			= 1;
+		slot.requirements.memoryTypeBits	= ~0U;
+
+		for (uint32_t r : slot.images) {
+
+			Resource &resource = resources[r];
+
+			VkImageCreateInfo imageCreateInfo;
+			imageCreateInfo.sType					= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageCreateInfo.pNext					= nullptr;
+			imageCreateInfo.flags					= 0;
+			imageCreateInfo.imageType				= VK_IMAGE_TYPE_2D;
+			imageCreateInfo.format					= resource.format;
+			imageCreateInfo.extent					= { extent.width, extent.height, 1 };
+			imageCreateInfo.mipLevels				= 1;
+			imageCreateInfo.arrayLayers				= 1;
+			imageCreateInfo.samples					= resource.samples;
+			imageCreateInfo.tiling					= VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.usage					= resource.usage;
+			imageCreateInfo.sharingMode				= VK_SHARING_MODE_EXCLUSIVE;
+			imageCreateInfo.queueFamilyIndexCount	= 0;
+			imageCreateInfo.pQueueFamilyIndices		= nullptr;
+			imageCreateInfo.initialLayout			= VK_IMAGE_LAYOUT_UNDEFINED;
+
+			VkResult result = vkCreateImage(device, &imageCreateInfo, allocationCallbacks, &resource.image);
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+			transients.images.push_back(resource.image);
+
+			VkMemoryRequirements memoryRequirements;
+			vkGetImageMemoryRequirements(device, resource.image, &memoryRequirements);
+			slot.requirements.size				= std::max(slot.requirements.size, memoryRequirements.size);
+			slot.requirements.alignment			= std::max(slot.requirements.alignment, memoryRequirements.alignment);
+			slot.requirements.memoryTypeBits	&= memoryRequirements.memoryTypeBits;
+			separateBytes						+= memoryRequirements.size;
+
+		}
+
+		// Images of a slot have to agree on a memory type
+		if (slot.requirements.memoryTypeBits == 0) {
+
+			return VK_ERROR_FORMAT_NOT_SUPPORTED;
+
+		}
+
+		MemoryAllocation allocation;
+		VkResult result = memoryAllocator->allocate(
+
+			slot.requirements,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			slot.lazy ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : 0,
+			true,
+			allocation
+
+		);
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+		transients.memory.push_back(allocation);
+		aliasedBytes += slot.requirements.size;
+
+		for (uint32_t r : slot.images) {
+
+			Resource &resource = resources[r];
+			result = vkBindImageMemory(device, resource.image, allocation.memory, allocation.offset);
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+
+			VkImageViewCreateInfo imageViewCreateInfo;
+			imageViewCreateInfo.sType								= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			imageViewCreateInfo.pNext								= nullptr;
+			imageViewCreateInfo.flags								= 0;
+			imageViewCreateInfo.image								= resource.image;
+			imageViewCreateInfo.viewType							= VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.format								= resource.format;
+			imageViewCreateInfo.components.r						= VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.g						= VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.b						= VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.a						= VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.subresourceRange.aspectMask			= VK_IMAGE_ASPECT_COLOR_BIT;
+			imageViewCreateInfo.subresourceRange.baseMipLevel		= 0;
+			imageViewCreateInfo.subresourceRange.levelCount			= 1;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
+			imageViewCreateInfo.subresourceRange.layerCount			= 1;
+
+			result = vkCreateImageView(device, &imageViewCreateInfo, allocationCallbacks, &resource.imageView);
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+			transients.imageViews.push_back(resource.imageView);
+
+		}
+
+	}
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult RenderGraph::createFramebuffer(uint32_t pass, VkFramebuffer &framebuffer) const
+*	Purpose:		Creates a framebuffer for the render pass of a graphics pass from the current views of its
+*					attachments, the caller owns it and passes it to setFramebuffer() before executing
+*					Dynamic rendering has no render pass and framebuffer is VK_NULL_HANDLE
+*
+*/
+VkResult RenderGraph::createFramebuffer(uint32_t pass, VkFramebuffer &framebuffer) const {
+
+	const Step &step = steps[passes[pass].step];
+	if (step.renderPass == VK_NULL_HANDLE) {
+
+		framebuffer = VK_NULL_HANDLE;
+		return VK_SUCCESS;
+
+	}
+
+	std::vector< VkImageView > imageViews;
+	for (uint32_t r : step.attachments) {
+
+		imageViews.push_back(resources[r].imageView);
+
+	}
+
+	VkFramebufferCreateInfo framebufferCreateInfo;
+	framebufferCreateInfo.sType				= VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	framebufferCreateInfo.pNext				= nullptr;
+	framebufferCreateInfo.flags				= 0;
+	framebufferCreateInfo.renderPass		= step.renderPass;
+	framebufferCreateInfo.attachmentCount	= static_cast< uint32_t >(imageViews.size());
+	framebufferCreateInfo.pAttachments		= imageViews.empty() ? nullptr : imageViews.data();
+	framebufferCreateInfo.width				= extent.width;
+	framebufferCreateInfo.height			= extent.height;
+	framebufferCreateInfo.layers			= 1;
+
+	return vkCreateFramebuffer(device, &framebufferCreateInfo, allocationCallbacks, &framebuffer);
+
+}
+
+void RenderGraph::setImage(uint32_t resource, VkImage image, VkImageView imageView) {
+
+	resources[resource].image		= image;
+	resources[resource].imageView	= imageView;
+
+}
+
+void RenderGraph::setBuffer(uint32_t resource, VkBuffer buffer) {
+
+	resources[resource].buffer = buffer;
+
+}
+
+void RenderGraph::setFramebuffer(uint32_t pass, VkFramebuffer framebuffer) {
+
+	steps[passes[pass].step].framebuffer = framebuffer;
+
+}
+
+/*
+*	Function:		void RenderGraph::execute(VkCommandBuffer commandBuffer) const
+*	Purpose:		Records every step with its barriers and calls the record functions of the passes,
+*					imported resources and framebuffers have to be set for the frame
+*
+*/
+void RenderGraph::execute(VkCommandBuffer commandBuffer) const {
+
+	for (const Step &step : steps) {
+
+		cmdBarriers(commandBuffer, step.barriers);
+
+		RenderPassContext context;
+		context.commandBuffer			= commandBuffer;
+		context.renderPass				= step.renderPass;
+		context.framebuffer				= step.framebuffer;
+		context.extent					= extent;
+		context.colorAttachmentCount	= static_cast< uint32_t >(step.colorFormats.size());
+		context.colorFormats			= step.colorFormats.empty() ? nullptr : step.colorFormats.data();
+		context.samples					= step.samples;
+
+		bool rendering = step.renderPass == VK_NULL_HANDLE && passes[step.firstPass].type == RENDER_PASS_TYPE_GRAPHICS;
+
+		if (step.renderPass != VK_NULL_HANDLE) {
+
+			VkRenderPassBeginInfo renderPassBeginInfo;
+			renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+			renderPassBeginInfo.pNext				= nullptr;
+			renderPassBeginInfo.renderPass			= step.renderPass;
+			renderPassBeginInfo.framebuffer			= step.framebuffer;
+			renderPassBeginInfo.renderArea.offset	= { 0, 0 };
+			renderPassBeginInfo.renderArea.extent	= extent;
+			renderPassBeginInfo.clearValueCount		= static_cast< uint32_t >(step.clearValues.size());
+			renderPassBeginInfo.pClearValues		= step.clearValues.empty() ? nullptr : step.clearValues.data();
+
+			vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, passes[step.firstPass].contents);
+
+		}
+#ifdef VK_KHR_dynamic_rendering
+		else if (rendering) {
+
+			std::vector< VkRenderingAttachmentInfoKHR > colorAttachments(step.renderTargets.size());
+			for (size_t i = 0; i < step.renderTargets.size(); i++) {
+
+				const RenderTarget &target = step.renderTargets[i];
+				bool resolve = target.resolve != RENDER_GRAPH_INVALID;
+
+				VkRenderingAttachmentInfoKHR &colorAttachment = colorAttachments[i];
+				colorAttachment.sType					= VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+				colorAttachment.pNext					= nullptr;
+				colorAttachment.imageView				= resources[target.color].imageView;
+				colorAttachment.imageLayout				= VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				colorAttachment.resolveMode				= resolve ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
+				colorAttachment.resolveImageView		= resolve ? resources[target.resolve].imageView : VK_NULL_HANDLE;
+				colorAttachment.resolveImageLayout		= VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				colorAttachment.loadOp					= target.loadOp;
+				colorAttachment.storeOp					= target.storeOp;
+				colorAttachment.clearValue				= target.clearValue;
+
+			}
+
+			VkRenderingInfoKHR renderingInfo;
+			renderingInfo.sType						= VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+			renderingInfo.pNext						= nullptr;
+			renderingInfo.flags						= passes[step.firstPass].contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+			renderingInfo.renderArea.offset			= { 0, 0 };
+			renderingInfo.renderArea.extent			= extent;
+			renderingInfo.layerCount				= 1;
+			renderingInfo.viewMask					= 0;
+			renderingInfo.colorAttachmentCount		= static_cast< uint32_t >(colorAttachments.size());
+			renderingInfo.pColorAttachments			= colorAttachments.empty() ? nullptr : colorAttachments.data();
+			renderingInfo.pDepthAttachment			= nullptr;
+			renderingInfo.pStencilAttachment		= nullptr;
+
+			cmdBeginRendering(commandBuffer, &renderingInfo);
+
+		}
+#endif
+
+		for (uint32_t p = step.firstPass; p < step.firstPass + step.amountOfPasses; p++) {
+
+			if (p != step.firstPass) {
+
+				vkCmdNextSubpass(commandBuffer, passes[p].contents);
+
+			}
+			context.subpass = passes[p].subpass;
+			passes[p].record(context);
+
+		}
+
+		if (step.renderPass != VK_NULL_HANDLE) {
+
+			vkCmdEndRenderPass(commandBuffer);
+
+		}
+#ifdef VK_KHR_dynamic_rendering
+		else if (rendering) {
+
+			cmdEndRendering(commandBuffer);
+
+		}
+#endif
+
+	}
+
+	cmdBarriers(commandBuffer, finalBarriers);
+
+}
+
+/*
+*	Function:		void RenderGraph::cmdBarriers(VkCommandBuffer commandBuffer, const std::vector< Barrier > &barriers) const
+*	Purpose:		Records the barriers of one step as a single vkCmdPipelineBarrier
+*
+*/
+void RenderGraph::cmdBarriers(VkCommandBuffer commandBuffer, const std::vector< Barrier > &barriers) const {
+
+	if (barriers.empty()) {
+
+		return;
+
+	}
+
+	VkPipelineStageFlags srcStage = 0;
+	VkPipelineStageFlags dstStage = 0;
+	std::vector< VkBufferMemoryBarrier > bufferBarriers;
+	std::vector< VkImageMemoryBarrier > imageBarriers;
+
+	for (const Barrier &barrier : barriers) {
+
+		const Resource &resource = resources[barrier.resource];
+		srcStage |= barrier.srcStage;
+		dstStage |= barrier.dstStage;
+
+		if (resource.isImage) {
+
+			VkImageMemoryBarrier imageBarrier;
+			imageBarrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageBarrier.pNext								= nullptr;
+			imageBarrier.srcAccessMask						= barrier.srcAccess;
+			imageBarrier.dstAccessMask						= barrier.dstAccess;
+			imageBarrier.oldLayout							= barrier.oldLayout;
+			imageBarrier.newLayout							= barrier.newLayout;
+			imageBarrier.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.image								= resource.image;
+			imageBarrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+			imageBarrier.subresourceRange.baseMipLevel		= 0;
+			imageBarrier.subresourceRange.levelCount		= 1;
+			imageBarrier.subresourceRange.baseArrayLayer	= 0;
+			imageBarrier.subresourceRange.layerCount		= 1;
+			imageBarriers.push_back(imageBarrier);
+
+		}
+		else {
+
+			VkBufferMemoryBarrier bufferBarrier;
+			bufferBarrier.sType					= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			bufferBarrier.pNext					= nullptr;
+			bufferBarrier.srcAccessMask			= barrier.srcAccess;
+			bufferBarrier.dstAccessMask			= barrier.dstAccess;
+			bufferBarrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+			bufferBarrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+			bufferBarrier.buffer				= resource.buffer;
+			bufferBarrier.offset				= 0;
+			bufferBarrier.size					= VK_WHOLE_SIZE;
+			bufferBarriers.push_back(bufferBarrier);
+
+		}
+
+	}
+
+	vkCmdPipelineBarrier(
+
+		commandBuffer,
+		srcStage,
+		dstStage,
+		0,
+		0,
+		nullptr,
+		static_cast< uint32_t >(bufferBarriers.size()),
+		bufferBarriers.empty() ? nullptr : bufferBarriers.data(),
+		static_cast< uint32_t >(imageBarriers.size()),
+		imageBarriers.empty() ? nullptr : imageBarriers.data()
+
+	);
+
+}
+
+VkImage RenderGraph::image(uint32_t resource) const {
+
+	return resources[resource].image;
+
+}
+
+VkBuffer RenderGraph::buffer(uint32_t resource) const {
+
+	return resources[resource].buffer;
+
+}
+
+VkRenderPass RenderGraph::renderPass(uint32_t pass) const {
+
+	return steps[passes[pass].step].renderPass;
+
+}
+
+uint32_t RenderGraph::subpass(uint32_t pass) const {
+
+	return passes[pass].subpass;
+
+}
+
+/*
+*	Function:		std::string RenderGraph::describe() const
+*	Purpose:		Lists the compiled steps in execution order with their barriers, for the log
+*
+*/
+std::string RenderGraph::describe() const {
+
+	std::string description;
+	for (const Step &step : steps) {
+
+		if (!step.barriers.empty()) {
+
+			description += std::to_string(step.barriers.size()) + (step.barriers.size() == 1 ? " barrier -> " : " barriers -> ");
+
+		}
+
+		if (step.renderPass != VK_NULL_HANDLE) {
+
+			description += "render pass (";
+			for (uint32_t p = step.firstPass; p < step.firstPass + step.amountOfPasses; p++) {
+
+				description += std::string(p == step.firstPass ? "" : " + ") + passes[p].name;
+
+			}
+			description += ", " + std::to_string(step.attachments.size()) + " attachments)";
+
+		}
+		else if (passes[step.firstPass].type == RENDER_PASS_TYPE_GRAPHICS) {
+
+			description += "rendering (" + std::string(passes[step.firstPass].name) + ", " + std::to_string(step.renderTargets.size()) + " color attachments)";
+
+		}
+		else {
+
+			description += passes[step.firstPass].name;
+
+		}
+		description += " -> ";
+
+	}
+
+	return description + std::to_string(finalBarriers.size()) + (finalBarriers.size() == 1 ? " final barrier" : " final barriers");
+
+}
+
+bool RenderGraph::usesDynamicRendering() const {
+
+	return dynamicRendering;
+
+}
+
+uint32_t RenderGraph::amountOfRenderPasses() const {
+
+	uint32_t amount = 0;
+	for (const Step &step : steps) {
+
+		amount += step.renderPass != VK_NULL_HANDLE ? 1 : 0;
+
+	}
+
+	return amount;
+
+}
+
+uint32_t RenderGraph::amountOfBarriers() const {
+
+	size_t amount = finalBarriers.size();
+	for (const Step &step : steps) {
+
+		amount += step.barriers.size();
+
+	}
+
+	return static_cast< uint32_t >(amount);
+
+}
+
+VkDeviceSize RenderGraph::transientBytes() const {
+
+	return aliasedBytes;
+
+}
+
+VkDeviceSize RenderGraph::unaliasedBytes() const {
+
+	return separateBytes;
+
+}
+
+/*
+*	Function:		void RenderGraph::destroyTransients(RenderGraphTransients &transients)
+*	Purpose:		Destroys transient images retired by resize(), no frame may use them anymore
+*
+*/
+void RenderGraph::destroyTransients(RenderGraphTransients &retired) {
+
+	for (VkImageView imageView : retired.imageViews) {
+
+		vkDestroyImageView(device, imageView, allocationCallbacks);
+
+	}
+	for (VkImage image : retired.images) {
+
+		vkDestroyImage(device, image, allocationCallbacks);
+
+	}
+	for (const MemoryAllocation &allocation : retired.memory) {
+
+		memoryAllocator->free(allocation);
+
+	}
+	retired = RenderGraphTransients();
+
+}
+
+/*
+*	Function:		void RenderGraph::destroy()
+*	Purpose:		Destroys the render passes and the current transient images, no frame may be in flight
+*
+*/
+void RenderGraph::destroy() {
+
+	destroyTransients(transients);
+	for (Step &step : steps) {
+
+		if (step.renderPass != VK_NULL_HANDLE) {
+
+			vkDestroyRenderPass(device, step.renderPass, allocationCallbacks);
+
+		}
+
+	}
+	steps.clear();
+	finalBarriers.clear();
+	slots.clear();
+	passes.clear();
+	resources.clear();
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+RenderGraph::~RenderGraph() {
+
+
+
+}
+
@@ -0,0 +1,288 @@
+/*
+*	File:			RenderGraph.hpp
+*	Purpose:		Contains struct RenderGraphTransients, struct RenderPassContext and class RenderGraph
+*
+*/
+#pragma once
+#include "MemoryAllocator.hpp"
+#include <vulkan/vulkan.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#define RENDER_GRAPH_INVALID			UINT32_MAX				// No pass or resource
+
+enum RenderPassType {
+
+	RENDER_PASS_TYPE_GRAPHICS,									// Recorded inside a VkRenderPass, consecutive ones become subpasses of one
+	RENDER_PASS_TYPE_COMPUTE,
+	RENDER_PASS_TYPE_TRANSFER
+
+};
+
+/*
+*	Struct:			RenderGraphTransients
+*	Purpose:		Transient images of one extent, handed out by resize() so the frames still using them can finish
+*
+*/
+struct RenderGraphTransients {
+
+	std::vector< VkImageView >			imageViews;
+	std::vector< VkImage >				images;
+	std::vector< MemoryAllocation >		memory;					// One per alias slot, shared by the images of the slot
+
+};
+
+/*
+*	Struct:			RenderPassContext
+*	Purpose:		Passed to the record function of a pass
+*
+*/
+struct RenderPassContext {
+
+	VkCommandBuffer				commandBuffer;
+	VkRenderPass				renderPass;						// VK_NULL_HANDLE outside of graphics passes
+	uint32_t					subpass;
+	VkFramebuffer				framebuffer;
+	VkExtent2D					extent;
+	uint32_t					colorAttachmentCount;			// With dynamic rendering, for VkCommandBufferInheritanceRenderingInfoKHR
+	const VkFormat*				colorFormats;
+	VkSampleCountFlagBits		samples;
+
+};
+
+typedef std::function< void(const RenderPassContext &context) > RenderPassFunction;
+
+/*
+*	Class:			RenderGraph
+*	Purpose:		Passes declare the images and buffers they read and write, compile() derives everything
+*					recorded between them: consecutive graphics passes become subpasses of one render pass with
+*					its load and store ops, layouts and subpass dependencies, every other hazard gets a batched
+*					pipeline barrier with the stages of the accesses only
+*					Images created by the graph live for one frame, images whose lifetimes do not overlap share memory
+*					With VK_KHR_dynamic_rendering graphics passes render without VkRenderPass and VkFramebuffer,
+*					layout transitions become barriers and passes are not merged
+*
+*/
+class RenderGraph
+{
+public:
+	RenderGraph();
+	void init(VkDevice device, MemoryAllocator &allocator, const VkAllocationCallbacks* allocationCallbacks = nullptr, bool dynamicRendering = false);
+	uint32_t importImage(const char* name, VkFormat format, VkImageLayout initialLayout, VkPipelineStageFlags initialStage, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+	uint32_t importBuffer(const char* name, VkPipelineStageFlags finalStage = 0, VkAccessFlags finalAccess = 0);
+	uint32_t createImage(const char* name, VkFormat format, VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
+	uint32_t addPass(const char* name, RenderPassType type, RenderPassFunction record, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+	void colorAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor = {});
+	void resolveAttachment(uint32_t pass, uint32_t image);
+	void inputAttachment(uint32_t pass, uint32_t image);
+	void read(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+	void write(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+	VkResult compile(void);
+	VkResult resize(VkExtent2D extent, RenderGraphTransients &retired);
+	VkResult createFramebuffer(uint32_t pass, VkFramebuffer &framebuffer) const;
+	void setImage(uint32_t resource, VkImage image, VkImageView imageView);
+	void setBuffer(uint32_t resource, VkBuffer buffer);
+	void setFramebuffer(uint32_t pass, VkFramebuffer framebuffer);
+	void execute(VkCommandBuffer commandBuffer) const;
+	VkImage image(uint32_t resource) const;
+	VkBuffer buffer(uint32_t resource) const;
+	VkRenderPass renderPass(uint32_t pass) const;
+	uint32_t subpass(uint32_t pass) const;
+	bool usesDynamicRendering(void) const;
+	std::string describe(void) const;
+	uint32_t amountOfRenderPasses(void) const;
+	uint32_t amountOfBarriers(void) const;
+	VkDeviceSize transientBytes(void) const;
+	VkDeviceSize unaliasedBytes(void) const;
+	void destroyTransients(RenderGraphTransients &transients);
+	void destroy(void);
+	~RenderGraph();
+private:
+	RenderGraph(const RenderGraph &) = delete;
+	RenderGraph &operator=(const RenderGraph &) = delete;
+
+	enum AttachmentType {
+
+		ATTACHMENT_TYPE_NONE,									// Synchronized with pipeline barriers
+		ATTACHMENT_TYPE_COLOR,
+		ATTACHMENT_TYPE_RESOLVE,
+		ATTACHMENT_TYPE_INPUT
+
+	};
+
+	/*
+	*	Struct:			Use
+	*	Purpose:		Access of one pass to one resource
+	*
+	*/
+	struct Use {
+
+		uint32_t						resource;
+		VkPipelineStageFlags			stage;
+		VkAccessFlags					access;
+		VkImageLayout					layout;					// VK_IMAGE_LAYOUT_UNDEFINED for buffers
+		bool							write;
+		AttachmentType					attachment;
+		VkAttachmentLoadOp				loadOp;					// Of color attachments
+		VkClearColorValue				clearColor;
+		bool							synchronized;			// By the outgoing dependency of the render pass before
+
+	};
+
+	/*
+	*	Struct:			Resource
+	*	Purpose:		Image or buffer known to the graph, imported ones are set before every execute()
+	*
+	*/
+	struct Resource {
+
+		const char*						name;
+		bool							isImage;
+		bool							imported;
+		VkFormat						format;
+		VkSampleCountFlagBits			samples;
+		VkImageLayout					initialLayout;			// Of imported images at the start of the frame
+		VkPipelineStageFlags			initialStage;			// Waited for by the first use, a semaphore wait stage for swapchain images
+		VkImageLayout					finalLayout;			// VK_IMAGE_LAYOUT_UNDEFINED keeps the layout of the last use
+		VkPipelineStageFlags			finalStage;				// Of imported buffers, made visible to finalAccess at the end of the frame
+		VkAccessFlags					finalAccess;
+		VkImageUsageFlags				usage;					// Derived from the uses of transient images
+		uint32_t						firstPass;
+		uint32_t						lastPass;
+		uint32_t						slot;					// Alias slot of transient images
+		VkPipelineStageFlags			aliasStage;				// Last uses of the memory before the frame starts with it
+		VkAccessFlags					aliasAccess;
+		VkImage							image;
+		VkImageView						imageView;
+		VkBuffer						buffer;
+
+	};
+
+	/*
+	*	Struct:			Pass
+	*	Purpose:		Declared pass, compile() assigns it a step and a subpass
+	*
+	*/
+	struct Pass {
+
+		const char*						name;
+		RenderPassType					type;
+		RenderPassFunction				record;
+		VkSubpassContents				contents;
+		std::vector< Use >				uses;
+		uint32_t						step;
+		uint32_t						subpass;
+
+	};
+
+	/*
+	*	Struct:			Barrier
+	*	Purpose:		Transition or memory dependency of one resource, the handles are looked up in execute()
+	*
+	*/
+	struct Barrier {
+
+		uint32_t						resource;
+		VkPipelineStageFlags			srcStage;
+		VkPipelineStageFlags			dstStage;
+		VkAccessFlags					srcAccess;
+		VkAccessFlags					dstAccess;
+		VkImageLayout					oldLayout;
+		VkImageLayout					newLayout;
+
+	};
+
+	/*
+	*	Struct:			RenderTarget
+	*	Purpose:		Color attachment of a pass rendered with dynamic rendering
+	*
+	*/
+	struct RenderTarget {
+
+		uint32_t						color;
+		uint32_t						resolve;				// RENDER_GRAPH_INVALID unless multisampled
+		VkAttachmentLoadOp				loadOp;
+		VkAttachmentStoreOp				storeOp;
+		VkClearValue					clearValue;
+
+	};
+
+	/*
+	*	Struct:			Step
+	*	Purpose:		Render pass of merged graphics passes or one other pass, preceded by its barriers
+	*
+	*/
+	struct Step {
+
+		uint32_t						firstPass;
+		uint32_t						amountOfPasses;
+		std::vector< Barrier >			barriers;
+		VkRenderPass					renderPass;				// VK_NULL_HANDLE unless graphics
+		std::vector< uint32_t >			attachments;			// Resources in attachment order
+		std::vector< VkClearValue >		clearValues;
+		VkFramebuffer					framebuffer;
+		std::vector< RenderTarget >		renderTargets;			// Instead of renderPass with dynamic rendering
+		std::vector< VkFormat >			colorFormats;
+		VkSampleCountFlagBits			samples;
+
+	};
+
+	/*
+	*	Struct:			State
+	*	Purpose:		Synchronization state of a resource while compile() walks the passes
+	*
+	*/
+	struct State {
+
+		VkImageLayout					layout;
+		VkPipelineStageFlags			writeStage;				// Stages later accesses have to wait for
+		VkAccessFlags					writeAccess;			// Writes not yet made available
+		VkPipelineStageFlags			readStages;				// Reads since the last write, a write waits for them
+		VkPipelineStageFlags			visibleStages;			// Stages the last write is visible to
+		VkAccessFlags					visibleAccess;
+
+	};
+
+	/*
+	*	Struct:			Slot
+	*	Purpose:		Memory shared by transient images with disjoint pass ranges
+	*
+	*/
+	struct Slot {
+
+		VkMemoryRequirements			requirements;
+		bool							lazy;					// Attachments only, may live in lazily allocated memory
+		std::vector< uint32_t >			images;
+
+	};
+
+	uint32_t addUse(uint32_t pass, uint32_t resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout, bool write, AttachmentType attachment);
+	bool synchronize(State &state, const Use &use, Barrier &barrier) const;
+	void mergePasses(void);
+	VkResult createRenderPass(Step &step, std::vector< State > &states);
+	void planRendering(Step &step, std::vector< State > &states);
+	void planTransients(void);
+	State initialState(const Resource &resource) const;
+	void cmdBarriers(VkCommandBuffer commandBuffer, const std::vector< Barrier > &barriers) const;
+
+	VkDevice								device;
+	MemoryAllocator*						memoryAllocator;
+	const VkAllocationCallbacks*			allocationCallbacks;
+	bool									dynamicRendering;		// Requested and loaded, input attachments turn it off
+#ifdef VK_KHR_dynamic_rendering
+	PFN_vkCmdBeginRenderingKHR				cmdBeginRendering;
+	PFN_vkCmdEndRenderingKHR				cmdEndRendering;
+#endif
+	std::vector< Resource >					resources;
+	std::vector< Pass >						passes;
+	std::vector< Step >						steps;
+	std::vector< Barrier >					finalBarriers;			// After the last step
+	std::vector< Slot >						slots;
+	VkExtent2D								extent;
+	RenderGraphTransients					transients;
+	VkDeviceSize							aliasedBytes;
+	VkDeviceSize							separateBytes;
+};
+
@@ -0,0 +1,474 @@
+/*
+*	File:			ShaderLibrary.cpp
+*	Purpose:		Contains functions for classes MappedFile and ShaderLibrary
+*
+*/
+#include "ShaderLibrary.hpp"
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+*	Default constructor
+*
+*
+*/
+MappedFile::MappedFile() :
+	view(nullptr),
+	length(0),
+#ifdef _WIN32
+	file(INVALID_HANDLE_VALUE),
+	mapping(nullptr) {
+#else
+	file(-1) {
+#endif
+
+
+
+}
+
+/*
+*	Function:		bool MappedFile::open(const std::string &fileName)
+*	Purpose:		Maps the whole file read-only, fails for missing and empty files
+*
+*/
+bool MappedFile::open(const std::string &fileName) {
+
+	close();
+
+#ifdef _WIN32
+	file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+
+		return false;
+
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+
+		close();
+		return false;
+
+	}
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+
+		close();
+		return false;
+
+	}
+
+	view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+
+		close();
+		return false;
+
+	}
+	length = static_cast< size_t >(fileSize.QuadPart);
+#else
+	file = ::open(fileName.c_str(), O_RDONLY);
+	if (file < 0) {
+
+		return false;
+
+	}
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+
+		close();
+		return false;
+
+	}
+
+	void* address = mmap(nullptr, static_cast< size_t >(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	if (address == MAP_FAILED) {
+
+		close();
+		return false;
+
+	}
+	view	= address;
+	length	= static_cast< size_t >(fileStat.st_size);
+#endif
+
+	return true;
+
+}
+
+/*
+*	Function:		void MappedFile::close()
+*	Purpose:		Unmaps the view and closes the file
+*
+*/
+void MappedFile::close() {
+
+#ifdef _WIN32
+	if (view != nullptr) {
+
+		UnmapViewOfFile(view);
+
+	}
+	if (mapping != nullptr) {
+
+		CloseHandle(mapping);
+		mapping = nullptr;
+
+	}
+	if (file != INVALID_HANDLE_VALUE) {
+
+		CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+
+	}
+#else
+	if (view != nullptr) {
+
+		munmap(const_cast< void* >(view), length);
+
+	}
+	if (file >= 0) {
+
+		::close(file);
+		file = -1;
+
+	}
+#endif
+
+	view	= nullptr;
+	length	= 0;
+
+}
+
+const void* MappedFile::data() const {
+
+	return view;
+
+}
+
+size_t MappedFile::size() const {
+
+	return length;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+MappedFile::~MappedFile() {
+
+	close();
+
+}
+
+/*
+*	Default constructor
+*
+*
+*/
+ShaderLibrary::ShaderLibrary() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	hits(0) {
+
+
+
+}
+
+/*
+*	Function:		void ShaderLibrary::init(VkDevice device, const VkAllocationCallbacks* allocator)
+*	Purpose:		Sets the device modules are created on and the callbacks they are created with
+*
+*/
+void ShaderLibrary::init(VkDevice device_, const VkAllocationCallbacks* allocator) {
+
+	device				= device_;
+	allocationCallbacks	= allocator;
+
+}
+
+/*
+*	Function:		bool ShaderLibrary::embed(const std::string &fileName, const uint32_t* code, size_t words)
+*	Purpose:		Registers SPIR-V of static storage duration under a file name, load() of that name
+*					takes it instead of the file, safe to call from any thread
+*
+*/
+bool ShaderLibrary::embed(const std::string &fileName, const uint32_t* code, size_t words) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	if (words < 5 || code[0] != SPIRV_MAGIC) {
+
+		error = "Embedded shader " + fileName + " is no SPIR-V module";
+		return false;
+
+	}
+
+	Embedded &entry	= embedded[fileName];
+	entry.code		= code;
+	entry.words		= words;
+	entry.hash		= hash(code, words);
+
+	return true;
+
+}
+
+/*
+*	Function:		bool ShaderLibrary::prefetch(const std::string &fileName)
+*	Purpose:		Maps, validates and hashes a SPIR-V file without a device, reading every page
+*					so the following load() only creates the module, safe to call from any thread
+*
+*/
+bool ShaderLibrary::prefetch(const std::string &fileName) {
+
+	std::unique_ptr< MappedFile > mapped(new MappedFile());
+	std::string mapError;
+	if (!map(fileName, *mapped, mapError)) {
+
+		std::lock_guard< std::mutex > lock(mutex);
+		error = mapError;
+		return false;
+
+	}
+	uint64_t key = hash(static_cast< const uint32_t* >(mapped->data()), mapped->size() / sizeof(uint32_t));
+
+	std::lock_guard< std::mutex > lock(mutex);
+	Prefetched &entry	= prefetched[fileName];
+	entry.file			= std::move(mapped);
+	entry.hash			= key;
+
+	return true;
+
+}
+
+/*
+*	Function:		VkResult ShaderLibrary::load(const std::string &fileName, VkShaderModule &module)
+*	Purpose:		Returns the module of a SPIR-V file, creating it only if neither the file
+*					nor identical code was loaded before, lastError() describes failures
+*					Embedded code of the same name takes precedence over the file
+*
+*/
+VkResult ShaderLibrary::load(const std::string &fileName, VkShaderModule &module) {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	auto byFile = modulesByFile.find(fileName);
+	if (byFile != modulesByFile.end()) {
+
+		hits++;
+		module = byFile->second;
+		return VK_SUCCESS;
+
+	}
+
+	std::unique_ptr< MappedFile > mapped;
+	const uint32_t* code;
+	size_t codeSize;
+	uint64_t key;
+
+	auto blob = embedded.find(fileName);
+	auto ready = prefetched.find(fileName);
+	if (blob != embedded.end()) {
+
+		code		= blob->second.code;
+		codeSize	= blob->second.words * sizeof(uint32_t);
+		key			= blob->second.hash;
+
+	}
+	else {
+
+		if (ready != prefetched.end()) {
+
+			mapped	= std::move(ready->second.file);
+			key		= ready->second.hash;
+			prefetched.erase(ready);
+
+		}
+		else {
+
+			mapped.reset(new MappedFile());
+			if (!map(fileName, *mapped, error)) {
+
+				return VK_ERROR_INITIALIZATION_FAILED;
+
+			}
+			key = hash(static_cast< const uint32_t* >(mapped->data()), mapped->size() / sizeof(uint32_t));
+
+		}
+		code		= static_cast< const uint32_t* >(mapped->data());
+		codeSize	= mapped->size();
+
+	}
+
+	// Equal hashes only share a module if the code is equal as well
+	size_t words = codeSize / sizeof(uint32_t);
+	auto range = modulesByHash.equal_range(key);
+	for (auto byHash = range.first; byHash != range.second; byHash++) {
+
+		const Module &known = byHash->second;
+		if (known.words == words && memcmp(known.code, code, codeSize) == 0) {
+
+			hits++;
+			module = byHash->second.module;
+			modulesByFile[fileName] = module;
+			return VK_SUCCESS;
+
+		}
+
+	}
+
+	VkShaderModuleCreateInfo shaderCreateInfo;
+	shaderCreateInfo.sType			= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	shaderCreateInfo.pNext			= nullptr;
+	shaderCreateInfo.flags			= 0;
+	shaderCreateInfo.codeSize		= codeSize;
+	shaderCreateInfo.pCode			= code;
+
+	VkResult result = vkCreateShaderModule(
+
+		device,
+		&shaderCreateInfo,
+		allocationCallbacks,
+		&module
+
+	);
+	if (result != VK_SUCCESS) {
+
+		error = "vkCreateShaderModule failed for " + fileName;
+		return result;
+
+	}
+
+	Module created;
+	created.module	= module;
+	created.file	= std::move(mapped);
+	created.code	= code;
+	created.words	= words;
+	modulesByHash.emplace(key, std::move(created));
+	modulesByFile[fileName]		= module;
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		void ShaderLibrary::destroy()
+*	Purpose:		Destroys every module, has to be called before the device is destroyed
+*
+*/
+void ShaderLibrary::destroy() {
+
+	std::lock_guard< std::mutex > lock(mutex);
+
+	for (auto &entry : modulesByHash) {
+
+		vkDestroyShaderModule(device, entry.second.module, allocationCallbacks);
+
+	}
+	modulesByHash.clear();
+	modulesByFile.clear();
+	prefetched.clear();
+
+}
+
+/*
+*	Function:		bool ShaderLibrary::map(const std::string &fileName, MappedFile &mapped, std::string &message) const
+*	Purpose:		Maps a file and checks it holds aligned SPIR-V of host byte order
+*
+*/
+bool ShaderLibrary::map(const std::string &fileName, MappedFile &mapped, std::string &message) const {
+
+	if (!mapped.open(fileName)) {
+
+		message = "Failed to map shader-file at " + fileName;
+		return false;
+
+	}
+
+	// vkCreateShaderModule reads pCode as uint32_t, which the mapping has to satisfy
+	if (reinterpret_cast< uintptr_t >(mapped.data()) % sizeof(uint32_t) != 0 || mapped.size() % sizeof(uint32_t) != 0) {
+
+		message = "Shader-file at " + fileName + " is not a whole number of aligned 32 bit words";
+		return false;
+
+	}
+
+	const uint32_t* code = static_cast< const uint32_t* >(mapped.data());
+	size_t words = mapped.size() / sizeof(uint32_t);
+	if (words < 5 || code[0] != SPIRV_MAGIC) {
+
+		message = "Shader-file at " + fileName + (words >= 1 && code[0] == 0x03022307 ? " is SPIR-V of the opposite byte order" : " is no SPIR-V module");
+		return false;
+
+	}
+
+	return true;
+
+}
+
+const std::string &ShaderLibrary::lastError() const {
+
+	return error;
+
+}
+
+uint32_t ShaderLibrary::amountOfModules() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return static_cast< uint32_t >(modulesByHash.size());
+
+}
+
+uint32_t ShaderLibrary::amountOfHits() const {
+
+	std::lock_guard< std::mutex > lock(mutex);
+	return hits;
+
+}
+
+/*
+*	Function:		uint64_t ShaderLibrary::hash(const uint32_t* code, size_t words)
+*	Purpose:		64 bit multiply-xor hash of the code, one step per SPIR-V word and a last one for the length
+*					Only narrows the search, load() compares the code of modules with an equal hash
+*
+*/
+uint64_t ShaderLibrary::hash(const uint32_t* code, size_t words) {
+
+	uint64_t value = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < words; i++) {
+
+		value ^= code[i];
+		value *= 0x100000001B3ULL;
+
+	}
+	value ^= static_cast< uint64_t >(words);
+	value *= 0x100000001B3ULL;
+
+	return value;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+ShaderLibrary::~ShaderLibrary() {
+
+
+
+}
+
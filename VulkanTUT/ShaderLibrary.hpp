@@ -0,0 +1,120 @@
+/*
+*	File:			ShaderLibrary.hpp
+*	Purpose:		Contains class ShaderLibrary
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+
+#define SPIRV_MAGIC					0x07230203		// First word of every SPIR-V module in host byte order
+
+/*
+*	Class:			MappedFile
+*	Purpose:		Read-only memory mapping of a whole file, unmapped on destruction
+*
+*/
+class MappedFile
+{
+public:
+	MappedFile();
+	bool open(const std::string &fileName);
+	void close(void);
+	const void* data(void) const;
+	size_t size(void) const;
+	~MappedFile();
+private:
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	const void*		view;
+	size_t			length;
+#ifdef _WIN32
+	void*			file;					// HANDLE, kept opaque to avoid windows.h in the header
+	void*			mapping;
+#else
+	int				file;
+#endif
+};
+
+/*
+*	Class:			ShaderLibrary
+*	Purpose:		Creates shader modules straight from memory-mapped SPIR-V files, every file is
+*					mapped once and identical SPIR-V shares one module, found by content hash and
+*					compared word by word, so colliding hashes never share a module
+*					prefetch() does the file I/O and hashing before the device exists
+*					SPIR-V embedded into the binary is registered with embed() and loaded without file I/O
+*
+*/
+class ShaderLibrary
+{
+public:
+	ShaderLibrary();
+	void init(VkDevice device, const VkAllocationCallbacks* allocator = nullptr);
+	bool embed(const std::string &fileName, const uint32_t* code, size_t words);
+	bool prefetch(const std::string &fileName);
+	VkResult load(const std::string &fileName, VkShaderModule &module);
+	void destroy(void);
+	const std::string &lastError(void) const;
+	uint32_t amountOfModules(void) const;
+	uint32_t amountOfHits(void) const;
+	static uint64_t hash(const uint32_t* code, size_t words);
+	~ShaderLibrary();
+private:
+	/*
+	*	Struct:			Prefetched
+	*	Purpose:		A mapped and hashed file waiting for load()
+	*
+	*/
+	struct Prefetched {
+
+		std::unique_ptr< MappedFile >				file;
+		uint64_t									hash;
+
+	};
+
+	/*
+	*	Struct:			Embedded
+	*	Purpose:		SPIR-V compiled into the binary, loaded in place of the file of the same name
+	*
+	*/
+	struct Embedded {
+
+		const uint32_t*								code;
+		size_t										words;
+		uint64_t									hash;
+
+	};
+
+	/*
+	*	Struct:			Module
+	*	Purpose:		A created module and the code it came from, compared when another file hashes equally
+	*					File code stays mapped for that, embedded code is referenced in place
+	*
+	*/
+	struct Module {
+
+		VkShaderModule								module;
+		std::unique_ptr< MappedFile >				file;				// nullptr for embedded code
+		const uint32_t*								code;
+		size_t										words;
+
+	};
+
+	bool map(const std::string &fileName, MappedFile &mapped, std::string &message) const;
+
+	VkDevice										device;
+	const VkAllocationCallbacks*					allocationCallbacks;
+	std::unordered_map< std::string, VkShaderModule >	modulesByFile;
+	std::unordered_multimap< uint64_t, Module >		modulesByHash;		// hash() of the code, equal keys may differ in code
+	std::unordered_map< std::string, Prefetched >		prefetched;			// Consumed by load()
+	std::unordered_map< std::string, Embedded >		embedded;			// Outlive the library, nothing to release
+	uint32_t										hits;					// Loads served without creating a module
+	std::string										error;
+	mutable std::mutex								mutex;
+};
+
@@ -0,0 +1,174 @@
+/*
+*	File:			SpecializationConstants.cpp
+*	Purpose:		Contains functions for class SpecializationConstants
+*
+*/
+#include "SpecializationConstants.hpp"
+#include <cstring>
+
+/*
+*	Default constructor
+*
+*
+*/
+SpecializationConstants::SpecializationConstants() {
+
+
+
+}
+
+/*
+*	Function:		void SpecializationConstants::set(uint32_t constantID, uint32_t value)
+*	Purpose:		Sets a uint constant, replaces the value of a constant set before
+*
+*/
+void SpecializationConstants::set(uint32_t constantID, uint32_t value) {
+
+	size_t i = 0;
+	while (i < entries.size() && entries[i].constantID < constantID) {
+
+		i++;
+
+	}
+	if (i < entries.size() && entries[i].constantID == constantID) {
+
+		values[i] = value;
+		return;
+
+	}
+
+	VkSpecializationMapEntry entry;
+	entry.constantID	= constantID;
+	entry.offset		= 0;
+	entry.size			= sizeof(uint32_t);
+	entries.insert(entries.begin() + i, entry);
+	values.insert(values.begin() + i, value);
+
+	// Offsets follow the order of the values
+	for (size_t j = 0; j < entries.size(); j++) {
+
+		entries[j].offset = static_cast< uint32_t >(j * sizeof(uint32_t));
+
+	}
+
+}
+
+/*
+*	Function:		void SpecializationConstants::set(uint32_t constantID, int32_t value)
+*	Purpose:		Sets an int constant
+*
+*/
+void SpecializationConstants::set(uint32_t constantID, int32_t value) {
+
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	set(constantID, bits);
+
+}
+
+/*
+*	Function:		void SpecializationConstants::set(uint32_t constantID, float value)
+*	Purpose:		Sets a float constant
+*
+*/
+void SpecializationConstants::set(uint32_t constantID, float value) {
+
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	set(constantID, bits);
+
+}
+
+/*
+*	Function:		void SpecializationConstants::set(uint32_t constantID, bool value)
+*	Purpose:		Sets a bool constant, which SPIR-V reads as a VkBool32
+*
+*/
+void SpecializationConstants::set(uint32_t constantID, bool value) {
+
+	set(constantID, static_cast< uint32_t >(value ? VK_TRUE : VK_FALSE));
+
+}
+
+bool SpecializationConstants::empty() const {
+
+	return entries.empty();
+
+}
+
+/*
+*	Function:		VkSpecializationInfo SpecializationConstants::info() const
+*	Purpose:		Describes the constants for VkPipelineShaderStageCreateInfo, valid until the next set()
+*
+*/
+VkSpecializationInfo SpecializationConstants::info() const {
+
+	VkSpecializationInfo specializationInfo;
+	specializationInfo.mapEntryCount	= static_cast< uint32_t >(entries.size());
+	specializationInfo.pMapEntries		= entries.data();
+	specializationInfo.dataSize			= values.size() * sizeof(uint32_t);
+	specializationInfo.pData			= values.data();
+
+	return specializationInfo;
+
+}
+
+/*
+*	Function:		uint64_t SpecializationConstants::hash() const
+*	Purpose:		Mixes every constant ID and value into 64 bits, one xor and multiply per word
+*					Part of PipelineDescription::key(), permutations with an equal key are compared with operator==
+*
+*/
+uint64_t SpecializationConstants::hash() const {
+
+	uint64_t value = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < entries.size(); i++) {
+
+		value ^= entries[i].constantID;
+		value *= 0x100000001B3ULL;
+		value ^= values[i];
+		value *= 0x100000001B3ULL;
+
+	}
+
+	return value;
+
+}
+
+/*
+*	Function:		bool SpecializationConstants::operator==(const SpecializationConstants &other) const
+*	Purpose:		Compares IDs and values, the entries are sorted so equal constants compare equal
+*
+*/
+bool SpecializationConstants::operator==(const SpecializationConstants &other) const {
+
+	if (entries.size() != other.entries.size() || values != other.values) {
+
+		return false;
+
+	}
+	for (size_t i = 0; i < entries.size(); i++) {
+
+		if (entries[i].constantID != other.entries[i].constantID) {
+
+			return false;
+
+		}
+
+	}
+
+	return true;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+SpecializationConstants::~SpecializationConstants() {
+
+
+
+}
+
@@ -0,0 +1,35 @@
+/*
+*	File:			SpecializationConstants.hpp
+*	Purpose:		Contains class SpecializationConstants
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+/*
+*	Class:			SpecializationConstants
+*	Purpose:		Values of the layout(constant_id = N) constants of one shader stage, every constant is
+*					32 bits wide, the driver folds them into the code when the pipeline is built
+*					Constants the shader does not declare are ignored, so older SPIR-V stays usable
+*
+*/
+class SpecializationConstants
+{
+public:
+	SpecializationConstants();
+	void set(uint32_t constantID, uint32_t value);
+	void set(uint32_t constantID, int32_t value);
+	void set(uint32_t constantID, float value);
+	void set(uint32_t constantID, bool value);
+	bool empty(void) const;
+	VkSpecializationInfo info(void) const;
+	uint64_t hash(void) const;
+	bool operator==(const SpecializationConstants &other) const;
+	~SpecializationConstants();
+private:
+	std::vector< VkSpecializationMapEntry >		entries;			// Sorted by constantID, so equal values hash equally
+	std::vector< uint32_t >						values;				// values[i] is read through entries[i]
+};
+
@@ -0,0 +1,464 @@
+/*
+*	File:			StagingBuffer.cpp
+*	Purpose:		Contains functions for class StagingBuffer
+*
+*/
+#include "StagingBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+/*
+*	Default constructor
+*
+*
+*/
+StagingBuffer::StagingBuffer() :
+	device(VK_NULL_HANDLE),
+	allocationCallbacks(nullptr),
+	queue(VK_NULL_HANDLE),
+	consumerQueue(VK_NULL_HANDLE),
+	queueFamily(0),
+	consumerQueueFamily(0),
+	commandPool(VK_NULL_HANDLE),
+	commandBuffer(VK_NULL_HANDLE),
+	fence(VK_NULL_HANDLE),
+	used(0),
+	recording(false),
+	submitted(false),
+	uploaded(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult StagingBuffer::create(VkDevice device, MemoryAllocator &allocator, VkQueue queue, uint32_t queueFamilyIndex, VkQueue consumerQueue, uint32_t consumerQueueFamilyIndex, VkDeviceSize size, const VkAllocationCallbacks* allocationCallbacks)
+*	Purpose:		Creates the mapped buffer and the command buffer and fence the copies are submitted with,
+*					the consumer queue is the one reading the destinations
+*
+*/
+VkResult StagingBuffer::create(VkDevice device_, MemoryAllocator &allocator, VkQueue queue_, uint32_t queueFamilyIndex, VkQueue consumerQueue_, uint32_t consumerQueueFamilyIndex, VkDeviceSize size, const VkAllocationCallbacks* allocationCallbacks_) {
+
+	device					= device_;
+	allocationCallbacks		= allocationCallbacks_;
+	queue					= queue_;
+	consumerQueue			= consumerQueue_;
+	queueFamily				= queueFamilyIndex;
+	consumerQueueFamily		= consumerQueueFamilyIndex;
+
+	VkResult result = buffer.create(
+
+		allocator,
+		size,
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+
+	);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkCommandPoolCreateInfo commandPoolCreateInfo;
+	commandPoolCreateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.pNext					= nullptr;
+	commandPoolCreateInfo.flags					= VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex		= queueFamilyIndex;
+
+	result = vkCreateCommandPool(device, &commandPoolCreateInfo, allocationCallbacks, &commandPool);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo;
+	commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.pNext					= nullptr;
+	commandBufferAllocateInfo.commandPool			= commandPool;
+	commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount	= 1;
+
+	result = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkFenceCreateInfo fenceCreateInfo;
+	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	fenceCreateInfo.pNext = nullptr;
+	fenceCreateInfo.flags = 0;
+
+	return vkCreateFence(device, &fenceCreateInfo, allocationCallbacks, &fence);
+
+}
+
+/*
+*	Function:		VkResult StagingBuffer::upload(VkBuffer destination, VkDeviceSize destinationOffset, const void* data, VkDeviceSize size)
+*	Purpose:		Copies data into the staging buffer and records the copy to destination, submitting
+*					whenever the staging buffer runs full, data may be reused as soon as this returns
+*
+*/
+VkResult StagingBuffer::upload(VkBuffer destination, VkDeviceSize destinationOffset, const void* data, VkDeviceSize size) {
+
+	// The previous submission may still read the staging buffer
+	VkResult result = wait();
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	const uint8_t* source = static_cast< const uint8_t* >(data);
+	while (size > 0) {
+
+		if (used == buffer.size()) {
+
+			result = flush();
+			if (result == VK_SUCCESS) {
+
+				result = wait();
+
+			}
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+
+		}
+
+		result = begin();
+		if (result != VK_SUCCESS) {
+
+			return result;
+
+		}
+
+		VkDeviceSize chunk = std::min(size, buffer.size() - used);
+		memcpy(static_cast< uint8_t* >(buffer.mapped()) + used, source, static_cast< size_t >(chunk));
+
+		VkBufferCopy region;
+		region.srcOffset	= used;
+		region.dstOffset	= destinationOffset;
+		region.size			= chunk;
+		vkCmdCopyBuffer(commandBuffer, buffer.handle(), destination, 1, &region);
+
+		if (queueFamily != consumerQueueFamily) {
+
+			VkBufferMemoryBarrier release;
+			release.sType					= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			release.pNext					= nullptr;
+			release.srcAccessMask			= VK_ACCESS_TRANSFER_WRITE_BIT;
+			release.dstAccessMask			= 0;
+			release.srcQueueFamilyIndex		= queueFamily;
+			release.dstQueueFamilyIndex		= consumerQueueFamily;
+			release.buffer					= destination;
+			release.offset					= destinationOffset;
+			release.size					= chunk;
+			releases.push_back(release);
+
+		}
+
+		// Keep the next chunk 16 byte aligned in the staging buffer
+		used				= std::min((used + chunk + 15) / 16 * 16, buffer.size());
+		source				+= chunk;
+		destinationOffset	+= chunk;
+		size				-= chunk;
+		uploaded			+= chunk;
+
+	}
+
+	return result;
+
+}
+
+/*
+*	Function:		VkResult StagingBuffer::flush()
+*	Purpose:		Submits the recorded copies without waiting for them, later submissions to the consumer
+*					queue see the destinations, after acquire() if the copies run on another queue
+*
+*/
+VkResult StagingBuffer::flush() {
+
+	if (!recording) {
+
+		return VK_SUCCESS;
+
+	}
+
+	VkResult result = buffer.flush(0, used);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkSemaphore semaphore = VK_NULL_HANDLE;
+	if (queue == consumerQueue) {
+
+		VkMemoryBarrier memoryBarrier;
+		memoryBarrier.sType				= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext				= nullptr;
+		memoryBarrier.srcAccessMask		= VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask		= STAGING_CONSUMER_ACCESS;
+
+		vkCmdPipelineBarrier(
+
+			commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			STAGING_CONSUMER_STAGES,
+			0,
+			1,
+			&memoryBarrier,
+			0,
+			nullptr,
+			0,
+			nullptr
+
+		);
+
+	}
+	else {
+
+		// The semaphore makes the writes visible, a family change also needs the ownership released
+		if (!releases.empty()) {
+
+			vkCmdPipelineBarrier(
+
+				commandBuffer,
+				VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+				0,
+				0,
+				nullptr,
+				static_cast< uint32_t >(releases.size()),
+				releases.data(),
+				0,
+				nullptr
+
+			);
+
+			for (VkBufferMemoryBarrier acquire : releases) {
+
+				acquire.srcAccessMask	= 0;
+				acquire.dstAccessMask	= STAGING_CONSUMER_ACCESS;
+				acquires.push_back(acquire);
+
+			}
+			releases.clear();
+
+		}
+
+		if (freeSemaphores.empty()) {
+
+			VkSemaphoreCreateInfo semaphoreCreateInfo;
+			semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphoreCreateInfo.pNext = nullptr;
+			semaphoreCreateInfo.flags = 0;
+
+			result = vkCreateSemaphore(device, &semaphoreCreateInfo, allocationCallbacks, &semaphore);
+			if (result != VK_SUCCESS) {
+
+				return result;
+
+			}
+
+		}
+		else {
+
+			semaphore = freeSemaphores.back();
+			freeSemaphores.pop_back();
+
+		}
+		signaled.push_back(semaphore);
+
+	}
+
+	result = vkEndCommandBuffer(commandBuffer);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	VkSubmitInfo submitInfo;
+	submitInfo.sType						= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext						= nullptr;
+	submitInfo.waitSemaphoreCount			= 0;
+	submitInfo.pWaitSemaphores				= nullptr;
+	submitInfo.pWaitDstStageMask			= nullptr;
+	submitInfo.commandBufferCount			= 1;
+	submitInfo.pCommandBuffers				= &commandBuffer;
+	submitInfo.signalSemaphoreCount			= semaphore != VK_NULL_HANDLE ? 1 : 0;
+	submitInfo.pSignalSemaphores			= &semaphore;
+
+	result = vkQueueSubmit(queue, 1, &submitInfo, fence);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	recording	= false;
+	submitted	= true;
+	used		= 0;
+
+	return VK_SUCCESS;
+
+}
+
+/*
+*	Function:		VkResult StagingBuffer::wait()
+*	Purpose:		Blocks until the last flush has been copied, the staging buffer can then be refilled
+*
+*/
+VkResult StagingBuffer::wait() {
+
+	if (!submitted) {
+
+		return VK_SUCCESS;
+
+	}
+
+	VkResult result = vkWaitForFences(device, 1, &fence, VK_TRUE, std::numeric_limits< uint64_t >::max());
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+	submitted = false;
+
+	result = vkResetFences(device, 1, &fence);
+	if (result != VK_SUCCESS) {
+
+		return result;
+
+	}
+
+	return vkResetCommandBuffer(commandBuffer, 0);
+
+}
+
+/*
+*	Function:		void StagingBuffer::acquire(VkCommandBuffer commandBuffer, std::vector< VkSemaphore > &waitSemaphores)
+*	Purpose:		Records the ownership acquires of all flushed copies into a command buffer of the consumer
+*					queue and appends the semaphores its submission has to wait on at STAGING_CONSUMER_STAGES,
+*					hand them to recycle() once that submission completed
+*
+*/
+void StagingBuffer::acquire(VkCommandBuffer commandBuffer, std::vector< VkSemaphore > &waitSemaphores) {
+
+	if (!acquires.empty()) {
+
+		vkCmdPipelineBarrier(
+
+			commandBuffer,
+			STAGING_CONSUMER_STAGES,
+			STAGING_CONSUMER_STAGES,
+			0,
+			0,
+			nullptr,
+			static_cast< uint32_t >(acquires.size()),
+			acquires.data(),
+			0,
+			nullptr
+
+		);
+		acquires.clear();
+
+	}
+
+	waitSemaphores.insert(waitSemaphores.end(), signaled.begin(), signaled.end());
+	signaled.clear();
+
+}
+
+/*
+*	Function:		void StagingBuffer::recycle(std::vector< VkSemaphore > &semaphores)
+*	Purpose:		Takes back semaphores handed out by acquire() whose wait has completed and clears the list
+*
+*/
+void StagingBuffer::recycle(std::vector< VkSemaphore > &semaphores) {
+
+	freeSemaphores.insert(freeSemaphores.end(), semaphores.begin(), semaphores.end());
+	semaphores.clear();
+
+}
+
+/*
+*	Function:		void StagingBuffer::destroy()
+*	Purpose:		Destroys the buffer, the command pool, the fence and the semaphores, copies that were
+*					not flushed are dropped, semaphores still handed out have to be recycled before
+*
+*/
+void StagingBuffer::destroy() {
+
+	wait();
+	for (VkSemaphore semaphore : signaled) {
+
+		vkDestroySemaphore(device, semaphore, allocationCallbacks);
+
+	}
+	for (VkSemaphore semaphore : freeSemaphores) {
+
+		vkDestroySemaphore(device, semaphore, allocationCallbacks);
+
+	}
+	signaled.clear();
+	freeSemaphores.clear();
+
+	vkDestroyFence(device, fence, allocationCallbacks);
+	vkDestroyCommandPool(device, commandPool, allocationCallbacks);
+	buffer.destroy();
+
+}
+
+VkDeviceSize StagingBuffer::uploadedBytes() const {
+
+	return uploaded;
+
+}
+
+/*
+*	Function:		VkResult StagingBuffer::begin()
+*	Purpose:		Begins the command buffer unless copies are already being recorded
+*
+*/
+VkResult StagingBuffer::begin() {
+
+	if (recording) {
+
+		return VK_SUCCESS;
+
+	}
+
+	VkCommandBufferBeginInfo commandBufferBeginInfo;
+	commandBufferBeginInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.pNext				= nullptr;
+	commandBufferBeginInfo.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	commandBufferBeginInfo.pInheritanceInfo		= nullptr;
+
+	VkResult result = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	recording = result == VK_SUCCESS;
+
+	return result;
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+StagingBuffer::~StagingBuffer() {
+
+
+
+}
+
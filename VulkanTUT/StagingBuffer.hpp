@@ -0,0 +1,59 @@
+/*
+*	File:			StagingBuffer.hpp
+*	Purpose:		Contains class StagingBuffer
+*
+*/
+#pragma once
+#include "GpuBuffer.hpp"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+#define STAGING_BUFFER_SIZE				(16 * 1024 * 1024)		// Bytes staged per submission, larger uploads are split
+#define STAGING_CONSUMER_STAGES			(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT)
+#define STAGING_CONSUMER_ACCESS			(VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT)
+
+/*
+*	Class:			StagingBuffer
+*	Purpose:		Host visible buffer reused for every upload to device local buffers, copies are
+*					batched until the buffer is full or flush() is called
+*					Copies run on their own queue, usually a transfer queue, without blocking the
+*					caller, the consumer queue picks them up through acquire() unless both are one queue
+*
+*/
+class StagingBuffer
+{
+public:
+	StagingBuffer();
+	VkResult create(VkDevice device, MemoryAllocator &allocator, VkQueue queue, uint32_t queueFamilyIndex, VkQueue consumerQueue, uint32_t consumerQueueFamilyIndex, VkDeviceSize size = STAGING_BUFFER_SIZE, const VkAllocationCallbacks* allocationCallbacks = nullptr);
+	VkResult upload(VkBuffer destination, VkDeviceSize destinationOffset, const void* data, VkDeviceSize size);
+	VkResult flush(void);
+	VkResult wait(void);
+	void acquire(VkCommandBuffer commandBuffer, std::vector< VkSemaphore > &waitSemaphores);
+	void recycle(std::vector< VkSemaphore > &semaphores);
+	void destroy(void);
+	VkDeviceSize uploadedBytes(void) const;
+	~StagingBuffer();
+private:
+	VkResult begin(void);
+
+	VkDevice								device;
+	const VkAllocationCallbacks*			allocationCallbacks;	// Semaphores are created at runtime, on the first cross-queue flush
+	VkQueue									queue;
+	VkQueue									consumerQueue;
+	uint32_t								queueFamily;
+	uint32_t								consumerQueueFamily;
+	GpuBuffer								buffer;
+	VkCommandPool							commandPool;
+	VkCommandBuffer							commandBuffer;
+	VkFence									fence;
+	VkDeviceSize							used;					// Bytes staged since the last flush
+	bool									recording;
+	bool									submitted;				// The last flush may still be copying
+	VkDeviceSize							uploaded;
+	std::vector< VkBufferMemoryBarrier >	releases;				// Ownership releases of the copies being recorded
+	std::vector< VkBufferMemoryBarrier >	acquires;				// Matching acquires for the consumer queue
+	std::vector< VkSemaphore >				signaled;				// Signaled by flushes, not yet waited on
+	std::vector< VkSemaphore >				freeSemaphores;
+};
+
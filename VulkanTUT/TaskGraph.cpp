@@ -0,0 +1,348 @@
+/*
+*	File:			TaskGraph.cpp
+*	Purpose:		Contains functions for class TaskGraph
+*
+*/
+#include "TaskGraph.hpp"
+#include <sstream>
+#include <stdexcept>
+
+/*
+*	Default constructor
+*
+*
+*/
+TaskGraph::TaskGraph() :
+	running(0),
+	finished(0),
+	startNs(0),
+	endNs(0),
+	threadPool(nullptr),
+	profiler(nullptr) {
+
+
+
+}
+
+/*
+*	Function:		Task TaskGraph::add(const char* name, std::function< void() > function, const std::vector< Task > &dependencies, bool mainThread)
+*	Purpose:		Adds a task that starts once all dependencies finished, dependencies have to be added
+*					before, which keeps the graph free of cycles, name has to be a string literal
+*
+*/
+TaskGraph::Task TaskGraph::add(const char* name, std::function< void() > function, const std::vector< Task > &dependencies, bool mainThread) {
+
+	Task task = static_cast< Task >(nodes.size());
+	for (Task dependency : dependencies) {
+
+		if (dependency >= task) {
+
+			throw std::runtime_error(std::string("Task ") + name + " depends on a task added after it");
+
+		}
+		nodes[dependency].dependents.push_back(task);
+
+	}
+
+	Node node;
+	node.name			= name;
+	node.function		= std::move(function);
+	node.dependencies	= dependencies;
+	node.mainThread		= mainThread;
+	node.pending		= 0;
+	node.startNs		= 0;
+	node.endNs			= 0;
+	nodes.push_back(std::move(node));
+
+	return task;
+
+}
+
+/*
+*	Function:		void TaskGraph::run(ThreadPool &threadPool, Profiler &profiler)
+*	Purpose:		Runs every task and returns once all finished, every task is added to the profiler
+*					After a task threw, no further tasks start and the exception is rethrown once the
+*					running ones finished
+*
+*/
+void TaskGraph::run(ThreadPool &threadPool_, Profiler &profiler_) {
+
+	std::unique_lock< std::mutex > lock(mutex);
+
+	threadPool	= &threadPool_;
+	profiler	= &profiler_;
+	running		= 0;
+	finished	= 0;
+	failure		= nullptr;
+	startNs		= Profiler::nowNanoseconds();
+	mainThreadTasks.clear();
+
+	for (Node &node : nodes) {
+
+		node.pending = static_cast< uint32_t >(node.dependencies.size());
+
+	}
+	for (Task task = 0; task < nodes.size(); task++) {
+
+		if (nodes[task].pending == 0) {
+
+			launch(task);
+
+		}
+
+	}
+
+	while (finished < nodes.size()) {
+
+		if (failure) {
+
+			running -= static_cast< uint32_t >(mainThreadTasks.size());
+			mainThreadTasks.clear();
+			if (running == 0) {
+
+				break;
+
+			}
+
+		}
+
+		if (!mainThreadTasks.empty()) {
+
+			Task task = mainThreadTasks.front();
+			mainThreadTasks.erase(mainThreadTasks.begin());
+
+			lock.unlock();
+			execute(task);
+			lock.lock();
+			continue;
+
+		}
+
+		condition.wait(lock);
+
+	}
+
+	endNs = Profiler::nowNanoseconds();
+
+	if (failure) {
+
+		std::rethrow_exception(failure);
+
+	}
+
+}
+
+/*
+*	Function:		std::vector< Task > TaskGraph::criticalPath() const
+*	Purpose:		Returns the chain of tasks that determined when the graph finished, starting with the first,
+*					every task is preceded by the dependency that finished last
+*
+*/
+std::vector< TaskGraph::Task > TaskGraph::criticalPath() const {
+
+	std::vector< Task > path;
+	if (nodes.empty()) {
+
+		return path;
+
+	}
+
+	Task last = 0;
+	for (Task task = 1; task < nodes.size(); task++) {
+
+		if (nodes[task].endNs > nodes[last].endNs) {
+
+			last = task;
+
+		}
+
+	}
+
+	path.push_back(last);
+	while (!nodes[path.back()].dependencies.empty()) {
+
+		const Node &node = nodes[path.back()];
+		Task latest = node.dependencies.front();
+		for (Task dependency : node.dependencies) {
+
+			if (nodes[dependency].endNs > nodes[latest].endNs) {
+
+				latest = dependency;
+
+			}
+
+		}
+		path.push_back(latest);
+
+	}
+
+	return std::vector< Task >(path.rbegin(), path.rend());
+
+}
+
+/*
+*	Function:		std::string TaskGraph::describe(const std::vector< Task > &path) const
+*	Purpose:		Formats tasks as "name (ms) -> name (ms)", the gap before a task is time spent
+*					waiting for a worker, shown when it exceeds a tenth of a millisecond
+*
+*/
+std::string TaskGraph::describe(const std::vector< Task > &path) const {
+
+	std::ostringstream text;
+	text.precision(3);
+	text << std::fixed;
+
+	uint64_t previousEndNs = startNs;
+	for (size_t i = 0; i < path.size(); i++) {
+
+		const Node &node = nodes[path[i]];
+		if (i > 0) {
+
+			text << " -> ";
+
+		}
+		text << node.name << " (" << taskMilliseconds(path[i]) << " ms";
+
+		double waitMs = node.startNs > previousEndNs ? (node.startNs - previousEndNs) / 1000000.0 : 0.0;
+		if (waitMs > 0.1) {
+
+			text << ", queued " << waitMs << " ms";
+
+		}
+		text << ")";
+		previousEndNs = node.endNs;
+
+	}
+
+	return text.str();
+
+}
+
+double TaskGraph::milliseconds() const {
+
+	return (endNs - startNs) / 1000000.0;
+
+}
+
+double TaskGraph::taskMilliseconds(Task task) const {
+
+	return (nodes[task].endNs - nodes[task].startNs) / 1000000.0;
+
+}
+
+/*
+*	Function:		double TaskGraph::serialMilliseconds() const
+*	Purpose:		Returns the summed duration of all tasks, what running them one after another would take
+*
+*/
+double TaskGraph::serialMilliseconds() const {
+
+	double total = 0.0;
+	for (Task task = 0; task < nodes.size(); task++) {
+
+		total += taskMilliseconds(task);
+
+	}
+
+	return total;
+
+}
+
+uint32_t TaskGraph::amountOfTasks() const {
+
+	return static_cast< uint32_t >(nodes.size());
+
+}
+
+/*
+*	Function:		void TaskGraph::launch(Task task)
+*	Purpose:		Hands a ready task to the pool or to the main thread, called with the mutex held
+*
+*/
+void TaskGraph::launch(Task task) {
+
+	running++;
+	if (nodes[task].mainThread) {
+
+		mainThreadTasks.push_back(task);
+		return;
+
+	}
+
+	threadPool->submit([this, task]() {
+
+		execute(task);
+
+	});
+
+}
+
+/*
+*	Function:		void TaskGraph::execute(Task task)
+*	Purpose:		Runs a task and launches the dependents it was the last dependency of
+*
+*/
+void TaskGraph::execute(Task task) {
+
+	Node &node = nodes[task];
+	node.startNs = Profiler::nowNanoseconds();
+
+	std::exception_ptr error;
+	try {
+
+		node.function();
+
+	}
+	catch (...) {
+
+		error = std::current_exception();
+
+	}
+
+	node.endNs = Profiler::nowNanoseconds();
+	profiler->addEvent(node.name, node.startNs, node.endNs);
+
+	{
+
+		std::lock_guard< std::mutex > lock(mutex);
+
+		if (error && !failure) {
+
+			failure = error;
+
+		}
+		running--;
+		finished++;
+
+		if (!failure) {
+
+			for (Task dependent : node.dependents) {
+
+				if (--nodes[dependent].pending == 0) {
+
+					launch(dependent);
+
+				}
+
+			}
+
+		}
+
+		// Notified under the lock, run() may return and the graph be destroyed as soon as the lock is released
+		condition.notify_all();
+
+	}
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+TaskGraph::~TaskGraph() {
+
+
+
+}
+
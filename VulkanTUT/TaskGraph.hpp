@@ -0,0 +1,75 @@
+/*
+*	File:			TaskGraph.hpp
+*	Purpose:		Contains class TaskGraph
+*
+*/
+#pragma once
+#include "ThreadPool.hpp"
+#include "Profiler.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstdint>
+
+#define TASK_MAIN_THREAD				true					// Pass to add() for tasks that have to run on the thread calling run()
+
+/*
+*	Class:			TaskGraph
+*	Purpose:		Runs tasks on the thread pool as soon as their dependencies finished, tasks bound to
+*					the main thread and tasks that wait for pool work themselves run on the caller,
+*					the measured durations give the critical path through the graph
+*
+*/
+class TaskGraph
+{
+public:
+	typedef uint32_t Task;
+
+	TaskGraph();
+	Task add(const char* name, std::function< void() > function, const std::vector< Task > &dependencies = {}, bool mainThread = false);
+	void run(ThreadPool &threadPool, Profiler &profiler);
+	std::vector< Task > criticalPath(void) const;
+	std::string describe(const std::vector< Task > &path) const;
+	double milliseconds(void) const;
+	double taskMilliseconds(Task task) const;
+	double serialMilliseconds(void) const;
+	uint32_t amountOfTasks(void) const;
+	~TaskGraph();
+private:
+	/*
+	*	Struct:			Node
+	*	Purpose:		One task, its edges and when it ran
+	*
+	*/
+	struct Node {
+
+		const char*						name;					// String literal, handed to the profiler as is
+		std::function< void() >			function;
+		std::vector< Task >				dependencies;
+		std::vector< Task >				dependents;
+		bool							mainThread;
+		uint32_t						pending;				// Dependencies not finished yet
+		uint64_t						startNs;
+		uint64_t						endNs;
+
+	};
+
+	void launch(Task task);
+	void execute(Task task);
+
+	std::vector< Node >				nodes;
+	std::vector< Task >				mainThreadTasks;		// Ready tasks waiting for the caller of run()
+	uint32_t						running;				// Launched but not finished
+	uint32_t						finished;
+	uint64_t						startNs;
+	uint64_t						endNs;
+	std::exception_ptr				failure;				// First exception thrown by a task, rethrown by run()
+	ThreadPool*						threadPool;
+	Profiler*						profiler;
+	std::mutex						mutex;
+	std::condition_variable			condition;
+};
+
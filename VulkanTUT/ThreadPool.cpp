@@ -0,0 +1,114 @@
+/*
+*	File:			ThreadPool.cpp
+*	Purpose:		Contains functions for class ThreadPool
+*
+*/
+#include "ThreadPool.hpp"
+
+/*
+*	Default constructor
+*	threadCount 0 uses every hardware thread except the one of the caller
+*
+*/
+ThreadPool::ThreadPool(unsigned int threadCount) :
+	active(0),
+	stopping(false) {
+
+	if (threadCount == 0) {
+
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+	}
+
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++) {
+
+		workers.push_back(std::thread(&ThreadPool::workerThread, this));
+
+	}
+
+}
+
+/*
+*	Function:		void ThreadPool::waitIdle()
+*	Purpose:		Blocks until the queue is empty and no task is executing
+*
+*/
+void ThreadPool::waitIdle() {
+
+	std::unique_lock< std::mutex > lock(mutex);
+	idleCondition.wait(lock, [this]() { return tasks.empty() && active == 0; });
+
+}
+
+/*
+*	Function:		unsigned int ThreadPool::size()
+*	Purpose:		Returns the amount of worker threads
+*
+*/
+unsigned int ThreadPool::size() const {
+
+	return static_cast< unsigned int >(workers.size());
+
+}
+
+/*
+*	Function:		void ThreadPool::workerThread()
+*	Purpose:		Executes queued tasks until the pool is destroyed
+*
+*/
+void ThreadPool::workerThread() {
+
+	std::unique_lock< std::mutex > lock(mutex);
+	while (true) {
+
+		taskCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+		if (tasks.empty()) {
+
+			return;
+
+		}
+
+		std::function< void() > task = std::move(tasks.front());
+		tasks.pop_front();
+		active++;
+
+		lock.unlock();
+		task();
+		lock.lock();
+
+		active--;
+		if (tasks.empty() && active == 0) {
+
+			idleCondition.notify_all();
+
+		}
+
+	}
+
+}
+
+/*
+*	Default destructor
+*	Queued tasks are still executed before the workers exit
+*
+*/
+ThreadPool::~ThreadPool() {
+
+	{
+
+		std::lock_guard< std::mutex > lock(mutex);
+		stopping = true;
+
+	}
+	taskCondition.notify_all();
+
+	for (std::thread &worker : workers) {
+
+		worker.join();
+
+	}
+
+}
+
@@ -0,0 +1,61 @@
+/*
+*	File:			ThreadPool.hpp
+*	Purpose:		Contains class ThreadPool
+*
+*/
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+class ThreadPool
+{
+public:
+	ThreadPool(unsigned int threadCount = 0);
+	void waitIdle(void);
+	unsigned int size(void) const;
+	~ThreadPool();
+
+	/*
+	*	Function:		std::future< R > ThreadPool::submit(F task)
+	*	Purpose:		Queues a task for the worker threads, the future carries its result or exception
+	*
+	*/
+	template< typename F >
+	std::future< typename std::result_of< F() >::type > submit(F task) {
+
+		typedef typename std::result_of< F() >::type Result;
+
+		// std::function needs a copyable target, the packaged task itself is move-only
+		auto packaged = std::make_shared< std::packaged_task< Result() > >(std::move(task));
+		std::future< Result > future = packaged->get_future();
+
+		{
+
+			std::lock_guard< std::mutex > lock(mutex);
+			tasks.push_back([packaged]() { (*packaged)(); });
+
+		}
+		taskCondition.notify_one();
+
+		return future;
+
+	}
+private:
+	void workerThread(void);
+
+	std::vector< std::thread >				workers;
+	std::deque< std::function< void() > >	tasks;
+	std::mutex								mutex;
+	std::condition_variable					taskCondition;
+	std::condition_variable					idleCondition;
+	unsigned int							active;				// Tasks currently executed by a worker
+	bool									stopping;
+};
+
@@ -0,0 +1,183 @@
+/*
+*	File:			UniformRing.cpp
+*	Purpose:		Contains functions for class UniformRing
+*
+*/
+#include "UniformRing.hpp"
+#include <algorithm>
+#include <limits>
+
+/*
+*	Default constructor
+*
+*
+*/
+UniformRing::UniformRing() :
+	regionBytes(0),
+	alignment(1),
+	frames(0),
+	regionStart(0),
+	head(0),
+	peak(0),
+	allocations(0),
+	overflows(0) {
+
+
+
+}
+
+/*
+*	Function:		VkResult UniformRing::create(MemoryAllocator &allocator, uint32_t amountOfFrames, VkDeviceSize regionSize, VkDeviceSize minUniformBufferOffsetAlignment)
+*	Purpose:		Creates the buffer with amountOfFrames regions of at least regionSize bytes in host visible memory,
+*					device local where the heap allows it, dynamic offsets limit the whole buffer to 4 GiB
+*
+*/
+VkResult UniformRing::create(MemoryAllocator &allocator, uint32_t amountOfFrames, VkDeviceSize regionSize, VkDeviceSize minUniformBufferOffsetAlignment) {
+
+	alignment	= std::max(minUniformBufferOffsetAlignment, static_cast< VkDeviceSize >(1));
+	regionBytes	= (regionSize + alignment - 1) & ~(alignment - 1);
+	frames		= amountOfFrames;
+	regionStart	= 0;
+	peak		= 0;
+	head.store(0);
+	allocations.store(0);
+	overflows.store(0);
+
+	if (regionBytes * frames > std::numeric_limits< uint32_t >::max()) {
+
+		return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+
+	}
+
+	return buffer.create(
+
+		allocator,
+		regionBytes * frames,
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+
+	);
+
+}
+
+/*
+*	Function:		void UniformRing::begin(uint32_t frame)
+*	Purpose:		Starts handing out the region of the frame, call once its fence signaled and before any allocate()
+*
+*/
+void UniformRing::begin(uint32_t frame) {
+
+	peak		= std::max(peak, std::min(head.load(std::memory_order_relaxed), regionBytes));
+	regionStart	= frame * regionBytes;
+	head.store(0, std::memory_order_relaxed);
+
+}
+
+/*
+*	Function:		bool UniformRing::allocate(VkDeviceSize size, UniformAllocation &allocation)
+*	Purpose:		Hands out an aligned block of the current region, lock-free and safe to call from any thread
+*					between begin() and flush(), returns false once the region is full
+*
+*/
+bool UniformRing::allocate(VkDeviceSize size, UniformAllocation &allocation) {
+
+	VkDeviceSize alignedSize	= (size + alignment - 1) & ~(alignment - 1);
+	VkDeviceSize offset			= head.fetch_add(alignedSize, std::memory_order_relaxed);
+	if (offset + alignedSize > regionBytes) {
+
+		overflows.fetch_add(1, std::memory_order_relaxed);
+		return false;
+
+	}
+
+	allocation.mapped			= static_cast< char* >(buffer.mapped()) + regionStart + offset;
+	allocation.dynamicOffset	= static_cast< uint32_t >(regionStart + offset);
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	return true;
+
+}
+
+/*
+*	Function:		VkResult UniformRing::flush()
+*	Purpose:		Makes the blocks of the current region visible to the device, call after the last allocate()
+*					of the frame and before its submit, nothing to do for coherent memory
+*
+*/
+VkResult UniformRing::flush() {
+
+	VkDeviceSize used = std::min(head.load(std::memory_order_relaxed), regionBytes);
+	if (used == 0) {
+
+		return VK_SUCCESS;
+
+	}
+
+	return buffer.flush(regionStart, used);
+
+}
+
+/*
+*	Function:		VkDescriptorBufferInfo UniformRing::descriptor(VkDeviceSize range) const
+*	Purpose:		Describes a VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC binding of blocks of range bytes,
+*					written once, the dynamic offsets of allocate() select the block
+*
+*/
+VkDescriptorBufferInfo UniformRing::descriptor(VkDeviceSize range) const {
+
+	VkDescriptorBufferInfo bufferInfo;
+	bufferInfo.buffer	= buffer.handle();
+	bufferInfo.offset	= 0;
+	bufferInfo.range	= range;
+
+	return bufferInfo;
+
+}
+
+VkDeviceSize UniformRing::regionSize() const {
+
+	return regionBytes;
+
+}
+
+VkDeviceSize UniformRing::peakBytes() const {
+
+	return peak;
+
+}
+
+uint64_t UniformRing::amountOfAllocations() const {
+
+	return allocations.load(std::memory_order_relaxed);
+
+}
+
+uint64_t UniformRing::amountOfOverflows() const {
+
+	return overflows.load(std::memory_order_relaxed);
+
+}
+
+/*
+*	Function:		void UniformRing::destroy()
+*	Purpose:		Destroys the buffer, no frame may be in flight
+*
+*/
+void UniformRing::destroy() {
+
+	buffer.destroy();
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+UniformRing::~UniformRing() {
+
+
+
+}
+
@@ -0,0 +1,60 @@
+/*
+*	File:			UniformRing.hpp
+*	Purpose:		Contains struct UniformAllocation and class UniformRing
+*
+*/
+#pragma once
+#include "GpuBuffer.hpp"
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+
+/*
+*	Struct:			UniformAllocation
+*	Purpose:		Uniform block handed out by UniformRing, valid until its frame comes around again
+*
+*/
+struct UniformAllocation {
+
+	void*						mapped;					// Write the block here, the ring flushes it before the submit
+	uint32_t					dynamicOffset;			// Passed to vkCmdBindDescriptorSets for a descriptor of UniformRing::descriptor()
+
+};
+
+/*
+*	Class:			UniformRing
+*	Purpose:		One persistently mapped uniform buffer split into a region per frame in flight, blocks are
+*					bump allocated with one atomic add and addressed through dynamic offsets, so streaming
+*					constants takes neither vkMapMemory nor descriptor writes
+*
+*/
+class UniformRing
+{
+public:
+	UniformRing();
+	VkResult create(MemoryAllocator &allocator, uint32_t amountOfFrames, VkDeviceSize regionSize, VkDeviceSize minUniformBufferOffsetAlignment);
+	void begin(uint32_t frame);
+	bool allocate(VkDeviceSize size, UniformAllocation &allocation);
+	VkResult flush(void);
+	VkDescriptorBufferInfo descriptor(VkDeviceSize range) const;
+	VkDeviceSize regionSize(void) const;
+	VkDeviceSize peakBytes(void) const;
+	uint64_t amountOfAllocations(void) const;
+	uint64_t amountOfOverflows(void) const;
+	void destroy(void);
+	~UniformRing();
+private:
+	UniformRing(const UniformRing &) = delete;
+	UniformRing &operator=(const UniformRing &) = delete;
+
+	GpuBuffer								buffer;
+	VkDeviceSize							regionBytes;		// Multiple of alignment
+	VkDeviceSize							alignment;			// minUniformBufferOffsetAlignment, a power of two
+	uint32_t								frames;
+	VkDeviceSize							regionStart;		// Of the frame passed to begin()
+	std::atomic< VkDeviceSize >				head;				// Bytes handed out in the current region, may overshoot it
+	VkDeviceSize							peak;				// Largest region use at a begin()
+	std::atomic< uint64_t >					allocations;
+	std::atomic< uint64_t >					overflows;			// Allocations refused because the region was full
+};
+
@@ -0,0 +1,117 @@
+/*
+*	File:			VertexFormat.cpp
+*	Purpose:		Contains functions for class VertexFormat
+*
+*/
+#include "VertexFormat.hpp"
+#include <stdexcept>
+#include <string>
+
+/*
+*	Default constructor
+*
+*
+*/
+VertexFormat::VertexFormat(uint32_t binding_, VkVertexInputRate inputRate_) :
+	binding(binding_),
+	inputRate(inputRate_),
+	size(0) {
+
+
+
+}
+
+/*
+*	Function:		VertexFormat &VertexFormat::add(uint32_t location, VkFormat format)
+*	Purpose:		Appends an attribute behind the previous ones, returns the format for chaining
+*
+*/
+VertexFormat &VertexFormat::add(uint32_t location, VkFormat format) {
+
+	VkVertexInputAttributeDescription attribute;
+	attribute.location		= location;
+	attribute.binding		= binding;
+	attribute.format		= format;
+	attribute.offset		= size;
+
+	attributes.push_back(attribute);
+	size += formatSize(format);
+
+	return *this;
+
+}
+
+uint32_t VertexFormat::stride() const {
+
+	return size;
+
+}
+
+/*
+*	Function:		VkVertexInputBindingDescription VertexFormat::bindingDescription()
+*	Purpose:		Returns the binding of the vertex buffer for the pipeline vertex input state
+*
+*/
+VkVertexInputBindingDescription VertexFormat::bindingDescription() const {
+
+	VkVertexInputBindingDescription description;
+	description.binding		= binding;
+	description.stride		= size;
+	description.inputRate	= inputRate;
+
+	return description;
+
+}
+
+const std::vector< VkVertexInputAttributeDescription > &VertexFormat::attributeDescriptions() const {
+
+	return attributes;
+
+}
+
+/*
+*	Function:		uint32_t VertexFormat::formatSize(VkFormat format)
+*	Purpose:		Returns the size of the 32 bit and packed 8 bit vertex formats, throws for any other
+*
+*/
+uint32_t VertexFormat::formatSize(VkFormat format) {
+
+	switch (format) {
+
+	case VK_FORMAT_R32_SFLOAT:
+	case VK_FORMAT_R32_UINT:
+	case VK_FORMAT_R32_SINT:
+	case VK_FORMAT_R8G8B8A8_UNORM:
+	case VK_FORMAT_R8G8B8A8_SNORM:
+	case VK_FORMAT_R8G8B8A8_UINT:
+		return 4;
+	case VK_FORMAT_R32G32_SFLOAT:
+	case VK_FORMAT_R32G32_UINT:
+	case VK_FORMAT_R32G32_SINT:
+		return 8;
+	case VK_FORMAT_R32G32B32_SFLOAT:
+	case VK_FORMAT_R32G32B32_UINT:
+	case VK_FORMAT_R32G32B32_SINT:
+		return 12;
+	case VK_FORMAT_R32G32B32A32_SFLOAT:
+	case VK_FORMAT_R32G32B32A32_UINT:
+	case VK_FORMAT_R32G32B32A32_SINT:
+		return 16;
+	default:
+		throw std::runtime_error("Unsupported vertex attribute format " + std::to_string(format));
+
+	}
+
+}
+
+/*
+*	Default destructor
+*
+*
+*/
+VertexFormat::~VertexFormat() {
+
+
+
+}
+
@@ -0,0 +1,33 @@
+/*
+*	File:			VertexFormat.hpp
+*	Purpose:		Contains class VertexFormat
+*
+*/
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+/*
+*	Class:			VertexFormat
+*	Purpose:		Layout of one interleaved vertex buffer binding, attributes are packed in the order
+*					they are added, the pipeline vertex input state is generated from it
+*
+*/
+class VertexFormat
+{
+public:
+	VertexFormat(uint32_t binding = 0, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
+	VertexFormat &add(uint32_t location, VkFormat format);
+	uint32_t stride(void) const;
+	VkVertexInputBindingDescription bindingDescription(void) const;
+	const std::vector< VkVertexInputAttributeDescription > &attributeDescriptions(void) const;
+	static uint32_t formatSize(VkFormat format);
+	~VertexFormat();
+private:
+	uint32_t											binding;
+	VkVertexInputRate									inputRate;
+	uint32_t											size;				// Bytes per vertex so far
+	std::vector< VkVertexInputAttributeDescription >	attributes;
+};
+
@@ -0,0 +1,70 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+
+// Every storage buffer of the bindless set, InstanceData is 7 tightly packed floats
+layout(std430, set = 1, binding = 0) readonly buffer Buffers {
+
+	float data[];
+
+} buffers[];
+
+layout(push_constant) uniform DrawConstants {
+
+	uint instanceBuffer;
+	uint instanceOffset;		// In floats
+
+} draw;
+
+layout(set = 0, binding = 0) uniform FrameConstants {
+
+	vec2 cameraOffset;
+	float cameraZoom;
+	float time;
+
+} frame;
+
+layout(set = 0, binding = 1) uniform ObjectConstants {
+
+	vec4 tint;
+
+} object;
+
+layout(location = 0) out vec3 fragColor;
+
+out gl_PerVertex {
+
+	vec4 gl_Position;
+
+};
+
+void main() {
+
+	uint base = draw.instanceOffset + gl_InstanceIndex * 7;
+	vec4 transform = vec4(
+
+		buffers[draw.instanceBuffer].data[base + 0],
+		buffers[draw.instanceBuffer].data[base + 1],
+		buffers[draw.instanceBuffer].data[base + 2],
+		buffers[draw.instanceBuffer].data[base + 3]
+
+	);
+	vec3 instanceColor = vec3(
+
+		buffers[draw.instanceBuffer].data[base + 4],
+		buffers[draw.instanceBuffer].data[base + 5],
+		buffers[draw.instanceBuffer].data[base + 6]
+
+	);
+
+	float s = sin(transform.w);
+	float c = cos(transform.w);
+	vec2 position = mat2(c, s, -s, c) * inPosition * transform.z + transform.xy;
+
+	gl_Position = vec4((position - frame.cameraOffset) * frame.cameraZoom, 0.0, 1.0);
+	fragColor = inColor * instanceColor * object.tint.rgb;
+
+}
\ No newline at end of file
@@ -1,3 +1,7 @@
-C:\VulkanSDK\1.1.85.0\Bin32\glslangValidator.exe -V shader.vert
-C:\VulkanSDK\1.1.85.0\Bin32\glslangValidator.exe -V shader.frag
+@rem Loose SPIR-V for running without the project build, which embeds optimized SPIR-V through Shaders.targets
+@if "%VULKAN_SDK%" == "" (echo VULKAN_SDK is not set, install the Vulkan SDK or set it to the install directory & exit /b 1)
+"%VULKAN_SDK%\Bin\glslangValidator.exe" -V shader.vert
+"%VULKAN_SDK%\Bin\glslangValidator.exe" -V shader.frag
+"%VULKAN_SDK%\Bin\glslangValidator.exe" -V cull.comp
+"%VULKAN_SDK%\Bin\glslangValidator.exe" -V bindless.vert -o bindless.spv
 exit
\ No newline at end of file
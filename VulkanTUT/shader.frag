@@ -1,10 +1,28 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+layout(location = 0) in vec3 fragColor;
+
 layout(location = 0) out vec4 outColor;
 
+// Variant knobs, set per pipeline through VkSpecializationInfo and folded by the driver
+layout(constant_id = 0) const bool GRAYSCALE = false;
+layout(constant_id = 1) const uint POSTERIZE_LEVELS = 0;
+
 void main() {
 
-	outColor = vec4(0.0, 1.0, 0.0, 1.0);
+	vec3 color = fragColor;
+	if (GRAYSCALE) {
+
+		color = vec3(dot(color, vec3(0.299, 0.587, 0.114)));
+
+	}
+	if (POSTERIZE_LEVELS > 0) {
+
+		color = floor(color * float(POSTERIZE_LEVELS) + 0.5) / float(POSTERIZE_LEVELS);
+
+	}
+
+	outColor = vec4(color, 1.0);
 
 }
\ No newline at end of file
@@ -1,22 +1,40 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
-out gl_PerVertex {
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec4 inTransform;		// Per instance: offset xy, scale, rotation
+layout(location = 3) in vec3 inInstanceColor;
 
-	vec4 gl_Position;
+layout(set = 0, binding = 0) uniform FrameConstants {
 
-};
+	vec2 cameraOffset;
+	float cameraZoom;
+	float time;
+
+} frame;
+
+layout(set = 0, binding = 1) uniform ObjectConstants {
+
+	vec4 tint;
 
-vec2 positions[3] = vec2[](
+} object;
 
-	vec2(0.0, -0.5),
-	vec2(0.5, 0.5),
-	vec2(-0.5, 0.5)
+layout(location = 0) out vec3 fragColor;
 
-);
+out gl_PerVertex {
+
+	vec4 gl_Position;
+
+};
 
 void main() {
 
-	gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+	float s = sin(inTransform.w);
+	float c = cos(inTransform.w);
+	vec2 position = mat2(c, s, -s, c) * inPosition * inTransform.z + inTransform.xy;
+
+	gl_Position = vec4((position - frame.cameraOffset) * frame.cameraZoom, 0.0, 1.0);
+	fragColor = inColor * inInstanceColor * object.tint.rgb;
 
 }
\ No newline at end of file